@@ -0,0 +1,624 @@
+#include <Windows.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../Boring32/include/Boring32.hpp"
+
+// Measures round trips over each IPC transport: a client sends a message,
+// an echo peer sends it back, and the client times the whole exchange.
+// Usage: Boring32.Benchmarks.exe [iterations per client]
+
+namespace
+{
+	struct BenchmarkConfig
+	{
+		size_t MessageSize = 0;
+		DWORD ClientCount = 0;
+		size_t Iterations = 0;
+	};
+
+	struct BenchmarkResult
+	{
+		// Round trip latencies in microseconds, across all clients.
+		std::vector<double> Latencies;
+		double ElapsedSeconds = 0;
+	};
+
+	// Sends request and fills reply with the echoed message.
+	using RoundTrip = std::function<void(std::span<const std::byte> request, std::span<std::byte> reply)>;
+
+	const size_t MessageSizes[] = { 64, 1024, 16384 };
+	const DWORD ClientCounts[] = { 1, 4, 16 };
+
+	double Now()
+	{
+		static const double frequency = []
+		{
+			LARGE_INTEGER value;
+			QueryPerformanceFrequency(&value);
+			return static_cast<double>(value.QuadPart);
+		}();
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart / frequency;
+	}
+
+	std::wstring NextPipeName()
+	{
+		static unsigned runs = 0;
+		return L"Boring32Benchmark-" + std::to_wstring(GetCurrentProcessId()) + L"-" + std::to_wstring(runs++);
+	}
+
+	double Percentile(const std::vector<double>& sorted, const double percentile)
+	{
+		if (sorted.empty())
+			return 0;
+		const size_t index = static_cast<size_t>(percentile * (sorted.size() - 1));
+		return sorted[index];
+	}
+
+	void Report(const std::wstring& transport, const BenchmarkConfig& config, BenchmarkResult& result)
+	{
+		std::sort(result.Latencies.begin(), result.Latencies.end());
+		const double messagesPerSecond = result.ElapsedSeconds > 0
+			? result.Latencies.size() / result.ElapsedSeconds
+			: 0;
+		std::wcout
+			<< std::left << std::setw(24) << transport
+			<< std::right << std::setw(8) << config.MessageSize
+			<< std::setw(8) << config.ClientCount
+			<< std::fixed << std::setprecision(0) << std::setw(14) << messagesPerSecond
+			<< std::setprecision(1)
+			<< std::setw(12) << Percentile(result.Latencies, 0.5)
+			<< std::setw(12) << Percentile(result.Latencies, 0.99)
+			<< std::setw(12) << Percentile(result.Latencies, 0.999)
+			<< std::endl;
+	}
+
+	void ReportFailure(const std::wstring& transport, const BenchmarkConfig& config, const std::exception& ex)
+	{
+		std::wcout
+			<< std::left << std::setw(24) << transport
+			<< std::right << std::setw(8) << config.MessageSize
+			<< std::setw(8) << config.ClientCount
+			<< L"  failed: " << ex.what()
+			<< std::endl;
+	}
+
+	// The threads of one benchmark run, clients and echo peers alike. A
+	// thread that throws stops the run: its exception is kept for Join() to
+	// rethrow, and the threads still running are cancelled, since they may
+	// be blocked on the one that failed. Going out of scope cancels and
+	// joins whatever is left, so unwinding never destroys a joinable thread.
+	// Must be declared after everything its threads use.
+	class Workers
+	{
+		public:
+			~Workers()
+			{
+				Stop();
+			}
+
+			// cancel is called repeatedly until every thread has exited, and
+			// must release threads blocked on something other than
+			// synchronous I/O, which is cancelled here.
+			Workers(std::function<void()> cancel)
+			:	m_cancel(std::move(cancel)),
+				m_running(0)
+			{ }
+
+			Workers(const Workers&) = delete;
+			Workers& operator=(const Workers&) = delete;
+
+		public:
+			void Start(std::function<void()> body)
+			{
+				{
+					std::lock_guard lock(m_mutex);
+					m_running++;
+				}
+				try
+				{
+					m_threads.emplace_back(
+						[this, body = std::move(body)]
+						{
+							try
+							{
+								body();
+							}
+							catch (...)
+							{
+								std::lock_guard lock(m_mutex);
+								if (m_error == nullptr)
+									m_error = std::current_exception();
+							}
+							std::lock_guard lock(m_mutex);
+							m_running--;
+							m_changed.notify_all();
+						}
+					);
+				}
+				catch (...)
+				{
+					std::lock_guard lock(m_mutex);
+					m_running--;
+					throw;
+				}
+			}
+
+			// Waits for every thread to finish, or for one to fail, in which
+			// case the rest are cancelled and the failure is rethrown.
+			void Join()
+			{
+				{
+					std::unique_lock lock(m_mutex);
+					m_changed.wait(lock, [this] { return m_running == 0 || m_error != nullptr; });
+				}
+				Stop();
+				std::exception_ptr error;
+				{
+					std::lock_guard lock(m_mutex);
+					error = std::exchange(m_error, nullptr);
+				}
+				if (error)
+					std::rethrow_exception(error);
+			}
+
+			void Stop() noexcept
+			{
+				std::unique_lock lock(m_mutex);
+				while (m_running > 0)
+				{
+					lock.unlock();
+					Cancel();
+					lock.lock();
+					m_changed.wait_for(lock, std::chrono::milliseconds(10), [this] { return m_running == 0; });
+				}
+				lock.unlock();
+				for (std::thread& thread : m_threads)
+					thread.join();
+				m_threads.clear();
+			}
+
+		private:
+			void Cancel() noexcept
+			{
+				try
+				{
+					if (m_cancel)
+						m_cancel();
+				}
+				catch (...) { }
+				for (std::thread& thread : m_threads)
+					CancelSynchronousIo(thread.native_handle());
+			}
+
+		private:
+			std::function<void()> m_cancel;
+			std::vector<std::thread> m_threads;
+			std::mutex m_mutex;
+			std::condition_variable m_changed;
+			size_t m_running;
+			std::exception_ptr m_error;
+	};
+
+	// Runs one thread per client in workers, each timing config.Iterations
+	// round trips through its own RoundTrip, then joins every worker.
+	// Clients start together once all are ready.
+	BenchmarkResult RunClients(const BenchmarkConfig& config, std::vector<RoundTrip>& clients, Workers& workers)
+	{
+		std::vector<std::vector<double>> latencies(clients.size());
+		std::vector<double> finished(clients.size());
+		Boring32::Async::Event start(false, true, false, L"");
+		try
+		{
+			for (size_t i = 0; i < clients.size(); i++)
+			{
+				workers.Start(
+					[&config, &clients, &latencies, &finished, &start, i]
+					{
+						std::vector<std::byte> request(config.MessageSize, static_cast<std::byte>(i));
+						std::vector<std::byte> reply(config.MessageSize);
+						latencies[i].reserve(config.Iterations);
+						start.WaitOnEvent();
+						for (size_t n = 0; n < config.Iterations; n++)
+						{
+							const double sent = Now();
+							clients[i](request, reply);
+							latencies[i].push_back((Now() - sent) * 1000000);
+						}
+						finished[i] = Now();
+					}
+				);
+			}
+		}
+		catch (...)
+		{
+			// The started clients use our locals, so must be gone before we are.
+			start.Signal();
+			workers.Stop();
+			throw;
+		}
+
+		BenchmarkResult result;
+		const double started = Now();
+		start.Signal();
+		workers.Join();
+		result.ElapsedSeconds = *std::max_element(finished.begin(), finished.end()) - started;
+		for (const std::vector<double>& clientLatencies : latencies)
+			result.Latencies.insert(result.Latencies.end(), clientLatencies.begin(), clientLatencies.end());
+		return result;
+	}
+
+	// Anonymous pipes are a byte stream, so a message may arrive in pieces.
+	void ReadExactly(Boring32::Async::AnonymousPipe& pipe, std::span<std::byte> buffer)
+	{
+		size_t total = 0;
+		while (total < buffer.size())
+			total += pipe.Read(buffer.subspan(total));
+	}
+
+	BenchmarkResult BenchmarkAnonymousPipe(const BenchmarkConfig& config)
+	{
+		const DWORD pipeSize = static_cast<DWORD>(config.MessageSize);
+		std::vector<Boring32::Async::AnonymousPipe> requests;
+		std::vector<Boring32::Async::AnonymousPipe> replies;
+		requests.reserve(config.ClientCount);
+		replies.reserve(config.ClientCount);
+		std::vector<RoundTrip> clients;
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			requests.emplace_back(false, pipeSize, L"");
+			replies.emplace_back(false, pipeSize, L"");
+		}
+		// Everything blocks in synchronous I/O, which Workers cancels itself.
+		Workers workers(nullptr);
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			Boring32::Async::AnonymousPipe& request = requests[i];
+			Boring32::Async::AnonymousPipe& reply = replies[i];
+			workers.Start(
+				[&config, &request, &reply]
+				{
+					std::vector<std::byte> buffer(config.MessageSize);
+					for (size_t n = 0; n < config.Iterations; n++)
+					{
+						ReadExactly(request, buffer);
+						reply.Write(buffer);
+					}
+				}
+			);
+			clients.push_back(
+				[&request, &reply](std::span<const std::byte> message, std::span<std::byte> response)
+				{
+					request.Write(message);
+					ReadExactly(reply, response);
+				}
+			);
+		}
+
+		return RunClients(config, clients, workers);
+	}
+
+	BenchmarkResult BenchmarkBlockingNamedPipe(const BenchmarkConfig& config)
+	{
+		const std::wstring name = NextPipeName();
+		const DWORD pipeSize = static_cast<DWORD>(config.MessageSize);
+		// Moving a server creates another pipe instance, so never reallocate.
+		std::vector<Boring32::Async::BlockingNamedPipeServer> servers;
+		servers.reserve(config.ClientCount);
+		for (DWORD i = 0; i < config.ClientCount; i++)
+			servers.emplace_back(name, pipeSize, config.ClientCount, L"", false, true);
+		std::vector<Boring32::Async::BlockingNamedPipeClient> connections;
+		connections.reserve(config.ClientCount);
+		std::vector<RoundTrip> clients;
+
+		// Everything blocks in synchronous I/O, which Workers cancels itself.
+		Workers workers(nullptr);
+		for (Boring32::Async::BlockingNamedPipeServer& server : servers)
+		{
+			workers.Start(
+				[&config, &server]
+				{
+					server.Connect();
+					std::vector<std::byte> buffer(config.MessageSize);
+					for (size_t n = 0; n < config.Iterations; n++)
+					{
+						DWORD bytesRead = 0;
+						server.Read(buffer, bytesRead);
+						server.Write(std::span(buffer).first(bytesRead));
+					}
+				}
+			);
+		}
+
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			Boring32::Async::BlockingNamedPipeClient& client = connections.emplace_back(name);
+			client.Connect(0);
+			client.SetMode(PIPE_READMODE_MESSAGE);
+			clients.push_back(
+				[&client](std::span<const std::byte> message, std::span<std::byte> response)
+				{
+					DWORD bytesRead = 0;
+					client.Write(message);
+					client.Read(response, bytesRead);
+				}
+			);
+		}
+
+		return RunClients(config, clients, workers);
+	}
+
+	// Waits for an overlapped operation, throwing if it failed or was
+	// cancelled.
+	void Complete(Boring32::Async::OverlappedOp& op)
+	{
+		op.WaitForCompletion(INFINITE);
+		if (op.IsSuccessful() == false)
+			throw std::runtime_error(__FUNCSIG__ ": the operation failed or was cancelled");
+	}
+
+	BenchmarkResult BenchmarkOverlappedNamedPipe(const BenchmarkConfig& config)
+	{
+		const std::wstring name = NextPipeName();
+		const DWORD pipeSize = static_cast<DWORD>(config.MessageSize);
+		std::vector<Boring32::Async::OverlappedNamedPipeServer> servers;
+		servers.reserve(config.ClientCount);
+		std::vector<Boring32::Async::OverlappedOp> connects(config.ClientCount);
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			servers.emplace_back(name, pipeSize, config.ClientCount, L"", false, true);
+			// Listen before any client connects.
+			servers.back().Connect(connects[i]);
+		}
+		std::vector<Boring32::Async::OverlappedNamedPipeClient> connections;
+		connections.reserve(config.ClientCount);
+		// One per client, reused for every round trip, so the timed loop
+		// doesn't create and destroy an event per message.
+		std::vector<Boring32::Async::OverlappedOp> ops(config.ClientCount);
+		std::vector<RoundTrip> clients;
+
+		// Threads wait on events rather than in synchronous I/O, so cancel
+		// their outstanding operations instead.
+		Workers workers(
+			[&servers, &connections]
+			{
+				for (Boring32::Async::OverlappedNamedPipeServer& server : servers)
+					CancelIoEx(server.GetInternalHandle().GetHandle(), nullptr);
+				for (Boring32::Async::OverlappedNamedPipeClient& client : connections)
+				{
+					try
+					{
+						client.CancelCurrentProcessIo(nullptr);
+					}
+					// Nothing was outstanding.
+					catch (const std::exception&) { }
+				}
+			}
+		);
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			Boring32::Async::OverlappedNamedPipeServer& server = servers[i];
+			Boring32::Async::OverlappedOp& connect = connects[i];
+			workers.Start(
+				[&config, &server, &connect]
+				{
+					connect.WaitForCompletion(INFINITE);
+					std::vector<std::byte> buffer(config.MessageSize);
+					Boring32::Async::OverlappedOp op;
+					for (size_t n = 0; n < config.Iterations; n++)
+					{
+						server.Read(buffer, op);
+						Complete(op);
+						const size_t bytesRead = static_cast<size_t>(op.GetBytesTransferred());
+						server.Write(std::span(buffer).first(bytesRead), op);
+						Complete(op);
+					}
+				}
+			);
+		}
+
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			Boring32::Async::OverlappedNamedPipeClient& client = connections.emplace_back(name);
+			client.Connect(0);
+			client.SetMode(PIPE_READMODE_MESSAGE);
+			Boring32::Async::OverlappedOp& op = ops[i];
+			clients.push_back(
+				[&client, &op](std::span<const std::byte> message, std::span<std::byte> response)
+				{
+					client.Write(message, op);
+					Complete(op);
+					client.Read(response, op);
+					Complete(op);
+				}
+			);
+		}
+
+		return RunClients(config, clients, workers);
+	}
+
+	BenchmarkResult BenchmarkCompletionPortPipeServer(const BenchmarkConfig& config)
+	{
+		using Boring32::Async::CompletionPortPipeServer;
+		const std::wstring name = NextPipeName();
+		const DWORD workerCount = config.ClientCount < 4 ? config.ClientCount : 4;
+		CompletionPortPipeServer* echo = nullptr;
+		CompletionPortPipeServer server(
+			name,
+			config.ClientCount,
+			static_cast<DWORD>(config.MessageSize),
+			workerCount,
+			L"",
+			true,
+			{
+				.OnMessage = [&echo](CompletionPortPipeServer::ConnectionId id, std::span<const std::byte> message)
+				{
+					echo->Send(id, message);
+				}
+			}
+		);
+		echo = &server;
+
+		std::vector<Boring32::Async::BlockingNamedPipeClient> connections;
+		connections.reserve(config.ClientCount);
+		std::vector<RoundTrip> clients;
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			Boring32::Async::BlockingNamedPipeClient& client = connections.emplace_back(server.GetName());
+			client.Connect(0);
+			client.SetMode(PIPE_READMODE_MESSAGE);
+			clients.push_back(
+				[&client](std::span<const std::byte> message, std::span<std::byte> response)
+				{
+					DWORD bytesRead = 0;
+					client.Write(message);
+					client.Read(response, bytesRead);
+				}
+			);
+		}
+
+		// The clients block in synchronous I/O, which Workers cancels itself.
+		Workers workers(nullptr);
+		BenchmarkResult result = RunClients(config, clients, workers);
+		connections.clear();
+		server.Close();
+		return result;
+	}
+
+	// Each client gets a request and a reply slot in one shared mapping,
+	// signalled with a pair of auto-reset events.
+	BenchmarkResult BenchmarkMemoryMappedFile(const BenchmarkConfig& config)
+	{
+		const size_t slotSize = config.MessageSize * 2;
+		Boring32::Async::MemoryMappedFile mapping(
+			NextPipeName(),
+			static_cast<UINT64>(slotSize * config.ClientCount),
+			false
+		);
+		std::byte* const view = static_cast<std::byte*>(mapping.GetViewPointer());
+		std::vector<Boring32::Async::Event> requestReady;
+		std::vector<Boring32::Async::Event> replyReady;
+		requestReady.reserve(config.ClientCount);
+		replyReady.reserve(config.ClientCount);
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			requestReady.emplace_back(false, false, false, L"");
+			replyReady.emplace_back(false, false, false, L"");
+		}
+		std::vector<RoundTrip> clients;
+
+		// Threads wait on events, so wake them all and have them give up.
+		std::atomic<bool> cancelled = false;
+		Workers workers(
+			[&cancelled, &requestReady, &replyReady]
+			{
+				cancelled = true;
+				for (Boring32::Async::Event& event : requestReady)
+					event.Signal();
+				for (Boring32::Async::Event& event : replyReady)
+					event.Signal();
+			}
+		);
+		for (DWORD i = 0; i < config.ClientCount; i++)
+		{
+			std::byte* const requestSlot = view + slotSize * i;
+			std::byte* const replySlot = requestSlot + config.MessageSize;
+			Boring32::Async::Event& request = requestReady[i];
+			Boring32::Async::Event& reply = replyReady[i];
+			workers.Start(
+				[&config, &cancelled, requestSlot, replySlot, &request, &reply]
+				{
+					for (size_t n = 0; n < config.Iterations; n++)
+					{
+						request.WaitOnEvent();
+						if (cancelled)
+							return;
+						std::memcpy(replySlot, requestSlot, config.MessageSize);
+						reply.Signal();
+					}
+				}
+			);
+			clients.push_back(
+				[&cancelled, requestSlot, replySlot, &request, &reply](std::span<const std::byte> message, std::span<std::byte> response)
+				{
+					std::memcpy(requestSlot, message.data(), message.size());
+					request.Signal();
+					reply.WaitOnEvent();
+					if (cancelled)
+						throw std::runtime_error(__FUNCSIG__ ": cancelled");
+					std::memcpy(response.data(), replySlot, response.size());
+				}
+			);
+		}
+
+		return RunClients(config, clients, workers);
+	}
+
+	void Run(
+		const std::wstring& transport,
+		const BenchmarkConfig& config,
+		const std::function<BenchmarkResult(const BenchmarkConfig&)>& benchmark
+	)
+	{
+		try
+		{
+			BenchmarkResult result = benchmark(config);
+			Report(transport, config, result);
+		}
+		catch (const std::exception& ex)
+		{
+			ReportFailure(transport, config, ex);
+		}
+	}
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+	size_t iterations = 10000;
+	if (argc > 1)
+		iterations = std::stoul(argv[1]);
+
+	std::wcout
+		<< std::left << std::setw(24) << L"Transport"
+		<< std::right << std::setw(8) << L"Bytes"
+		<< std::setw(8) << L"Clients"
+		<< std::setw(14) << L"Msgs/sec"
+		<< std::setw(12) << L"p50 (us)"
+		<< std::setw(12) << L"p99 (us)"
+		<< std::setw(12) << L"p999 (us)"
+		<< std::endl;
+
+	for (const size_t messageSize : MessageSizes)
+	{
+		for (const DWORD clientCount : ClientCounts)
+		{
+			const BenchmarkConfig config{
+				.MessageSize = messageSize,
+				.ClientCount = clientCount,
+				.Iterations = iterations
+			};
+			Run(L"AnonymousPipe", config, BenchmarkAnonymousPipe);
+			Run(L"BlockingNamedPipe", config, BenchmarkBlockingNamedPipe);
+			Run(L"OverlappedNamedPipe", config, BenchmarkOverlappedNamedPipe);
+			Run(L"CompletionPortPipeServer", config, BenchmarkCompletionPortPipeServer);
+			Run(L"MemoryMappedFile", config, BenchmarkMemoryMappedFile);
+		}
+	}
+	return 0;
+}
\ No newline at end of file
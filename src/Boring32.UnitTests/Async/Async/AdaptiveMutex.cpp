@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/AdaptiveMutex.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(AdaptiveMutex)
+	{
+		public:
+			TEST_METHOD(TestLockUnlock)
+			{
+				Boring32::Async::AdaptiveMutex mutex;
+				Assert::IsTrue(mutex.Lock(INFINITE));
+				Assert::IsTrue(mutex.IsLocked());
+				Assert::IsFalse(mutex.TryLock());
+				mutex.Unlock();
+				Assert::IsFalse(mutex.IsLocked());
+				Assert::IsTrue(mutex.TryLock());
+				mutex.Unlock();
+			}
+
+			TEST_METHOD(TestLockTimesOut)
+			{
+				Boring32::Async::AdaptiveMutex mutex;
+				mutex.Lock(INFINITE);
+				bool acquired = true;
+				std::thread([&mutex, &acquired]() { acquired = mutex.Lock(50); }).join();
+				Assert::IsFalse(acquired);
+				mutex.Unlock();
+			}
+
+			TEST_METHOD(TestUnlockWhenUnlockedThrows)
+			{
+				Boring32::Async::AdaptiveMutex mutex;
+				Assert::ExpectException<std::runtime_error>([&mutex]() { mutex.Unlock(); });
+			}
+
+			TEST_METHOD(TestMutualExclusion)
+			{
+				Boring32::Async::AdaptiveMutex mutex;
+				uint64_t counter = 0;
+				std::vector<std::thread> threads;
+				for (int i = 0; i < 8; i++)
+				{
+					threads.emplace_back(
+						[&mutex, &counter]()
+						{
+							for (int j = 0; j < 100000; j++)
+							{
+								std::lock_guard lock(mutex);
+								counter++;
+							}
+						}
+					);
+				}
+				for (std::thread& thread : threads)
+					thread.join();
+				Assert::IsTrue(counter == 800000);
+				Assert::IsFalse(mutex.IsLocked());
+			}
+	};
+}
\ No newline at end of file
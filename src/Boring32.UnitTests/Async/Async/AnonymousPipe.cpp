@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/Pipes/AnonymousPipe.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(AnonymousPipe)
+	{
+		public:
+			TEST_METHOD(TestByteRoundTrip)
+			{
+				Boring32::Async::AnonymousPipe pipe(false, 4096, L"");
+				std::vector<std::byte> input(300);
+				for (size_t i = 0; i < input.size(); i++)
+					input[i] = static_cast<std::byte>(i);
+				pipe.Write(input);
+				Assert::IsTrue(pipe.GetUsedBytes() == input.size());
+
+				std::vector<std::byte> output(1024);
+				const DWORD bytesRead = pipe.Read(output);
+				Assert::IsTrue(bytesRead == input.size());
+				Assert::IsTrue(std::equal(input.begin(), input.end(), output.begin()));
+			}
+
+			TEST_METHOD(TestStringRoundTrip)
+			{
+				Boring32::Async::AnonymousPipe pipe(false, 4096, L"");
+				pipe.Write(std::wstring(L"Hello world"));
+				Assert::IsTrue(pipe.Read() == L"Hello world");
+			}
+
+			TEST_METHOD(TestWriteTooLarge)
+			{
+				Boring32::Async::AnonymousPipe pipe(false, 4096, L"");
+				Assert::ExpectException<std::runtime_error>(
+					[&pipe]
+					{
+						pipe.Write(std::vector<std::byte>(5000));
+					}
+				);
+			}
+
+			TEST_METHOD(TestFramedRoundTrip)
+			{
+				Boring32::Async::AnonymousPipe pipe(false, 4096, L"");
+				const std::vector<std::byte> first(100, std::byte{ 1 });
+				const std::vector<std::byte> second;
+				const std::vector<std::byte> third(1000, std::byte{ 3 });
+				pipe.FramedWrite(first);
+				pipe.FramedWrite(second);
+				pipe.FramedWrite(third);
+				pipe.CloseWrite();
+
+				std::span<const std::byte> message;
+				Assert::IsTrue(pipe.FramedRead(message));
+				Assert::IsTrue(std::equal(message.begin(), message.end(), first.begin(), first.end()));
+				Assert::IsTrue(pipe.FramedRead(message));
+				Assert::IsTrue(message.empty());
+				Assert::IsTrue(pipe.FramedRead(message));
+				Assert::IsTrue(std::equal(message.begin(), message.end(), third.begin(), third.end()));
+				Assert::IsFalse(pipe.FramedRead(message));
+			}
+
+			TEST_METHOD(TestFramedWriteLargerThanPipe)
+			{
+				Boring32::Async::AnonymousPipe pipe(false, 4096, L"");
+				std::vector<std::byte> input(1024 * 1024);
+				for (size_t i = 0; i < input.size(); i++)
+					input[i] = static_cast<std::byte>(i % 251);
+
+				// The writer blocks until the reader drains the pipe.
+				std::thread writer(
+					[&pipe, &input]
+					{
+						for (int i = 0; i < 3; i++)
+							pipe.FramedWrite(input);
+						pipe.CloseWrite();
+					}
+				);
+				std::span<const std::byte> message;
+				for (int i = 0; i < 3; i++)
+				{
+					Assert::IsTrue(pipe.FramedRead(message));
+					Assert::IsTrue(std::equal(message.begin(), message.end(), input.begin(), input.end()));
+				}
+				Assert::IsFalse(pipe.FramedRead(message));
+				writer.join();
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Boring32/include/Async/Pipes/BatchingNamedPipeClient.hpp"
+#include "Boring32/include/Async/Pipes/CompletionPortPipeServer.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(BatchingNamedPipeClient)
+	{
+		public:
+			TEST_METHOD(TestMessagesAreCoalesced)
+			{
+				std::vector<size_t> sizes;
+				std::atomic<uint32_t> batches = 0;
+				Boring32::Async::CompletionPortPipeServer server(L"BatchingNamedPipeClientTest", 1, 4096, 1, L"", true, {
+					.OnMessage = [&sizes, &batches](auto, std::span<const std::byte> batch)
+					{
+						std::span<const std::byte> message;
+						while (Boring32::Async::BatchingNamedPipeClient::NextMessage(batch, message))
+							sizes.push_back(message.size());
+						batches++;
+					}
+				});
+
+				Boring32::Async::BatchingNamedPipeClient client(L"BatchingNamedPipeClientTest", 1024, INFINITE);
+				client.Connect(0);
+				client.SetMode(PIPE_READMODE_MESSAGE);
+				for (int i = 0; i < 10; i++)
+					client.Post(std::vector<std::byte>(i, static_cast<std::byte>(i)));
+				const std::string head = "head";
+				const std::string tail = "tail";
+				const std::span<const std::byte> parts[] = {
+					std::as_bytes(std::span(head)),
+					std::as_bytes(std::span(tail))
+				};
+				client.Post(parts);
+				Assert::IsTrue(client.GetPendingBytes() > 0);
+				client.FlushBatch();
+				while (batches == 0)
+					Sleep(1);
+				server.Close();
+
+				Assert::IsTrue(batches == 1);
+				Assert::IsTrue(sizes.size() == 11);
+				for (size_t i = 0; i < 10; i++)
+					Assert::IsTrue(sizes[i] == i);
+				Assert::IsTrue(sizes[10] == head.size() + tail.size());
+			}
+
+			TEST_METHOD(TestDeadlineFlushesPartialBatch)
+			{
+				std::atomic<size_t> received = 0;
+				std::atomic<uint32_t> batches = 0;
+				Boring32::Async::CompletionPortPipeServer server(L"BatchingNamedPipeClientDeadlineTest", 1, 4096, 1, L"", true, {
+					.OnMessage = [&received, &batches](auto, std::span<const std::byte> batch)
+					{
+						std::span<const std::byte> message;
+						while (Boring32::Async::BatchingNamedPipeClient::NextMessage(batch, message))
+							received++;
+						batches++;
+					}
+				});
+
+				// Well short of the batch size, so only the deadline sends it.
+				Boring32::Async::BatchingNamedPipeClient client(L"BatchingNamedPipeClientDeadlineTest", 1024, 50);
+				client.Connect(0);
+				client.SetMode(PIPE_READMODE_MESSAGE);
+				const ULONGLONG posted = GetTickCount64();
+				for (int i = 0; i < 3; i++)
+					client.Post(std::vector<std::byte>(8, static_cast<std::byte>(i)));
+				while (batches == 0 && GetTickCount64() - posted < 5000)
+					Sleep(1);
+				const ULONGLONG elapsed = GetTickCount64() - posted;
+				server.Close();
+
+				Assert::IsTrue(batches == 1);
+				Assert::IsTrue(received == 3);
+				Assert::IsTrue(elapsed < 1000);
+				Assert::IsTrue(client.GetPendingBytes() == 0);
+			}
+
+			TEST_METHOD(TestNextMessageRejectsTruncatedBatch)
+			{
+				const std::byte truncated[] = { std::byte{ 5 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 1 } };
+				std::span<const std::byte> batch = truncated;
+				std::span<const std::byte> message;
+				Assert::ExpectException<std::invalid_argument>(
+					[&batch, &message]
+					{
+						Boring32::Async::BatchingNamedPipeClient::NextMessage(batch, message);
+					}
+				);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <memory>
+#include <vector>
+#include "Boring32/include/Async/Channel.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(Channel)
+	{
+		public:
+			TEST_METHOD(TestInvalidCapacity)
+			{
+				Assert::ExpectException<std::invalid_argument>(
+					[]()
+					{
+						Boring32::Async::Channel<int> channel(3, false);
+					});
+			}
+
+			TEST_METHOD(TestSendReceive)
+			{
+				Boring32::Async::Channel<std::unique_ptr<int>> channel(4, false);
+				Assert::IsTrue(channel.TrySend(std::make_unique<int>(5)));
+				std::unique_ptr<int> out;
+				Assert::IsTrue(channel.TryReceive(out));
+				Assert::IsTrue(*out == 5);
+				Assert::IsFalse(channel.TryReceive(out));
+				Assert::ExpectException<std::logic_error>(
+					[&channel, &out]
+					{
+						channel.TrySend(out);
+					}
+				);
+			}
+
+			TEST_METHOD(TestFull)
+			{
+				Boring32::Async::Channel<int> channel(2, false);
+				Assert::IsTrue(channel.TrySend(1));
+				Assert::IsTrue(channel.TrySend(2));
+				Assert::IsFalse(channel.TrySend(3));
+				Assert::IsFalse(channel.Send(3, 10));
+			}
+
+			TEST_METHOD(TestBatch)
+			{
+				Boring32::Async::Channel<int> channel(4, false);
+				std::vector<int> in{ 1, 2, 3, 4, 5, 6 };
+				Assert::IsTrue(channel.TrySendBatch(in) == 4);
+				std::vector<int> out;
+				Assert::IsTrue(channel.TryReceiveBatch(std::back_inserter(out), 10) == 4);
+				Assert::IsTrue(out == std::vector<int>({ 1, 2, 3, 4 }));
+			}
+
+			TEST_METHOD(TestReceiveTimeout)
+			{
+				Boring32::Async::Channel<int> channel(4, false);
+				int out = 0;
+				Assert::IsFalse(channel.Receive(out, 10));
+			}
+
+			TEST_METHOD(TestWaitableHandleSignalledOnce)
+			{
+				Boring32::Async::Channel<int> channel(4, true);
+				Assert::IsNotNull(channel.GetWaitableHandle());
+				Assert::IsTrue(channel.TrySend(1));
+				Assert::IsTrue(channel.TrySend(2));
+				Assert::IsTrue(WaitForSingleObject(channel.GetWaitableHandle(), 0) == WAIT_OBJECT_0);
+				Assert::IsTrue(WaitForSingleObject(channel.GetWaitableHandle(), 0) == WAIT_TIMEOUT);
+			}
+
+			TEST_METHOD(TestClosed)
+			{
+				Boring32::Async::Channel<int> channel(4, false);
+				Assert::IsTrue(channel.TrySend(1));
+				channel.Close();
+				int out = 0;
+				Assert::ExpectException<std::runtime_error>([&channel]() { channel.TrySend(2); });
+				Assert::ExpectException<std::runtime_error>([&channel, &out]() { channel.TryReceive(out); });
+				Assert::ExpectException<std::runtime_error>([&channel, &out]() { channel.Receive(out, INFINITE); });
+			}
+
+			TEST_METHOD(TestSize)
+			{
+				Boring32::Async::Channel<int> channel(4, false);
+				Assert::IsTrue(channel.Size() == 0);
+				std::vector<int> in{ 1, 2, 3 };
+				Assert::IsTrue(channel.TrySendBatch(in) == 3);
+				Assert::IsTrue(channel.Size() == 3);
+				int out = 0;
+				Assert::IsTrue(channel.TryReceive(out));
+				Assert::IsTrue(channel.Size() == 2);
+			}
+
+			TEST_METHOD(TestNoWaitableHandle)
+			{
+				Boring32::Async::Channel<int> channel(4, false);
+				Assert::IsNull(channel.GetWaitableHandle());
+			}
+	};
+}
@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Boring32/include/Async/Pipes/CompletionPortPipeServer.hpp"
+#include "Boring32/include/Async/Pipes/BlockingNamedPipeClient.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(CompletionPortPipeServer)
+	{
+		public:
+			TEST_METHOD(TestEchoAcrossClients)
+			{
+				using Boring32::Async::CompletionPortPipeServer;
+				std::atomic<uint32_t> disconnects = 0;
+				CompletionPortPipeServer* server = nullptr;
+				CompletionPortPipeServer echo(L"CompletionPortPipeServerTest", 4, 64, 2, L"", true, {
+					.OnMessage = [&server](CompletionPortPipeServer::ConnectionId id, std::span<const std::byte> message)
+					{
+						server->Send(id, message);
+					},
+					.OnDisconnect = [&disconnects](CompletionPortPipeServer::ConnectionId)
+					{
+						disconnects++;
+					}
+				});
+				server = &echo;
+
+				for (int i = 0; i < 3; i++)
+				{
+					Boring32::Async::BlockingNamedPipeClient client(L"CompletionPortPipeServerTest");
+					client.Connect(0);
+					client.SetMode(PIPE_READMODE_MESSAGE);
+					// Larger than the server's read buffer.
+					const std::vector<std::byte> message(200, static_cast<std::byte>(i));
+					client.Write(message);
+					std::vector<std::byte> reply(1024);
+					DWORD bytesRead = 0;
+					Assert::IsTrue(client.Read(reply, bytesRead));
+					Assert::IsTrue(bytesRead == message.size());
+					Assert::IsTrue(std::equal(message.begin(), message.end(), reply.begin()));
+					client.Close();
+					// Let the instance return to listening before the next client.
+					while (disconnects != static_cast<uint32_t>(i + 1))
+						Sleep(1);
+				}
+				echo.Close();
+				Assert::IsTrue(echo.GetConnectionCount() == 0);
+			}
+	};
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "CppUnitTest.h"
+#include <thread>
+#include <vector>
 #include "Boring32/include/Async/Event.hpp"
 #include "Boring32/include/Async/EventLoop.hpp"
 
@@ -73,5 +75,61 @@ namespace Async
 				eventLoop.Erase(event2.GetHandle());
 				Assert::IsTrue(eventLoop.Size() == 1);
 			}
+
+			TEST_METHOD(TestWaitAndDrain)
+			{
+				int fired = 0;
+				Boring32::Async::Event event1(false, false, false);
+				Boring32::Async::Event event2(false, false, false);
+				Boring32::Async::Event event3(false, false, false);
+				Boring32::Async::EventLoop eventLoop;
+				eventLoop.On(event1.GetHandle(), [&fired]() { fired++; });
+				eventLoop.On(event2.GetHandle(), [&fired]() { fired++; });
+				eventLoop.On(event3.GetHandle(), [&fired]() { fired++; });
+				event1.Signal();
+				event3.Signal();
+
+				Assert::IsTrue(eventLoop.WaitAndDrain(1000) == 2);
+				Assert::IsTrue(fired == 2);
+				Assert::IsTrue(eventLoop.WaitAndDrain(0) == 0);
+			}
+
+			TEST_METHOD(TestOnWhileWaiting)
+			{
+				bool fired = false;
+				Boring32::Async::Event event1(false, false, false);
+				Boring32::Async::Event event2(false, false, false);
+				Boring32::Async::EventLoop eventLoop;
+				eventLoop.On(event1.GetHandle(), []() {});
+
+				std::thread registrar(
+					[&eventLoop, &event2, &fired]() {
+						Sleep(50);
+						eventLoop.On(event2.GetHandle(), [&fired]() { fired = true; });
+						event2.Signal();
+					}
+				);
+				Assert::IsTrue(eventLoop.WaitOn(5000, false));
+				registrar.join();
+				Assert::IsTrue(fired);
+			}
+
+			TEST_METHOD(TestMaxHandles)
+			{
+				std::vector<Boring32::Async::Event> events;
+				for (DWORD i = 0; i <= Boring32::Async::EventLoop::MaxHandles; i++)
+					events.emplace_back(false, false, false);
+				Boring32::Async::EventLoop eventLoop;
+				for (DWORD i = 0; i < Boring32::Async::EventLoop::MaxHandles; i++)
+					eventLoop.On(events[i].GetHandle(), []() {});
+				Assert::ExpectException<std::length_error>(
+					[&eventLoop, &events]()
+					{
+						eventLoop.On(events.back().GetHandle(), []() {});
+					});
+
+				events.front().Signal();
+				Assert::IsTrue(eventLoop.WaitOn(1000, false));
+			}
 	};
 }
\ No newline at end of file
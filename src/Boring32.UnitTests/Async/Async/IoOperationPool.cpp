@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <algorithm>
+#include <vector>
+#include "Boring32/include/Async/IoOperationPool.hpp"
+#include "Boring32/include/Async/Pipes/OverlappedNamedPipeServer.hpp"
+#include "Boring32/include/Async/Pipes/OverlappedNamedPipeClient.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(IoOperationPool)
+	{
+		public:
+			TEST_METHOD(TestReleasedOperationsAreReused)
+			{
+				Boring32::Async::IoOperationPool pool(128, 4);
+				Assert::IsTrue(pool.GetAllocatedCount() == 4);
+
+				std::vector<Boring32::Async::IoOperation*> operations;
+				for (int i = 0; i < 4; i++)
+				{
+					Boring32::Async::IoOperation* operation = pool.Acquire(100);
+					Assert::IsTrue(operation->Length == 100);
+					Assert::IsTrue(operation->Capacity == 128);
+					Assert::IsNull(operation->Overlapped.hEvent);
+					operations.push_back(operation);
+				}
+				for (Boring32::Async::IoOperation* operation : operations)
+					pool.Release(operation);
+				for (int i = 0; i < 4; i++)
+					pool.Release(pool.Acquire(128));
+				Assert::IsTrue(pool.GetAllocatedCount() == 4);
+			}
+
+			TEST_METHOD(TestOversizedOperation)
+			{
+				Boring32::Async::IoOperationPool pool(128, 0);
+				Boring32::Async::IoOperation* operation = pool.Acquire(1000);
+				Assert::IsFalse(operation->IsPooled);
+				Assert::IsTrue(operation->GetBuffer().size() == 1000);
+				pool.Release(operation);
+				Assert::IsTrue(pool.GetAllocatedCount() == 0);
+			}
+
+			TEST_METHOD(TestWaitableOperation)
+			{
+				Boring32::Async::IoOperationPool pool(128, 1);
+				Boring32::Async::IoOperation* operation = pool.AcquireWaitable(16);
+				Assert::IsNotNull(operation->Overlapped.hEvent);
+				Assert::IsTrue(
+					Boring32::Async::IoOperation::FromOverlapped(&operation->Overlapped) == operation
+				);
+				pool.Release(operation);
+			}
+
+			TEST_METHOD(TestPooledPipeIo)
+			{
+				Boring32::Async::OverlappedNamedPipeServer server(L"IoOperationPoolTest", 4096, 1, L"", false, true);
+				Boring32::Async::OverlappedOp connect;
+				server.Connect(connect);
+				Boring32::Async::OverlappedNamedPipeClient client(L"IoOperationPoolTest");
+				client.Connect(0);
+				client.SetMode(PIPE_READMODE_MESSAGE);
+				Assert::IsTrue(connect.WaitForCompletion(1000));
+
+				Boring32::Async::IoOperationPool pool(64, 2);
+				for (int i = 0; i < 4; i++)
+				{
+					const std::vector<std::byte> message(10 + i, static_cast<std::byte>(i));
+					Boring32::Async::IoOperation* read = server.Read(64, pool);
+					Boring32::Async::IoOperation* write = client.Write(message, pool);
+					Assert::IsTrue(write->WaitForCompletion(1000));
+					Assert::IsTrue(read->WaitForCompletion(1000));
+					Assert::IsTrue(read->IsSuccessful());
+					Assert::IsTrue(read->GetBytesTransferred() == message.size());
+					Assert::IsTrue(std::equal(message.begin(), message.end(), read->GetBuffer().begin()));
+					pool.Release(write);
+					pool.Release(read);
+				}
+				Assert::IsTrue(pool.GetAllocatedCount() == 2);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/LightweightEvent.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(LightweightEvent)
+	{
+		public:
+			TEST_METHOD(TestManualResetEvent)
+			{
+				Boring32::Async::LightweightEvent event(true, false);
+				Assert::IsFalse(event.WaitOnEvent(0));
+				event.Signal();
+				Assert::IsTrue(event.WaitOnEvent(0));
+				Assert::IsTrue(event.WaitOnEvent(0));
+				event.Reset();
+				Assert::IsFalse(event.WaitOnEvent(50));
+			}
+
+			TEST_METHOD(TestAutoResetEvent)
+			{
+				Boring32::Async::LightweightEvent event(false, true);
+				Assert::IsTrue(event.WaitOnEvent(0));
+				Assert::IsFalse(event.WaitOnEvent(0));
+			}
+
+			TEST_METHOD(TestSignalReleasesAllWaiters)
+			{
+				Boring32::Async::LightweightEvent event(true, false);
+				std::atomic<int> woken = 0;
+				std::vector<std::thread> waiters;
+				for (int i = 0; i < 4; i++)
+				{
+					waiters.emplace_back(
+						[&event, &woken]()
+						{
+							event.WaitOnEvent();
+							woken++;
+						}
+					);
+				}
+				event.Signal();
+				for (std::thread& waiter : waiters)
+					waiter.join();
+				Assert::IsTrue(woken == 4);
+			}
+
+			TEST_METHOD(TestHandleCarriesState)
+			{
+				Boring32::Async::LightweightEvent event(true, true);
+				const HANDLE handle = event.GetHandle();
+				Assert::IsNotNull(handle);
+				Assert::IsTrue(event.GetHandle() == handle);
+				Assert::IsTrue(WaitForSingleObject(handle, 0) == WAIT_OBJECT_0);
+				event.Reset();
+				Assert::IsTrue(WaitForSingleObject(handle, 0) == WAIT_TIMEOUT);
+				event.Signal();
+				Assert::IsTrue(event.WaitOnEvent(0));
+			}
+
+			TEST_METHOD(TestHandleCreatedWhileWaiting)
+			{
+				Boring32::Async::LightweightEvent event(false, false);
+				bool signalled = false;
+				std::thread waiter([&event, &signalled]() { signalled = event.WaitOnEvent(5000); });
+				Sleep(20);
+				const HANDLE handle = event.GetHandle();
+				event.Signal();
+				waiter.join();
+				Assert::IsTrue(signalled);
+				// The waiter consumed the auto-reset signal.
+				Assert::IsTrue(WaitForSingleObject(handle, 0) == WAIT_TIMEOUT);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/LightweightSemaphore.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(LightweightSemaphore)
+	{
+		public:
+			TEST_METHOD(TestAcquireAndRelease)
+			{
+				Boring32::Async::LightweightSemaphore semaphore(2, 4);
+				Assert::IsTrue(semaphore.Acquire(0));
+				Assert::IsTrue(semaphore.Acquire(0));
+				Assert::IsFalse(semaphore.Acquire(0));
+				Assert::IsTrue(semaphore.GetCurrentCount() == 0);
+				semaphore.Release(3);
+				Assert::IsTrue(semaphore.GetCurrentCount() == 3);
+				Assert::IsTrue(semaphore.Acquire(3, 0));
+				Assert::IsTrue(semaphore.GetCurrentCount() == 0);
+			}
+
+			TEST_METHOD(TestAcquireTimesOut)
+			{
+				Boring32::Async::LightweightSemaphore semaphore(0, 1);
+				Assert::IsFalse(semaphore.Acquire(50));
+			}
+
+			TEST_METHOD(TestReleaseBeyondMaximumThrows)
+			{
+				Boring32::Async::LightweightSemaphore semaphore(1, 1);
+				Assert::ExpectException<std::runtime_error>([&semaphore]() { semaphore.Release(); });
+			}
+
+			TEST_METHOD(TestInvalidCounts)
+			{
+				Assert::ExpectException<std::invalid_argument>(
+					[]() { Boring32::Async::LightweightSemaphore semaphore(2, 1); }
+				);
+				Boring32::Async::LightweightSemaphore semaphore(1, 1);
+				Assert::ExpectException<std::invalid_argument>(
+					[&semaphore]() { semaphore.Acquire(2, 0); }
+				);
+			}
+
+			TEST_METHOD(TestReleaseWakesWaiter)
+			{
+				Boring32::Async::LightweightSemaphore semaphore(0, 2);
+				bool acquired = false;
+				std::thread waiter([&semaphore, &acquired]() { acquired = semaphore.Acquire(2, INFINITE); });
+				semaphore.Release();
+				semaphore.Release();
+				waiter.join();
+				Assert::IsTrue(acquired);
+				Assert::IsTrue(semaphore.GetCurrentCount() == 0);
+			}
+
+			TEST_METHOD(TestLimitsConcurrency)
+			{
+				Boring32::Async::LightweightSemaphore semaphore(3, 3);
+				std::atomic<int> inside = 0;
+				std::atomic<bool> exceeded = false;
+				std::vector<std::thread> threads;
+				for (int i = 0; i < 8; i++)
+				{
+					threads.emplace_back(
+						[&semaphore, &inside, &exceeded]()
+						{
+							for (int j = 0; j < 10000; j++)
+							{
+								semaphore.Acquire(INFINITE);
+								if (++inside > 3)
+									exceeded = true;
+								inside--;
+								semaphore.Release();
+							}
+						}
+					);
+				}
+				for (std::thread& thread : threads)
+					thread.join();
+				Assert::IsFalse(exceeded);
+				Assert::IsTrue(semaphore.GetCurrentCount() == 3);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/LockProfiler.hpp"
+#include "Boring32/include/Async/Mutex.hpp"
+#include "Boring32/include/Async/CriticalSectionLock.hpp"
+#include "Boring32/include/Async/SlimReadWriteLock.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(LockProfiler)
+	{
+		public:
+			TEST_METHOD_CLEANUP(Cleanup)
+			{
+				Boring32::Async::LockProfiler::Disable();
+				Boring32::Async::LockProfiler::Reset();
+			}
+
+			TEST_METHOD(TestDisabledRecordsNothing)
+			{
+				Boring32::Async::SlimReadWriteLock lock;
+				lock.AcquireExclusiveLock();
+				lock.ReleaseExclusiveLock();
+				Boring32::Async::LockProfile profile;
+				Assert::IsFalse(Boring32::Async::LockProfiler::TryGetProfile(&lock, profile));
+			}
+
+			TEST_METHOD(TestRecordsMutex)
+			{
+				Boring32::Async::Mutex mutex(false, false, L"LockProfiler-TestRecordsMutex");
+				Boring32::Async::LockProfiler::Enable();
+				for (int i = 0; i < 10; i++)
+				{
+					mutex.Lock(INFINITE, false);
+					mutex.Unlock();
+				}
+				Boring32::Async::LockProfile profile;
+				Assert::IsTrue(Boring32::Async::LockProfiler::TryGetProfile(&mutex, profile));
+				Assert::IsTrue(profile.Kind == L"Mutex");
+				Assert::IsTrue(profile.Tag == L"LockProfiler-TestRecordsMutex");
+				Assert::IsTrue(profile.Acquisitions == 10);
+				Assert::IsTrue(profile.ContendedAcquisitions == 0);
+				uint64_t holds = 0;
+				for (uint64_t count : profile.HoldHistogram)
+					holds += count;
+				Assert::IsTrue(holds == 10);
+			}
+
+			TEST_METHOD(TestResetDiscardsCachedProfiles)
+			{
+				Boring32::Async::SlimReadWriteLock lock;
+				Boring32::Async::LockProfiler::Enable();
+				for (int i = 0; i < 5; i++)
+				{
+					lock.AcquireExclusiveLock();
+					lock.ReleaseExclusiveLock();
+				}
+				Boring32::Async::LockProfiler::Disable();
+				Boring32::Async::LockProfiler::Reset();
+
+				Boring32::Async::LockProfiler::Enable();
+				for (int i = 0; i < 3; i++)
+				{
+					lock.AcquireExclusiveLock();
+					lock.ReleaseExclusiveLock();
+				}
+				Boring32::Async::LockProfile profile;
+				Assert::IsTrue(Boring32::Async::LockProfiler::TryGetProfile(&lock, profile));
+				Assert::IsTrue(profile.Acquisitions == 3);
+				Assert::IsTrue(profile.Kind.empty() == false);
+			}
+
+			TEST_METHOD(TestRecordsContendedCallSites)
+			{
+				CRITICAL_SECTION criticalSection;
+				InitializeCriticalSection(&criticalSection);
+				Boring32::Async::LockProfiler::Enable();
+				Boring32::Async::LockProfiler::SetTag(&criticalSection, L"queue");
+				std::vector<std::thread> threads;
+				for (int i = 0; i < 4; i++)
+				{
+					threads.emplace_back(
+						[&criticalSection]()
+						{
+							for (int j = 0; j < 100; j++)
+							{
+								Boring32::Async::CriticalSectionLock lock(criticalSection);
+								Sleep(0);
+							}
+						}
+					);
+				}
+				for (std::thread& thread : threads)
+					thread.join();
+				DeleteCriticalSection(&criticalSection);
+
+				Boring32::Async::LockProfile profile;
+				Assert::IsTrue(Boring32::Async::LockProfiler::TryGetProfile(&criticalSection, profile));
+				Assert::IsTrue(profile.Tag == L"queue");
+				Assert::IsTrue(profile.Acquisitions == 400);
+				Assert::IsTrue(profile.ContendedCallSites.empty() == (profile.ContendedAcquisitions == 0));
+				Assert::IsTrue(Boring32::Async::LockProfiler::GetReport().find(L"queue") != std::wstring::npos);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "pch.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "CppUnitTest.h"
+#include "Boring32/include/Async/MemoryMappedFile.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(MemoryMappedFile)
+	{
+		public:
+			TEST_METHOD(TestPagefileMapping)
+			{
+				Boring32::Async::MemoryMappedFile mapping(L"MemoryMappedFile-TestPagefileMapping", 4096, false);
+				Assert::IsNotNull(mapping.GetViewPointer());
+				Assert::IsTrue(mapping.GetSize() == 4096);
+			}
+
+			TEST_METHOD(TestFileBackedWindow)
+			{
+				const std::filesystem::path path = std::filesystem::temp_directory_path() / L"Boring32-TestFileBackedWindow.bin";
+				const size_t fileSize = 1024 * 1024;
+				{
+					std::vector<char> contents(fileSize);
+					for (size_t i = 0; i < fileSize; i++)
+						contents[i] = static_cast<char>(i / 4096);
+					std::ofstream file(path, std::ios::binary);
+					file.write(contents.data(), contents.size());
+				}
+
+				{
+					Boring32::Async::MemoryMappedFile mapping(
+						path,
+						Boring32::Async::MemoryMappedFile::FileAccess::ReadOnly,
+						0
+					);
+					Assert::IsTrue(mapping.GetSize() == fileSize);
+					Assert::IsNull(mapping.GetViewPointer());
+
+					Boring32::Async::MemoryMappedWindow window = mapping.OpenWindow(64 * 1024, true);
+					std::span<std::byte> region = window.Map(5 * 4096, 16);
+					Assert::IsTrue(region[0] == std::byte{ 5 });
+					const UINT64 viewOffset = window.GetViewOffset();
+
+					// Within the current view, so nothing is remapped.
+					region = window.Map(5 * 4096 + 100, 16);
+					Assert::IsTrue(window.GetViewOffset() == viewOffset);
+
+					region = window.Map(fileSize - 16, 16);
+					Assert::IsTrue(region[15] == std::byte{ 255 });
+					Assert::IsTrue(window.GetViewOffset() % (64 * 1024) == 0);
+					Assert::ExpectException<std::out_of_range>([&window, fileSize] { window.Map(fileSize - 8, 16); });
+				}
+				std::filesystem::remove(path);
+			}
+
+			TEST_METHOD(TestFileBackedWriteExtendsFile)
+			{
+				const std::filesystem::path path = std::filesystem::temp_directory_path() / L"Boring32-TestFileBackedWriteExtendsFile.bin";
+				std::ofstream(path, std::ios::binary).put('x');
+
+				{
+					Boring32::Async::MemoryMappedFile mapping(
+						path,
+						Boring32::Async::MemoryMappedFile::FileAccess::ReadWrite,
+						128 * 1024
+					);
+					Boring32::Async::MemoryMappedWindow window = mapping.OpenWindow(4096, false);
+					std::span<std::byte> region = window.Map(100 * 1024, 4);
+					std::memcpy(region.data(), "abcd", 4);
+				}
+				Assert::IsTrue(std::filesystem::file_size(path) == 128 * 1024);
+				std::filesystem::remove(path);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/PhaseBarrier.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(PhaseBarrier)
+	{
+		public:
+			TEST_METHOD(TestInvalidParticipants)
+			{
+				Assert::ExpectException<std::invalid_argument>(
+					[]() { Boring32::Async::PhaseBarrier barrier(0); }
+				);
+			}
+
+			TEST_METHOD(TestPhasesComplete)
+			{
+				constexpr uint32_t Threads = 4;
+				constexpr uint32_t Phases = 1000;
+				std::atomic<uint32_t> completions = 0;
+				std::atomic<uint32_t> lastArrivals = 0;
+				Boring32::Async::PhaseBarrier barrier(
+					Threads,
+					[&completions]() { completions++; },
+					Boring32::Async::PhaseBarrier::DefaultMaxSpins
+				);
+				std::vector<std::thread> threads;
+				for (uint32_t i = 0; i < Threads; i++)
+				{
+					threads.emplace_back(
+						[&barrier, &lastArrivals]()
+						{
+							for (uint32_t phase = 0; phase < Phases; phase++)
+							{
+								if (barrier.Enter())
+									lastArrivals++;
+							}
+						}
+					);
+				}
+				for (std::thread& thread : threads)
+					thread.join();
+				Assert::IsTrue(completions == Phases);
+				Assert::IsTrue(lastArrivals == Phases);
+				Assert::IsTrue(barrier.GetPhase() == Phases);
+			}
+
+			TEST_METHOD(TestArriveAndDrop)
+			{
+				Boring32::Async::PhaseBarrier barrier(2);
+				std::thread leaver([&barrier]() { barrier.ArriveAndDrop(); });
+				barrier.Enter();
+				leaver.join();
+				Assert::IsTrue(barrier.GetParticipants() == 1);
+				// The remaining participant now completes phases alone.
+				Assert::IsTrue(barrier.Enter());
+				Assert::IsTrue(barrier.GetPhase() == 2);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/ReaderBiasedLock.hpp"
+#include "Boring32/include/Async/SlimReadWriteLock.hpp"
+#include "Boring32/include/Async/ReadWriteLockGuard.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(ReaderBiasedLock)
+	{
+		public:
+			TEST_METHOD(TestSharedLocksCoexist)
+			{
+				Boring32::Async::ReaderBiasedLock lock;
+				Boring32::Async::SharedLockGuard first(lock);
+				bool acquired = false;
+				std::thread(
+					[&lock, &acquired]()
+					{
+						Boring32::Async::SharedLockGuard second(lock, std::try_to_lock);
+						acquired = second.OwnsLock();
+					}
+				).join();
+				Assert::IsTrue(acquired);
+			}
+
+			TEST_METHOD(TestExclusiveLockExcludesOthers)
+			{
+				Boring32::Async::ReaderBiasedLock lock;
+				Boring32::Async::ExclusiveLockGuard writer(lock);
+				bool readerAcquired = true;
+				bool writerAcquired = true;
+				std::thread(
+					[&lock, &readerAcquired, &writerAcquired]()
+					{
+						Boring32::Async::SharedLockGuard reader(lock, std::try_to_lock);
+						readerAcquired = reader.OwnsLock();
+						Boring32::Async::ExclusiveLockGuard other(lock, std::try_to_lock);
+						writerAcquired = other.OwnsLock();
+					}
+				).join();
+				Assert::IsFalse(readerAcquired);
+				Assert::IsFalse(writerAcquired);
+			}
+
+			TEST_METHOD(TestSharedLockExcludesWriters)
+			{
+				Boring32::Async::ReaderBiasedLock lock;
+				Boring32::Async::SharedLockGuard reader(lock);
+				bool acquired = true;
+				std::thread(
+					[&lock, &acquired]()
+					{
+						Boring32::Async::ExclusiveLockGuard writer(lock, std::try_to_lock);
+						acquired = writer.OwnsLock();
+					}
+				).join();
+				Assert::IsFalse(acquired);
+			}
+
+			TEST_METHOD(TestInvalidStripeCount)
+			{
+				Assert::ExpectException<std::invalid_argument>(
+					[]() { Boring32::Async::ReaderBiasedLock lock(3); }
+				);
+			}
+
+			TEST_METHOD(TestReadersSeeConsistentWrites)
+			{
+				Boring32::Async::ReaderBiasedLock lock;
+				uint64_t first = 0;
+				uint64_t second = 0;
+				std::atomic<bool> stop = false;
+				std::atomic<bool> torn = false;
+				std::vector<std::thread> readers;
+				for (int i = 0; i < 8; i++)
+				{
+					readers.emplace_back(
+						[&]()
+						{
+							while (stop == false)
+							{
+								Boring32::Async::SharedLockGuard reader(lock);
+								if (first != second)
+									torn = true;
+							}
+						}
+					);
+				}
+				for (int i = 0; i < 10000; i++)
+				{
+					Boring32::Async::ExclusiveLockGuard writer(lock);
+					first++;
+					second++;
+				}
+				stop = true;
+				for (std::thread& reader : readers)
+					reader.join();
+				Assert::IsFalse(torn);
+				Assert::IsTrue(first == 10000);
+			}
+
+			TEST_METHOD(TestGuardsWorkWithSlimReadWriteLock)
+			{
+				Boring32::Async::SlimReadWriteLock lock;
+				{
+					Boring32::Async::ExclusiveLockGuard writer(lock);
+				}
+				Boring32::Async::SharedLockGuard reader(lock, std::try_to_lock);
+				Assert::IsTrue(reader.OwnsLock());
+			}
+	};
+}
\ No newline at end of file
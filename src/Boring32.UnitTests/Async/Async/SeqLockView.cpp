@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Boring32/include/Async/SeqLockView.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(SeqLockView)
+	{
+		struct Counters
+		{
+			uint64_t Requests;
+			uint64_t Bytes;
+			uint32_t Errors;
+		};
+
+		public:
+			TEST_METHOD(TestReaderSeesWrites)
+			{
+				Boring32::Async::SeqLockView<Counters> writer(L"SeqLockView-TestReaderSeesWrites", true, false);
+				Boring32::Async::SeqLockView<Counters> reader(L"SeqLockView-TestReaderSeesWrites", false, false);
+				Assert::IsTrue(reader.GetVersion() == 0);
+				Assert::IsTrue(reader.Read().Requests == 0);
+
+				writer.Write({ 1, 100, 0 });
+				writer.Update([](Counters& counters) { counters.Errors++; });
+				const Counters counters = reader.Read();
+				Assert::IsTrue(counters.Requests == 1);
+				Assert::IsTrue(counters.Bytes == 100);
+				Assert::IsTrue(counters.Errors == 1);
+				Assert::IsTrue(reader.GetVersion() == 2);
+			}
+
+			TEST_METHOD(TestReadIfChanged)
+			{
+				Boring32::Async::SeqLockView<Counters> writer(L"SeqLockView-TestReadIfChanged", true, false);
+				Boring32::Async::SeqLockView<Counters> reader(L"SeqLockView-TestReadIfChanged", false, false);
+				Counters counters{};
+				uint64_t version = 0;
+				Assert::IsFalse(reader.ReadIfChanged(counters, version));
+
+				writer.Write({ 5, 0, 0 });
+				Assert::IsTrue(reader.ReadIfChanged(counters, version));
+				Assert::IsTrue(counters.Requests == 5);
+				Assert::IsTrue(version == 1);
+				Assert::IsFalse(reader.ReadIfChanged(counters, version));
+			}
+
+			TEST_METHOD(TestSnapshotsAreConsistent)
+			{
+				Boring32::Async::SeqLockView<Counters> writer(L"SeqLockView-TestSnapshotsAreConsistent", true, false);
+				std::atomic<bool> stop = false;
+				std::atomic<bool> torn = false;
+				std::vector<std::thread> readers;
+				for (int i = 0; i < 4; i++)
+				{
+					readers.emplace_back(
+						[&stop, &torn]()
+						{
+							Boring32::Async::SeqLockView<Counters> reader(L"SeqLockView-TestSnapshotsAreConsistent", false, false);
+							while (stop == false)
+							{
+								const Counters counters = reader.Read();
+								if (counters.Bytes != counters.Requests * 2 || counters.Errors != static_cast<uint32_t>(counters.Requests))
+									torn = true;
+							}
+						}
+					);
+				}
+				for (uint64_t i = 1; i <= 200000; i++)
+					writer.Write({ i, i * 2, static_cast<uint32_t>(i) });
+				stop = true;
+				for (std::thread& reader : readers)
+					reader.join();
+				Assert::IsFalse(torn);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <vector>
+#include "Boring32/include/Async/Event.hpp"
+#include "Boring32/include/Async/ShardedEventLoop.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(ShardedEventLoop)
+	{
+		public:
+			TEST_METHOD(TestDispatch)
+			{
+				Boring32::Async::Event event1(false, false, false);
+				Boring32::Async::Event event2(false, true, false);
+
+				Boring32::Async::ShardedEventLoop eventLoop;
+				eventLoop.On(
+					event1.GetHandle(),
+					[&event2]() {
+						event2.Signal();
+					}
+				);
+				event1.Signal();
+
+				Assert::IsTrue(event2.WaitOnEvent(1000, false));
+			}
+
+			TEST_METHOD(TestMoreThanMaximumWaitObjects)
+			{
+				constexpr size_t count = MAXIMUM_WAIT_OBJECTS * 3;
+				std::vector<Boring32::Async::Event> events;
+				std::atomic<size_t> fired = 0;
+				Boring32::Async::Event done(false, true, false);
+
+				Boring32::Async::ShardedEventLoop eventLoop;
+				for (size_t i = 0; i < count; i++)
+					events.emplace_back(false, false, false);
+				for (Boring32::Async::Event& event : events)
+				{
+					eventLoop.On(
+						event.GetHandle(),
+						[&fired, &done, count]() {
+							if (++fired == count)
+								done.Signal();
+						}
+					);
+				}
+				Assert::IsTrue(eventLoop.Size() == count);
+				Assert::IsTrue(eventLoop.GetShardCount() == 4);
+
+				for (Boring32::Async::Event& event : events)
+					event.Signal();
+				Assert::IsTrue(done.WaitOnEvent(5000, false));
+			}
+
+			TEST_METHOD(TestErase)
+			{
+				Boring32::Async::Event event1(false, false, false);
+				std::atomic<int> fired = 0;
+
+				Boring32::Async::ShardedEventLoop eventLoop;
+				eventLoop.On(
+					event1.GetHandle(),
+					[&fired]() {
+						fired++;
+					}
+				);
+				Assert::IsTrue(eventLoop.Size() == 1);
+				Assert::IsTrue(eventLoop.Erase(event1.GetHandle()));
+				Assert::IsFalse(eventLoop.Erase(event1.GetHandle()));
+				Assert::IsTrue(eventLoop.Size() == 0);
+
+				event1.Signal();
+				Sleep(50);
+				Assert::IsTrue(fired == 0);
+			}
+
+			TEST_METHOD(TestEraseAcrossShardsFromHandlers)
+			{
+				// The first and last events land on different shards.
+				constexpr size_t count = Boring32::Async::ShardedEventLoop::HandlesPerShard + 1;
+				std::vector<Boring32::Async::Event> events;
+				for (size_t i = 0; i < count; i++)
+					events.emplace_back(false, false, false);
+				Boring32::Async::Event done1(false, true, false);
+				Boring32::Async::Event done2(false, true, false);
+
+				Boring32::Async::ShardedEventLoop eventLoop;
+				for (size_t i = 1; i < count - 1; i++)
+					eventLoop.On(events[i].GetHandle(), []() {});
+				HANDLE first = events.front().GetHandle();
+				HANDLE last = events.back().GetHandle();
+				eventLoop.On(
+					first,
+					[&eventLoop, &done1, last]() {
+						eventLoop.Erase(last);
+						done1.Signal();
+					}
+				);
+				eventLoop.On(
+					last,
+					[&eventLoop, &done2, first]() {
+						eventLoop.Erase(first);
+						done2.Signal();
+					}
+				);
+				Assert::IsTrue(eventLoop.GetShardCount() == 2);
+
+				events.front().Signal();
+				events.back().Signal();
+				Assert::IsTrue(done1.WaitOnEvent(1000, false) || done2.WaitOnEvent(1000, false));
+				eventLoop.Close();
+			}
+	};
+}
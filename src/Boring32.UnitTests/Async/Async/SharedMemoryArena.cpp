@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Boring32/include/Async/SharedMemoryArena.hpp"
+#include "Boring32/include/Async/SharedVector.hpp"
+#include "Boring32/include/Async/SharedHashMap.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(SharedMemoryArena)
+	{
+		struct Table
+		{
+			Boring32::Async::SharedVector<int> Numbers;
+			Boring32::Async::SharedHashMap<uint32_t, Boring32::Async::SharedVector<char>> Names;
+		};
+
+		public:
+			TEST_METHOD(TestReaderSeesPublishedRoot)
+			{
+				Boring32::Async::SharedMemoryArena writer(L"SharedMemoryArena-TestReaderSeesPublishedRoot", 1024 * 1024, false);
+				Table* table = writer.Construct<Table>();
+				for (int i = 0; i < 100; i++)
+					table->Numbers.PushBack(writer, i * 2);
+				for (uint32_t key = 0; key < 50; key++)
+				{
+					Boring32::Async::SharedVector<char>* name = table->Names.TryEmplace(writer, key).first;
+					name->PushBack(writer, static_cast<char>('a' + key % 26));
+				}
+				writer.SetRoot(table);
+
+				// A second mapping of the same arena, as another process would open it.
+				Boring32::Async::SharedMemoryArena reader(writer.GetName(), 1024 * 1024, false, FILE_MAP_READ);
+				const Table* shared = reader.GetRoot<Table>();
+				Assert::IsNotNull(shared);
+				Assert::IsTrue(shared->Numbers.Size() == 100);
+				Assert::IsTrue(shared->Numbers[99] == 198);
+				Assert::IsTrue(shared->Names.Size() == 50);
+				const Boring32::Async::SharedVector<char>* name = shared->Names.Find(27);
+				Assert::IsNotNull(name);
+				Assert::IsTrue((*name)[0] == 'b');
+				Assert::IsNull(shared->Names.Find(50));
+			}
+
+			TEST_METHOD(TestTryEmplaceKeepsExistingValue)
+			{
+				Boring32::Async::SharedMemoryArena arena(L"SharedMemoryArena-TestTryEmplaceKeepsExistingValue", 64 * 1024, false);
+				Boring32::Async::SharedHashMap<uint64_t, uint64_t>* map = arena.Construct<Boring32::Async::SharedHashMap<uint64_t, uint64_t>>();
+				Assert::IsTrue(map->TryEmplace(arena, 1, 10).second);
+				Assert::IsFalse(map->TryEmplace(arena, 1, 20).second);
+				Assert::IsTrue(*map->Find(1) == 10);
+			}
+
+			TEST_METHOD(TestFullArenaThrows)
+			{
+				Boring32::Async::SharedMemoryArena arena(L"SharedMemoryArena-TestFullArenaThrows", 4096, false);
+				Assert::ExpectException<std::bad_alloc>([&arena] { arena.Allocate(8192, 8); });
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "pch.h"
+#include <cstring>
+#include <thread>
+#include "CppUnitTest.h"
+#include "Boring32/include/Async/SharedMemoryChannel.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(SharedMemoryChannel)
+	{
+		public:
+			TEST_METHOD(TestSendAndReceive)
+			{
+				Boring32::Async::SharedMemoryChannel receiver(
+					L"SharedMemoryChannel-TestSendAndReceive",
+					4096,
+					Boring32::Async::SharedMemoryChannel::Mode::SingleProducer,
+					false
+				);
+				Boring32::Async::SharedMemoryChannel sender(receiver.GetName(), 4096, false);
+
+				const std::vector<std::byte> sent(100, std::byte{ 0x42 });
+				Assert::IsTrue(sender.TrySend(sent));
+				Assert::IsTrue(receiver.GetUsedBytes() > 0);
+
+				std::vector<std::byte> received;
+				Assert::IsTrue(receiver.TryReceive(received));
+				Assert::IsTrue(received == sent);
+				Assert::IsFalse(receiver.TryReceive(received));
+				Assert::IsTrue(receiver.GetUsedBytes() == 0);
+			}
+
+			TEST_METHOD(TestFullRingRejectsSend)
+			{
+				Boring32::Async::SharedMemoryChannel channel(
+					L"SharedMemoryChannel-TestFullRingRejectsSend",
+					64,
+					Boring32::Async::SharedMemoryChannel::Mode::SingleProducer,
+					false
+				);
+				const std::vector<std::byte> message(channel.GetMaxMessageSize());
+				Assert::IsTrue(channel.TrySend(message));
+				Assert::IsFalse(channel.TrySend(std::span<const std::byte>()));
+				Assert::IsTrue(channel.TryConsume([](std::span<const std::byte>) {}));
+				Assert::IsTrue(channel.TrySend(std::span<const std::byte>()));
+			}
+
+			TEST_METHOD(TestReceiveTimesOut)
+			{
+				Boring32::Async::SharedMemoryChannel channel(
+					L"SharedMemoryChannel-TestReceiveTimesOut",
+					64,
+					Boring32::Async::SharedMemoryChannel::Mode::SingleProducer,
+					false
+				);
+				std::vector<std::byte> received;
+				Assert::IsFalse(channel.Receive(received, 50));
+			}
+
+			TEST_METHOD(TestMaxSizeMessageWrapsToBlockedReceiver)
+			{
+				Boring32::Async::SharedMemoryChannel receiver(
+					L"SharedMemoryChannel-TestMaxSizeMessageWrapsToBlockedReceiver",
+					256,
+					Boring32::Async::SharedMemoryChannel::Mode::SingleProducer,
+					false
+				);
+				Boring32::Async::SharedMemoryChannel sender(receiver.GetName(), 256, false);
+
+				// Moves the positions off the start of the ring, so the next
+				// record needs padding and only fits once that is freed.
+				std::vector<std::byte> received;
+				Assert::IsTrue(sender.TrySend(std::vector<std::byte>(8)));
+				Assert::IsTrue(receiver.TryReceive(received));
+
+				bool isReceived = false;
+				std::thread receiverThread(
+					[&receiver, &received, &isReceived]
+					{
+						isReceived = receiver.Receive(received, 5000);
+					}
+				);
+				Sleep(50);
+				const std::vector<std::byte> sent(sender.GetMaxMessageSize(), std::byte{ 0x42 });
+				const bool isSent = sender.Send(sent, 5000);
+				receiverThread.join();
+				Assert::IsTrue(isSent);
+				Assert::IsTrue(isReceived);
+				Assert::IsTrue(received == sent);
+			}
+
+			TEST_METHOD(TestMultipleSendersWrapAround)
+			{
+				Boring32::Async::SharedMemoryChannel receiver(
+					L"SharedMemoryChannel-TestMultipleSendersWrapAround",
+					256,
+					Boring32::Async::SharedMemoryChannel::Mode::MultiProducer,
+					false
+				);
+				const uint32_t senderCount = 4;
+				const uint32_t messageCount = 5000;
+				std::vector<std::thread> senders;
+				for (uint32_t i = 0; i < senderCount; i++)
+				{
+					senders.emplace_back(
+						[&receiver, i]
+						{
+							Boring32::Async::SharedMemoryChannel sender(receiver.GetName(), 256, false);
+							for (uint32_t n = 0; n < messageCount; n++)
+							{
+								// Varying lengths force padding at the end of the ring.
+								std::vector<std::byte> message(8 + n % 40);
+								std::memcpy(message.data(), &i, sizeof(i));
+								std::memcpy(message.data() + 4, &n, sizeof(n));
+								sender.Send(message, INFINITE);
+							}
+						}
+					);
+				}
+
+				std::vector<uint32_t> expected(senderCount, 0);
+				std::vector<std::byte> received;
+				for (uint32_t i = 0; i < senderCount * messageCount; i++)
+				{
+					Assert::IsTrue(receiver.Receive(received, 5000));
+					uint32_t sender = 0;
+					uint32_t sequence = 0;
+					std::memcpy(&sender, received.data(), sizeof(sender));
+					std::memcpy(&sequence, received.data() + 4, sizeof(sequence));
+					Assert::IsTrue(sequence == expected[sender]);
+					Assert::IsTrue(received.size() == 8 + sequence % 40);
+					expected[sender]++;
+				}
+				for (std::thread& sender : senders)
+					sender.join();
+			}
+	};
+}
\ No newline at end of file
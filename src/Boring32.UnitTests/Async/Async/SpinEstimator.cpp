@@ -0,0 +1,50 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Boring32/include/Async/SpinEstimator.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(SpinEstimator)
+	{
+		public:
+			TEST_METHOD(TestLimitIsCapped)
+			{
+				Boring32::Async::SpinEstimator estimator(100);
+				Assert::IsTrue(estimator.GetLimit() == Boring32::Async::SpinEstimator::MinSpins);
+				for (int i = 0; i < 100; i++)
+					estimator.Succeeded(1000);
+				Assert::IsTrue(estimator.GetLimit() == 100);
+
+				Boring32::Async::SpinEstimator none(0);
+				Assert::IsTrue(none.GetLimit() == 0);
+			}
+
+			TEST_METHOD(TestEstimateTracksSamples)
+			{
+				Boring32::Async::SpinEstimator estimator(4000);
+				for (int i = 0; i < 100; i++)
+					estimator.Succeeded(400);
+				Assert::IsTrue(estimator.GetEstimate() > 350);
+				Assert::IsTrue(estimator.GetEstimate() <= 400);
+
+				for (int i = 0; i < 100; i++)
+					estimator.Succeeded(0);
+				Assert::IsTrue(estimator.GetEstimate() < 10);
+			}
+
+			TEST_METHOD(TestFailureLowersEstimate)
+			{
+				Boring32::Async::SpinEstimator estimator(4000);
+				for (int i = 0; i < 100; i++)
+					estimator.Succeeded(400);
+				const uint32_t before = estimator.GetEstimate();
+				estimator.Failed();
+				Assert::IsTrue(estimator.GetEstimate() < before);
+				for (int i = 0; i < 100; i++)
+					estimator.Failed();
+				Assert::IsTrue(estimator.GetLimit() < Boring32::Async::SpinEstimator::MinSpins * 2);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include <vector>
+#include "Boring32/include/Async/TaskPool.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(TaskPool)
+	{
+		public:
+			TEST_METHOD(TestSubmitReturnsValue)
+			{
+				Boring32::Async::TaskPool pool(2);
+				Boring32::Async::TaskFuture<int> future = pool.Submit([] { return 42; });
+				Assert::IsTrue(future.Get() == 42);
+			}
+
+			TEST_METHOD(TestSubmitMoveOnly)
+			{
+				Boring32::Async::TaskPool pool(2);
+				auto value = std::make_unique<int>(7);
+				auto future = pool.Submit([value = std::move(value)] { return *value; });
+				Assert::IsTrue(future.Get() == 7);
+			}
+
+			TEST_METHOD(TestSubmitRethrows)
+			{
+				Boring32::Async::TaskPool pool(1);
+				auto future = pool.Submit([] { throw std::runtime_error("fail"); });
+				Assert::ExpectException<std::runtime_error>(
+					[&future]()
+					{
+						future.Get();
+					});
+			}
+
+			TEST_METHOD(TestManyTasks)
+			{
+				std::atomic<int> count = 0;
+				Boring32::Async::TaskPool pool(4);
+				std::vector<Boring32::Async::TaskFuture<void>> futures;
+				for (int i = 0; i < 10000; i++)
+					futures.push_back(pool.Submit([&count] { count++; }));
+				for (auto& future : futures)
+					future.Get();
+				Assert::IsTrue(count == 10000);
+			}
+
+			TEST_METHOD(TestNestedSubmit)
+			{
+				Boring32::Async::TaskPool pool(2);
+				auto future = pool.Submit(
+					[&pool]
+					{
+						return pool.Submit([] { return 3; }).Get() * 2;
+					});
+				Assert::IsTrue(future.Get() == 6);
+			}
+
+			TEST_METHOD(TestCloseDrainsPostedTasks)
+			{
+				std::atomic<int> count = 0;
+				Boring32::Async::TaskPool pool(2);
+				for (int i = 0; i < 100; i++)
+					pool.Post([&count] { count++; });
+				pool.Close();
+				Assert::IsTrue(count == 100);
+			}
+
+			TEST_METHOD(TestPostAfterCloseThrows)
+			{
+				Boring32::Async::TaskPool pool(1);
+				pool.Close();
+				Assert::ExpectException<std::runtime_error>(
+					[&pool]()
+					{
+						pool.Post([] {});
+					});
+			}
+
+			TEST_METHOD(TestParallelFor)
+			{
+				std::vector<std::atomic<int>> hits(1000);
+				Boring32::Async::TaskPool pool(4);
+				pool.ParallelFor(
+					hits.size(),
+					[&hits](const size_t slot, const size_t index)
+					{
+						hits[index]++;
+					});
+				for (const std::atomic<int>& hit : hits)
+					Assert::IsTrue(hit == 1);
+			}
+
+			TEST_METHOD(TestParallelForRethrows)
+			{
+				Boring32::Async::TaskPool pool(2);
+				Assert::ExpectException<std::runtime_error>(
+					[&pool]()
+					{
+						pool.ParallelFor(
+							100,
+							[](const size_t slot, const size_t index)
+							{
+								if (index == 50)
+									throw std::runtime_error("failed");
+							});
+					});
+			}
+	};
+}
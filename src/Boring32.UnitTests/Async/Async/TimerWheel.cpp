@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include <atomic>
+#include "Boring32/include/Async/Event.hpp"
+#include "Boring32/include/Async/TaskPool.hpp"
+#include "Boring32/include/Async/TimerWheel.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Async
+{
+	TEST_CLASS(TimerWheel)
+	{
+		public:
+			TEST_METHOD(TestFire)
+			{
+				Boring32::Async::Event fired(false, true, false);
+				Boring32::Async::TaskPool pool(1);
+				Boring32::Async::TimerWheel wheel(pool, 1);
+
+				const ULONGLONG start = GetTickCount64();
+				wheel.Schedule(50, [&fired]() { fired.Signal(); });
+				Assert::IsTrue(wheel.Size() == 1);
+				Assert::IsTrue(fired.WaitOnEvent(5000, false));
+				Assert::IsTrue(GetTickCount64() - start >= 40);
+				Assert::IsTrue(wheel.Size() == 0);
+			}
+
+			TEST_METHOD(TestCancel)
+			{
+				std::atomic<int> fired = 0;
+				Boring32::Async::TaskPool pool(1);
+				Boring32::Async::TimerWheel wheel(pool, 1);
+
+				const Boring32::Async::TimerWheel::TimerId id = wheel.Schedule(50, [&fired]() { fired++; });
+				Assert::IsTrue(wheel.Cancel(id));
+				Assert::IsFalse(wheel.Cancel(id));
+				Assert::IsTrue(wheel.Size() == 0);
+				Sleep(150);
+				Assert::IsTrue(fired == 0);
+			}
+
+			TEST_METHOD(TestReschedule)
+			{
+				Boring32::Async::Event fired(false, true, false);
+				Boring32::Async::TaskPool pool(1);
+				Boring32::Async::TimerWheel wheel(pool, 1);
+
+				const Boring32::Async::TimerWheel::TimerId id = wheel.Schedule(60000, [&fired]() { fired.Signal(); });
+				Assert::IsTrue(wheel.Reschedule(id, 10));
+				Assert::IsTrue(fired.WaitOnEvent(5000, false));
+				Assert::IsFalse(wheel.Reschedule(id, 10));
+			}
+
+			TEST_METHOD(TestManyTimers)
+			{
+				constexpr int count = 10000;
+				std::atomic<int> fired = 0;
+				Boring32::Async::Event done(false, true, false);
+				Boring32::Async::TaskPool pool(2);
+				Boring32::Async::TimerWheel wheel(pool, 1);
+
+				for (int i = 0; i < count; i++)
+				{
+					const Boring32::Async::TimerWheel::TimerId id = wheel.Schedule(
+						100 + i % 300,
+						[&fired, &done]() {
+							if (++fired == count / 2)
+								done.Signal();
+						}
+					);
+					if (i % 2)
+						wheel.Cancel(id);
+				}
+				Assert::IsTrue(done.WaitOnEvent(5000, false));
+				Assert::IsTrue(wheel.Size() == 0);
+			}
+	};
+}
\ No newline at end of file
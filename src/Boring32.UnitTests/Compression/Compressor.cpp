@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "CppUnitTest.h"
 #include "Boring32/include/Compression/Compressor.hpp"
+#include "Boring32/include/Compression/Decompressor.hpp"
+#include "TestInput.hpp"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -42,5 +44,43 @@ namespace Compression
 				);
 				Assert::IsTrue(compressed.size() > 0);
 			}
+
+			TEST_METHOD(TestCompressorCompressionIntoSpan)
+			{
+				Boring32::Compression::Compressor compressor(Boring32::Compression::CompressionType::MSZIP);
+				const std::byte* buffer = (std::byte*)&m_compressionString[0];
+				std::vector<std::byte> out(compressor.GetCompressedBound(m_compressionString.size()));
+				const size_t written = compressor.CompressBuffer(
+					std::span(buffer, m_compressionString.size()),
+					out
+				);
+				Assert::IsTrue(written > 0);
+				Assert::IsTrue(written <= out.size());
+			}
+
+			TEST_METHOD(TestCompressorHeaderRoundTrip)
+			{
+				Boring32::Compression::Compressor compressor(Boring32::Compression::CompressionType::XPRESS);
+				Boring32::Compression::Decompressor decompressor(Boring32::Compression::CompressionType::XPRESS);
+				const std::byte* buffer = (std::byte*)&m_compressionString[0];
+				const std::vector<std::byte> compressed = compressor.CompressBufferWithHeader(
+					std::span(buffer, m_compressionString.size())
+				);
+				const std::vector<std::byte> decompressed = decompressor.DecompressBufferWithHeader(compressed);
+				Assert::IsTrue(decompressed.size() == m_compressionString.size());
+				Assert::IsTrue(memcmp(decompressed.data(), buffer, decompressed.size()) == 0);
+			}
+
+			TEST_METHOD(TestCompressorParallelRoundTrip)
+			{
+				const std::vector<std::byte> input = CreateInput(100000);
+				Boring32::Async::TaskPool pool(4);
+				Boring32::Compression::Compressor compressor(Boring32::Compression::CompressionType::XPRESS);
+				Boring32::Compression::Decompressor decompressor(Boring32::Compression::CompressionType::XPRESS);
+
+				const std::vector<std::byte> frames = compressor.CompressBufferParallel(input, 4096, pool);
+				const std::vector<std::byte> output = decompressor.DecompressBufferParallel(frames, pool);
+				Assert::IsTrue(output == input);
+			}
 	};
 }
\ No newline at end of file
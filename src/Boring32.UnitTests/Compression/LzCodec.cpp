@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Boring32/include/Compression/LzCodec.hpp"
+#include "Boring32/include/Compression/Compressor.hpp"
+#include "Boring32/include/Compression/Decompressor.hpp"
+#include "TestInput.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Compression
+{
+	TEST_CLASS(LzCodec)
+	{
+		public:
+			TEST_METHOD(TestLzCodecRoundTrip)
+			{
+				const std::vector<std::byte> input = CreateInput(100000);
+				Boring32::Compression::Compressor compressor(Boring32::Compression::CompressionType::PortableLZ);
+				Boring32::Compression::Decompressor decompressor(Boring32::Compression::CompressionType::PortableLZ);
+
+				const std::vector<std::byte> compressed = compressor.CompressBufferWithHeader(input);
+				Assert::IsTrue(compressed.size() < input.size());
+				const std::vector<std::byte> output = decompressor.DecompressBufferWithHeader(compressed);
+				Assert::IsTrue(output == input);
+
+				decompressor.Close();
+				Assert::IsTrue(decompressor.GetType() == Boring32::Compression::CompressionType::NotSet);
+			}
+
+			TEST_METHOD(TestLzCodecCompressedSize)
+			{
+				const std::vector<std::byte> input = CreateInput(100000);
+				Boring32::Compression::Compressor compressor(Boring32::Compression::CompressionType::PortableLZ);
+				const size_t compressedSize = compressor.GetCompressedSize(input);
+				Assert::IsTrue(compressedSize == compressor.CompressBuffer(input).size());
+				Assert::IsTrue(compressedSize < compressor.GetCompressedBound(input.size()));
+			}
+
+			TEST_METHOD(TestLzCodecIncompressibleRoundTrip)
+			{
+				std::vector<std::byte> input(5000);
+				uint32_t state = 1;
+				for (std::byte& value : input)
+				{
+					state = state * 1103515245 + 12345;
+					value = static_cast<std::byte>(state >> 24);
+				}
+				Boring32::Compression::LzCodec codec;
+				std::vector<std::byte> compressed(codec.GetCompressedBound(input.size()));
+				size_t written = 0;
+				Assert::IsTrue(codec.TryCompress(input, compressed, written));
+				Assert::IsTrue(written <= compressed.size());
+
+				std::vector<std::byte> output(input.size());
+				size_t decompressed = 0;
+				Assert::IsTrue(codec.TryDecompress(std::span(compressed).first(written), output, decompressed));
+				Assert::IsTrue(decompressed == input.size());
+				Assert::IsTrue(output == input);
+			}
+
+			TEST_METHOD(TestLzCodecRejectsCorruptData)
+			{
+				const std::string text = "abcabcabcabcabcabcabcabcabcabcabcabc";
+				Boring32::Compression::LzCodec codec;
+				std::vector<std::byte> compressed(codec.GetCompressedBound(text.size()));
+				size_t written = 0;
+				Assert::IsTrue(codec.TryCompress(std::as_bytes(std::span(text)), compressed, written));
+				compressed.resize(written - 1);
+
+				std::vector<std::byte> output(text.size());
+				size_t decompressed = 0;
+				Assert::ExpectException<std::invalid_argument>(
+					[&codec, &compressed, &output, &decompressed]
+					{
+						codec.TryDecompress(compressed, output, decompressed);
+					}
+				);
+			}
+
+			TEST_METHOD(TestLzCodecParallelRoundTrip)
+			{
+				std::vector<std::byte> input(100000);
+				for (size_t i = 0; i < input.size(); i++)
+					input[i] = static_cast<std::byte>((i / 7) % 13);
+				Boring32::Async::TaskPool pool(4);
+				Boring32::Compression::Compressor compressor(std::make_unique<Boring32::Compression::LzCodec>());
+				Boring32::Compression::Decompressor decompressor(std::make_unique<Boring32::Compression::LzCodec>());
+
+				const std::vector<std::byte> frames = compressor.CompressBufferParallel(input, 4096, pool);
+				const std::vector<std::byte> output = decompressor.DecompressBufferParallel(frames, pool);
+				Assert::IsTrue(output == input);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Boring32/include/Compression/StreamCompressor.hpp"
+#include "Boring32/include/Compression/StreamDecompressor.hpp"
+#include "TestInput.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Compression
+{
+	TEST_CLASS(StreamCompressor)
+	{
+		public:
+			TEST_METHOD(TestRoundTrip)
+			{
+				const std::vector<std::byte> input = CreateInput(100000);
+				Boring32::Compression::StreamCompressor compressor(
+					Boring32::Compression::CompressionType::XPRESS, 
+					4096
+				);
+				std::vector<std::byte> stream;
+				std::vector<std::byte> frame;
+				for (size_t offset = 0; offset < input.size(); offset += 3000)
+				{
+					const size_t count = input.size() - offset < 3000 ? input.size() - offset : 3000;
+					compressor.Write(std::span(input).subspan(offset, count));
+				}
+				compressor.Flush();
+				while (compressor.Read(frame))
+					stream.insert(stream.end(), frame.begin(), frame.end());
+				Assert::IsTrue(compressor.GetFrameIndex().size() == (input.size() + 4095) / 4096);
+
+				Boring32::Compression::StreamDecompressor decompressor(Boring32::Compression::CompressionType::XPRESS);
+				std::vector<std::byte> output;
+				std::vector<std::byte> block;
+				for (size_t offset = 0; offset < stream.size(); offset += 1000)
+				{
+					const size_t count = stream.size() - offset < 1000 ? stream.size() - offset : 1000;
+					decompressor.Write(std::span(stream).subspan(offset, count));
+					while (decompressor.Read(block))
+						output.insert(output.end(), block.begin(), block.end());
+				}
+				Assert::IsTrue(output == input);
+				Assert::IsTrue(decompressor.GetBufferedSize() == 0);
+			}
+
+			TEST_METHOD(TestDefaultBlockSize)
+			{
+				const std::vector<std::byte> input = CreateInput(
+					Boring32::Compression::StreamCompressor::DefaultBlockSize + 1000
+				);
+				Boring32::Compression::StreamCompressor compressor(Boring32::Compression::CompressionType::XPRESS);
+				compressor.Write(input);
+				compressor.Flush();
+				Assert::IsTrue(compressor.GetFrameIndex().size() == 2);
+				Assert::IsTrue(compressor.GetFrameIndex().at(0).OriginalSize == Boring32::Compression::StreamCompressor::DefaultBlockSize);
+			}
+
+			TEST_METHOD(TestRandomAccess)
+			{
+				const std::vector<std::byte> input = CreateInput(50000);
+				Boring32::Compression::StreamCompressor compressor(
+					Boring32::Compression::CompressionType::XPRESS,
+					4096
+				);
+				compressor.Write(input);
+				compressor.Flush();
+				std::vector<std::byte> stream;
+				std::vector<std::byte> frame;
+				while (compressor.Read(frame))
+					stream.insert(stream.end(), frame.begin(), frame.end());
+
+				Boring32::Compression::StreamDecompressor decompressor(Boring32::Compression::CompressionType::XPRESS);
+				const auto& location = compressor.GetFrameIndex().at(5);
+				const std::vector<std::byte> block = decompressor.DecompressFrame(
+					std::span(stream).subspan(location.CompressedOffset, location.CompressedSize)
+				);
+				Assert::IsTrue(block.size() == location.OriginalSize);
+				Assert::IsTrue(std::equal(block.begin(), block.end(), input.begin() + location.OriginalOffset));
+			}
+	};
+}
\ No newline at end of file
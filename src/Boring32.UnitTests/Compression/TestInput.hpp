@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace Compression
+{
+	// Deterministic, moderately compressible input for the compression tests.
+	inline std::vector<std::byte> CreateInput(const size_t size)
+	{
+		std::vector<std::byte> input(size);
+		for (size_t i = 0; i < size; i++)
+			input[i] = static_cast<std::byte>((i * 31) % 251);
+		return input;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include "SpinEstimator.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		An intra-process mutex that is acquired and released with a single
+	///		atomic operation when uncontended. A thread that finds it locked
+	///		spins briefly, on the basis that most critical sections are short,
+	///		and then parks with WaitOnAddress(). The spin limit adapts to how
+	///		long recent acquisitions took to succeed. Unlike Mutex, this cannot
+	///		be shared with other processes, named, or waited on with WaitFor(),
+	///		and is not recursive. Meets the Lockable requirements, so it can be
+	///		used with std::lock_guard and std::unique_lock.
+	/// </summary>
+	class AdaptiveMutex
+	{
+		public:
+			/// <summary>
+			///		The default upper bound on spin iterations before parking.
+			/// </summary>
+			static constexpr uint32_t DefaultMaxSpins = 4000;
+
+		public:
+			virtual ~AdaptiveMutex();
+			AdaptiveMutex();
+
+			/// <param name="maxSpins">
+			///		The upper bound on spin iterations before parking. Pass 0
+			///		to park immediately, which suits single-processor machines.
+			/// </param>
+			AdaptiveMutex(const uint32_t maxSpins);
+
+		// Non-copyable, non-movable: waiters park on the address of m_state
+		public:
+			AdaptiveMutex(const AdaptiveMutex&) = delete;
+			virtual AdaptiveMutex& operator=(const AdaptiveMutex&) = delete;
+			AdaptiveMutex(AdaptiveMutex&&) noexcept = delete;
+			virtual AdaptiveMutex& operator=(AdaptiveMutex&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Blocks the current thread for a specified amount of time
+			///		(or indefinitely) until the mutex is acquired.
+			/// </summary>
+			/// <param name="waitTime">
+			///		The time in milliseconds to wait to acquire the mutex.
+			///		Pass INFINITE to wait indefinitely.
+			/// </param>
+			/// <returns>
+			///		Returns true if the mutex was acquired, or false if the
+			///		timeout occurred.
+			/// </returns>
+			/// <exception cref="Error::Win32Error">
+			///		Thrown if parking the thread failed.
+			/// </exception>
+			virtual bool Lock(const DWORD waitTime);
+
+			/// <summary>
+			///		Acquires the mutex if it is free, without spinning or
+			///		blocking.
+			/// </summary>
+			virtual bool TryLock() noexcept;
+
+			/// <summary>
+			///		Frees the mutex, waking one parked thread if there are any.
+			/// </summary>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the mutex is not locked.
+			/// </exception>
+			virtual void Unlock();
+
+			virtual bool IsLocked() const noexcept;
+
+		public:
+			// Lowercase forms for the standard Lockable requirements.
+			void lock()
+			{
+				Lock(INFINITE);
+			}
+
+			bool try_lock() noexcept
+			{
+				return TryLock();
+			}
+
+			void unlock()
+			{
+				Unlock();
+			}
+
+		protected:
+			virtual bool Spin() noexcept;
+			virtual bool Park(const DWORD waitTime);
+
+		protected:
+			enum State : uint32_t
+			{
+				Unlocked = 0,
+				Locked = 1,
+				// Locked, and threads may be parked waiting for it.
+				Contended = 2
+			};
+			std::atomic<uint32_t> m_state;
+			SpinEstimator m_spins;
+	};
+}
\ No newline at end of file
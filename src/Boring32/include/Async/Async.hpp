@@ -2,21 +2,41 @@
 #include "ProcessInfo.hpp"
 #include "Pipes/Pipes.hpp"
 #include "MemoryMappedFile.hpp"
+#include "MemoryMappedWindow.hpp"
 #include "MemoryMappedView.hpp"
 #include "Mutex.hpp"
+#include "SpinEstimator.hpp"
+#include "AdaptiveMutex.hpp"
 #include "Event.hpp"
+#include "LightweightEvent.hpp"
 #include "Process.hpp"
 #include "Thread.hpp"
 #include "Job.hpp"
 #include "Semaphore.hpp"
+#include "LightweightSemaphore.hpp"
 #include "WaitableTimer.hpp"
 #include "SlimReadWriteLock.hpp"
+#include "ReaderBiasedLock.hpp"
+#include "ReadWriteLockGuard.hpp"
 #include "ThreadSafeVector.hpp"
+#include "Channel.hpp"
 #include "CriticalSectionLock.hpp"
 #include "TimerQueue.hpp"
 #include "TimerQueueTimer.hpp"
 #include "TimerQueueTimerCallback.hpp"
+#include "TimerWheel.hpp"
 #include "SynchronizationBarrier.hpp"
+#include "PhaseBarrier.hpp"
 #include "ThreadPool.hpp"
+#include "TaskPool.hpp"
 #include "EventLoop.hpp"
+#include "ShardedEventLoop.hpp"
+#include "IoOperationPool.hpp"
+#include "SharedMemoryChannel.hpp"
+#include "OffsetPtr.hpp"
+#include "SharedMemoryArena.hpp"
+#include "SharedVector.hpp"
+#include "SharedHashMap.hpp"
+#include "SeqLockView.hpp"
+#include "LockProfiler.hpp"
 #include "AsyncFuncs.hpp"
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include <atomic>
+#include <cstdint>
 #include <windows.h>
 
 namespace Boring32::Async
@@ -74,4 +76,40 @@ namespace Boring32::Async
 		const int sessionIdToMatch,
 		DWORD& outResult
 	);
+
+	/// <summary>
+	///		Blocks the calling thread until the value at the specified 
+	///		address no longer equals undesiredValue and the thread is woken
+	///		by WakeOneWaiter() or WakeAllWaiters(), or the timeout elapses.
+	///		No kernel object is involved, so this is suitable for parking 
+	///		threads in user-mode synchronisation primitives. Spurious 
+	///		wakes are possible, so callers must recheck their condition.
+	/// </summary>
+	/// <param name="value">
+	///		The value to wait on.
+	/// </param>
+	/// <param name="undesiredValue">
+	///		The wait returns immediately if value does not equal this.
+	/// </param>
+	/// <param name="timeout">
+	///		The period in milliseconds to wait, or INFINITE.
+	/// </param>
+	/// <returns>
+	///		False if the timeout elapsed, true otherwise.
+	/// </returns>
+	bool WaitOnValue(
+		std::atomic<uint32_t>& value, 
+		const uint32_t undesiredValue,
+		const DWORD timeout
+	);
+
+	/// <summary>
+	///		Wakes one thread blocked in WaitOnValue() on the specified value.
+	/// </summary>
+	void WakeOneWaiter(std::atomic<uint32_t>& value) noexcept;
+
+	/// <summary>
+	///		Wakes all threads blocked in WaitOnValue() on the specified value.
+	/// </summary>
+	void WakeAllWaiters(std::atomic<uint32_t>& value) noexcept;
 }
@@ -0,0 +1,436 @@
+#pragma once
+#include <atomic>
+#include <concepts>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <Windows.h>
+#include "AsyncFuncs.hpp"
+#include "Event.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A bounded, lock-free, multi-producer multi-consumer queue, based
+	///		on Dmitry Vyukov's bounded MPMC ring: each slot carries a sequence
+	///		number that tells producers and consumers whether it is free or
+	///		full, so sends and receives only contend on a single CAS. Batch
+	///		operations claim a run of slots with one CAS.
+	///		Unlike ThreadSafeVector, no lock is held while the caller's code
+	///		runs, and the optional waitable handle is only signalled when the
+	///		channel goes from empty to non-empty, rather than once per item.
+	///		T's move constructor must not throw, as a batch that failed
+	///		partway would leave claimed slots that are never published.
+	/// </summary>
+	template<typename T>
+	requires std::is_nothrow_move_constructible_v<T>
+	class Channel
+	{
+		public:
+			static constexpr size_t CacheLineSize = 64;
+
+		public:
+			virtual ~Channel()
+			{
+				Close();
+			}
+
+			/// <summary>
+			///		Creates a channel.
+			/// </summary>
+			/// <param name="capacity">
+			///		The maximum number of items; must be a power of two.
+			/// </param>
+			/// <param name="createWaitableHandle">
+			///		Whether to create an auto-reset Event that is signalled on
+			///		every empty to non-empty transition, for use with WaitFor()
+			///		or EventLoop. A consumer woken by this handle must keep
+			///		receiving until TryReceive() returns false. If false, no
+			///		kernel object is created and the channel can only be waited
+			///		on with Receive().
+			/// </param>
+			Channel(const size_t capacity, const bool createWaitableHandle)
+			:	m_mask(capacity - 1),
+				m_enqueuePosition(0),
+				m_dequeuePosition(0),
+				m_count(0),
+				m_notEmptySignal(0),
+				m_notEmptyWaiters(0),
+				m_notFullSignal(0),
+				m_notFullWaiters(0)
+			{
+				if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+					throw std::invalid_argument(__FUNCSIG__ ": capacity must be a power of two greater than 1");
+				m_slots = std::make_unique<Slot[]>(capacity);
+				for (size_t i = 0; i < capacity; i++)
+					m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+				if (createWaitableHandle)
+					m_notEmpty = Event(false, false, false, L"");
+			}
+
+		// Non-copyable, non-movable
+		public:
+			Channel(const Channel&) = delete;
+			virtual Channel& operator=(const Channel&) = delete;
+			Channel(Channel&&) noexcept = delete;
+			virtual Channel& operator=(Channel&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Destroys any items still in the channel. Must not race with
+			///		other operations; once closed, sending or receiving throws.
+			/// </summary>
+			virtual void Close()
+			{
+				if (m_slots == nullptr)
+					return;
+				size_t position = m_dequeuePosition.load(std::memory_order_acquire);
+				const size_t end = m_enqueuePosition.load(std::memory_order_acquire);
+				for (; position != end; position++)
+				{
+					Slot& slot = m_slots[position & m_mask];
+					if (slot.Sequence.load(std::memory_order_acquire) == position + 1)
+						std::launder(reinterpret_cast<T*>(slot.Storage))->~T();
+				}
+				m_slots = nullptr;
+			}
+
+			/// <summary>
+			///		Attempts to enqueue an item without blocking.
+			/// </summary>
+			/// <returns>True if the item was enqueued, false if the channel is full.</returns>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the channel has been closed.
+			/// </exception>
+			virtual bool TrySend(T&& item)
+			{
+				if (m_slots == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": channel is closed");
+				size_t position = 0;
+				if (ClaimEnqueue(1, position) == 0)
+					return false;
+				Slot& slot = m_slots[position & m_mask];
+				new (slot.Storage) T(std::move(item));
+				slot.Sequence.store(position + 1, std::memory_order_release);
+				OnEnqueued(1);
+				return true;
+			}
+
+			/// <summary>
+			///		Attempts to enqueue a copy of an item without blocking.
+			/// </summary>
+			/// <returns>True if the item was enqueued, false if the channel is full.</returns>
+			/// <exception cref="std::logic_error">
+			///		Thrown if T can't be copied. Virtual functions can't be
+			///		constrained, so this is only caught at run time.
+			/// </exception>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the channel has been closed.
+			/// </exception>
+			virtual bool TrySend(const T& item)
+			{
+				if constexpr (std::copy_constructible<T>)
+				{
+					T copy(item);
+					return TrySend(std::move(copy));
+				}
+				else
+				{
+					throw std::logic_error(__FUNCSIG__ ": T is not copy constructible");
+				}
+			}
+
+			/// <summary>
+			///		Enqueues as many items from the front of the span as there
+			///		is room for, moving them into the channel, and notifies
+			///		waiters once for the whole batch.
+			/// </summary>
+			/// <returns>The number of items enqueued.</returns>
+			virtual size_t TrySendBatch(std::span<T> items)
+			{
+				if (m_slots == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": channel is closed");
+				size_t sent = 0;
+				while (sent < items.size())
+				{
+					size_t position = 0;
+					const size_t claimed = ClaimEnqueue(items.size() - sent, position);
+					if (claimed == 0)
+						break;
+					for (size_t i = 0; i < claimed; i++)
+					{
+						Slot& slot = m_slots[(position + i) & m_mask];
+						new (slot.Storage) T(std::move(items[sent + i]));
+						slot.Sequence.store(position + i + 1, std::memory_order_release);
+					}
+					sent += claimed;
+				}
+				if (sent > 0)
+					OnEnqueued(sent);
+				return sent;
+			}
+
+			/// <summary>
+			///		Enqueues an item, blocking while the channel is full.
+			/// </summary>
+			/// <param name="millis">
+			///		The period in milliseconds to wait, or INFINITE.
+			/// </param>
+			/// <returns>True if the item was enqueued, false if the timeout elapsed.</returns>
+			virtual bool Send(T&& item, const DWORD millis)
+			{
+				return BlockUntil(
+					[this, &item] { return TrySend(std::move(item)); },
+					m_notFullSignal,
+					m_notFullWaiters,
+					millis
+				);
+			}
+
+			/// <summary>
+			///		Attempts to dequeue an item without blocking.
+			/// </summary>
+			/// <returns>True if an item was dequeued, false if the channel is empty.</returns>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the channel has been closed.
+			/// </exception>
+			virtual bool TryReceive(T& item)
+			{
+				if (m_slots == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": channel is closed");
+				size_t position = 0;
+				if (ClaimDequeue(1, position) == 0)
+					return false;
+				item = ConsumeSlot(position);
+				OnDequeued(1);
+				return true;
+			}
+
+			/// <summary>
+			///		Dequeues up to maxItems items into the output iterator.
+			/// </summary>
+			/// <returns>The number of items dequeued.</returns>
+			template<typename OutputIterator>
+			size_t TryReceiveBatch(OutputIterator out, const size_t maxItems)
+			{
+				if (m_slots == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": channel is closed");
+				size_t received = 0;
+				while (received < maxItems)
+				{
+					size_t position = 0;
+					const size_t claimed = ClaimDequeue(maxItems - received, position);
+					if (claimed == 0)
+						break;
+					for (size_t i = 0; i < claimed; i++)
+						*out++ = ConsumeSlot(position + i);
+					received += claimed;
+				}
+				if (received > 0)
+					OnDequeued(received);
+				return received;
+			}
+
+			/// <summary>
+			///		Dequeues an item, blocking while the channel is empty.
+			///		The wait is on an atomic word, not a kernel object.
+			/// </summary>
+			/// <param name="millis">
+			///		The period in milliseconds to wait, or INFINITE.
+			/// </param>
+			/// <returns>True if an item was dequeued, false if the timeout elapsed.</returns>
+			virtual bool Receive(T& item, const DWORD millis)
+			{
+				return BlockUntil(
+					[this, &item] { return TryReceive(item); },
+					m_notEmptySignal,
+					m_notEmptyWaiters,
+					millis
+				);
+			}
+
+			/// <summary>
+			///		Returns the approximate number of items in the channel,
+			///		counting sends and receives that are still in progress.
+			/// </summary>
+			virtual size_t Size() const noexcept
+			{
+				// Loading the dequeue position first means the enqueue
+				// position, which never falls behind it, can't be smaller.
+				const size_t dequeued = m_dequeuePosition.load(std::memory_order_acquire);
+				const size_t enqueued = m_enqueuePosition.load(std::memory_order_acquire);
+				const size_t size = enqueued - dequeued;
+				return size > m_mask + 1 ? m_mask + 1 : size;
+			}
+
+			virtual size_t GetCapacity() const noexcept
+			{
+				return m_mask + 1;
+			}
+
+			/// <summary>
+			///		Returns the auto-reset Event signalled when the channel goes
+			///		from empty to non-empty, or nullptr if the channel was created
+			///		without one.
+			/// </summary>
+			virtual HANDLE GetWaitableHandle() const noexcept
+			{
+				return m_notEmpty.GetHandle();
+			}
+
+		protected:
+			struct Slot
+			{
+				std::atomic<size_t> Sequence;
+				alignas(T) std::byte Storage[sizeof(T)];
+			};
+
+			virtual size_t ClaimEnqueue(const size_t maxCount, size_t& position)
+			{
+				position = m_enqueuePosition.load(std::memory_order_relaxed);
+				while (true)
+				{
+					// Count the run of free slots starting at position; a slot
+					// is free for position p when its sequence equals p.
+					size_t available = 0;
+					while (available < maxCount)
+					{
+						const size_t current = position + available;
+						const size_t sequence = m_slots[current & m_mask].Sequence.load(std::memory_order_acquire);
+						if (sequence != current)
+							break;
+						available++;
+					}
+					if (available == 0)
+					{
+						const size_t sequence = m_slots[position & m_mask].Sequence.load(std::memory_order_acquire);
+						// Full: the slot still holds an item from the previous lap.
+						if (static_cast<intptr_t>(sequence - position) < 0)
+							return 0;
+						position = m_enqueuePosition.load(std::memory_order_relaxed);
+						continue;
+					}
+					if (m_enqueuePosition.compare_exchange_weak(position, position + available, std::memory_order_relaxed))
+						return available;
+				}
+			}
+
+			virtual size_t ClaimDequeue(const size_t maxCount, size_t& position)
+			{
+				position = m_dequeuePosition.load(std::memory_order_relaxed);
+				while (true)
+				{
+					// A slot is full for position p when its sequence equals p + 1.
+					size_t available = 0;
+					while (available < maxCount)
+					{
+						const size_t current = position + available;
+						const size_t sequence = m_slots[current & m_mask].Sequence.load(std::memory_order_acquire);
+						if (sequence != current + 1)
+							break;
+						available++;
+					}
+					if (available == 0)
+					{
+						const size_t sequence = m_slots[position & m_mask].Sequence.load(std::memory_order_acquire);
+						// Empty: the slot has not been written on this lap.
+						if (static_cast<intptr_t>(sequence - (position + 1)) < 0)
+							return 0;
+						position = m_dequeuePosition.load(std::memory_order_relaxed);
+						continue;
+					}
+					if (m_dequeuePosition.compare_exchange_weak(position, position + available, std::memory_order_relaxed))
+						return available;
+				}
+			}
+
+			virtual T ConsumeSlot(const size_t position)
+			{
+				Slot& slot = m_slots[position & m_mask];
+				T* stored = std::launder(reinterpret_cast<T*>(slot.Storage));
+				T item(std::move(*stored));
+				stored->~T();
+				// Frees the slot for the producer on the next lap.
+				slot.Sequence.store(position + m_mask + 1, std::memory_order_release);
+				return item;
+			}
+
+			virtual void OnEnqueued(const size_t count)
+			{
+				// Only the empty to non-empty transition touches the kernel.
+				if (m_count.fetch_add(count, std::memory_order_seq_cst) == 0 && m_notEmpty.GetHandle())
+					m_notEmpty.Signal();
+				Notify(m_notEmptySignal, m_notEmptyWaiters);
+			}
+
+			virtual void OnDequeued(const size_t count)
+			{
+				m_count.fetch_sub(count, std::memory_order_seq_cst);
+				Notify(m_notFullSignal, m_notFullWaiters);
+			}
+
+			virtual void Notify(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters) noexcept
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (waiters.load(std::memory_order_relaxed) == 0)
+					return;
+				signal.fetch_add(1, std::memory_order_seq_cst);
+				WakeAllWaiters(signal);
+			}
+
+			template<typename F>
+			bool BlockUntil(
+				const F& attempt,
+				std::atomic<uint32_t>& signal,
+				std::atomic<uint32_t>& waiters,
+				const DWORD millis
+			)
+			{
+				if (attempt())
+					return true;
+				const ULONGLONG deadline = millis == INFINITE ? 0 : GetTickCount64() + millis;
+				while (true)
+				{
+					const uint32_t observed = signal.load(std::memory_order_seq_cst);
+					waiters.fetch_add(1, std::memory_order_seq_cst);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					// Recheck after announcing ourselves; pairs with the
+					// fence in Notify() so a concurrent operation is never missed.
+					if (attempt())
+					{
+						waiters.fetch_sub(1, std::memory_order_seq_cst);
+						return true;
+					}
+					DWORD remaining = INFINITE;
+					if (millis != INFINITE)
+					{
+						const ULONGLONG now = GetTickCount64();
+						if (now >= deadline)
+						{
+							waiters.fetch_sub(1, std::memory_order_seq_cst);
+							return false;
+						}
+						remaining = static_cast<DWORD>(deadline - now);
+					}
+					WaitOnValue(signal, observed, remaining);
+					waiters.fetch_sub(1, std::memory_order_seq_cst);
+					if (attempt())
+						return true;
+				}
+			}
+
+		protected:
+			const size_t m_mask;
+			std::unique_ptr<Slot[]> m_slots;
+			alignas(CacheLineSize) std::atomic<size_t> m_enqueuePosition;
+			alignas(CacheLineSize) std::atomic<size_t> m_dequeuePosition;
+			alignas(CacheLineSize) std::atomic<size_t> m_count;
+			alignas(CacheLineSize) std::atomic<uint32_t> m_notEmptySignal;
+			std::atomic<uint32_t> m_notEmptyWaiters;
+			alignas(CacheLineSize) std::atomic<uint32_t> m_notFullSignal;
+			std::atomic<uint32_t> m_notFullWaiters;
+			Event m_notEmpty;
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <windows.h>
+#include <cstdint>
 
 namespace Boring32::Async
 {
@@ -17,5 +18,8 @@ namespace Boring32::Async
 
 		protected:
 			CRITICAL_SECTION& m_criticalSection;
+			// When the lock was acquired, if LockProfiler was enabled;
+			// otherwise 0.
+			uint64_t m_profiledAt;
 	};
 }
@@ -1,26 +1,107 @@
 #pragma once
 #include <Windows.h>
+#include <atomic>
 #include <vector>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include "Event.hpp"
 
 namespace Boring32::Async
 {
+	/// <summary>
+	///		Dispatches handlers when their associated handles are signalled.
+	///		On() and Erase() may be called from any thread, including from
+	///		inside a handler; they never wait for WaitOn() to return. Changes
+	///		are queued and applied by the waiting thread, which is woken
+	///		through an internal event. WaitOn() and WaitAndDrain() must only
+	///		be called from one thread at a time. The wake event takes one of
+	///		the MAXIMUM_WAIT_OBJECTS wait slots, so at most MaxHandles handles
+	///		can be registered; use ShardedEventLoop for more.
+	/// </summary>
 	class EventLoop
 	{
+		public:
+			/// <summary>
+			///		The maximum number of registered handles.
+			/// </summary>
+			static constexpr DWORD MaxHandles = MAXIMUM_WAIT_OBJECTS - 1;
+
 		public:
 			virtual ~EventLoop();
 			EventLoop();
 
 		public:
 			virtual void Close();
+
+			/// <summary>
+			///		Waits for one or all of the registered handles and runs
+			///		the corresponding handlers. Applies any queued changes
+			///		before waiting. A registration made while waiting for
+			///		any handle wakes the wait, which then resumes with the
+			///		remaining timeout.
+			/// </summary>
+			/// <returns>
+			///		False if the wait timed out or was ended by an APC.
+			/// </returns>
 			virtual bool WaitOn(const DWORD millis, const bool waitAll);
+
+			/// <summary>
+			///		Waits for any registered handle, then runs the handler of
+			///		every handle that is signalled at that point, not just the
+			///		first. Handles are scanned round-robin, starting after the
+			///		last handle dispatched by the previous call, so a busy
+			///		handle cannot starve the handles registered after it.
+			/// </summary>
+			/// <returns>
+			///		The number of handlers run; 0 if the wait timed out or was
+			///		ended by an APC.
+			/// </returns>
+			virtual size_t WaitAndDrain(const DWORD millis);
+
+			/// <summary>
+			///		Queues a handler for the handle. Takes effect on the next
+			///		wait.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the handle is null or already registered.
+			/// </exception>
+			/// <exception cref="std::length_error">
+			///		Thrown if MaxHandles handles are already registered.
+			/// </exception>
 			virtual void On(HANDLE handle, std::function<void()> handler);
+
+			/// <summary>
+			///		Queues the removal of the handle. Takes effect on the next
+			///		wait, so a handler already being dispatched may still run.
+			/// </summary>
 			virtual void Erase(HANDLE handle);
+
 			virtual size_t Size() noexcept;
 
 		protected:
+			struct Change
+			{
+				bool IsAdd = false;
+				HANDLE Handle = nullptr;
+				std::function<void()> Handler;
+			};
+
+			virtual void ApplyChanges();
+			virtual DWORD GetRemainingMillis(const DWORD millis, const ULONGLONG start) const noexcept;
+			virtual size_t DrainRange(const size_t begin, const size_t end);
+
+		protected:
+			// Owned by the waiting thread. Index 0 is m_wake.
 			std::vector<std::function<void()>> m_handlers;
 			std::vector<HANDLE> m_events;
+			std::unordered_map<HANDLE, size_t> m_slots;
+			size_t m_nextDispatch;
+			// Guards m_pending and m_registered.
 			CRITICAL_SECTION m_cs;
+			std::vector<Change> m_pending;
+			std::unordered_set<HANDLE> m_registered;
+			std::atomic<bool> m_hasPending;
+			Event m_wake;
 	};
 }
\ No newline at end of file
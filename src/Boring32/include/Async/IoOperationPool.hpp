@@ -0,0 +1,136 @@
+#pragma once
+#include <Windows.h>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		An overlapped operation with its own data buffer, handed out by an
+	///		IoOperationPool. The OVERLAPPED is the first member, so the
+	///		operation can be recovered from the pointer a completion port
+	///		returns with FromOverlapped().
+	/// </summary>
+	struct IoOperation
+	{
+		OVERLAPPED Overlapped{};
+		// Owned by the pool and reused across acquisitions.
+		std::byte* Buffer = nullptr;
+		DWORD Capacity = 0;
+		// The number of bytes requested when the operation was acquired.
+		DWORD Length = 0;
+		// Free for the caller's use; cleared on release.
+		ULONG_PTR Context = 0;
+		// Created the first time the operation is acquired as waitable and
+		// kept for later reuse.
+		HANDLE Event = nullptr;
+		bool IsPooled = true;
+		IoOperation* Next = nullptr;
+
+		std::span<std::byte> GetBuffer() const noexcept;
+		DWORD GetBytesTransferred() const noexcept;
+		bool IsComplete() const noexcept;
+		bool IsSuccessful() const noexcept;
+		bool IsPartial() const noexcept;
+
+		/// <summary>
+		///		Waits for the operation's event. Only valid for operations
+		///		acquired with AcquireWaitable().
+		/// </summary>
+		/// <returns>False if the timeout elapsed.</returns>
+		bool WaitForCompletion(const DWORD timeout) const;
+
+		static IoOperation* FromOverlapped(OVERLAPPED* overlapped) noexcept;
+	};
+
+	/// <summary>
+	///		A pool of reusable overlapped operations, each with a fixed-size
+	///		buffer allocated once with the pool. Acquiring and releasing an
+	///		operation doesn't allocate, and operations meant for completion
+	///		ports carry no event. Free operations are kept in one list per
+	///		processor, so threads rarely contend on the same list. Requests
+	///		larger than the buffer size get a one-off operation that is freed
+	///		on release.
+	/// </summary>
+	class IoOperationPool
+	{
+		public:
+			/// <summary>
+			///		The number of operations allocated at once when the pool
+			///		runs dry.
+			/// </summary>
+			static constexpr size_t GrowthCount = 64;
+
+		public:
+			/// <summary>
+			///		Frees all operations. Every acquired operation must have
+			///		been released and have no I/O outstanding.
+			/// </summary>
+			virtual ~IoOperationPool();
+
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if bufferSize is zero.
+			/// </exception>
+			IoOperationPool(const DWORD bufferSize, const size_t initialCount);
+
+		// Non-copyable, non-movable: operations are handed out by address
+		public:
+			IoOperationPool(const IoOperationPool&) = delete;
+			virtual IoOperationPool& operator=(const IoOperationPool&) = delete;
+			IoOperationPool(IoOperationPool&&) noexcept = delete;
+			virtual IoOperationPool& operator=(IoOperationPool&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Acquires a zeroed operation with no event, for use with
+			///		completion ports, whose buffer holds at least length bytes.
+			/// </summary>
+			virtual IoOperation* Acquire(const DWORD length);
+
+			/// <summary>
+			///		Acquires a zeroed operation whose OVERLAPPED has a manual
+			///		reset event, for callers that wait on the operation.
+			/// </summary>
+			/// <exception cref="Boring32::Error::Win32Error">
+			///		Thrown if the event could not be created.
+			/// </exception>
+			virtual IoOperation* AcquireWaitable(const DWORD length);
+
+			/// <summary>
+			///		Returns the operation to the pool. The operation must have
+			///		no I/O outstanding.
+			/// </summary>
+			virtual void Release(IoOperation* operation) noexcept;
+
+			virtual DWORD GetBufferSize() const noexcept;
+			virtual size_t GetAllocatedCount() noexcept;
+
+		protected:
+			struct alignas(64) FreeList
+			{
+				SRWLOCK Lock = SRWLOCK_INIT;
+				IoOperation* Head = nullptr;
+			};
+
+			struct Slab
+			{
+				std::unique_ptr<IoOperation[]> Operations;
+				std::unique_ptr<std::byte[]> Buffers;
+				size_t Count = 0;
+			};
+
+			virtual FreeList& GetLocalList() noexcept;
+			virtual IoOperation* Pop(FreeList& list) noexcept;
+			virtual void Push(FreeList& list, IoOperation* first, IoOperation* last) noexcept;
+			virtual IoOperation* Grow(const size_t count);
+			virtual void Prepare(IoOperation* operation, const DWORD length) noexcept;
+
+		protected:
+			DWORD m_bufferSize;
+			std::vector<FreeList> m_lists;
+			// Guards m_slabs.
+			SRWLOCK m_lock;
+			std::vector<Slab> m_slabs;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		An intra-process event whose state is an atomic word, so signalling
+	///		and resetting are atomic operations and waiting threads park with
+	///		WaitOnAddress() rather than on a kernel object. A kernel event is
+	///		only created the first time GetHandle() is called, for interop
+	///		with WaitFor() or EventLoop; from then on the kernel event holds
+	///		the state, and this behaves like Event. Unlike Event, this can't
+	///		be named or shared with other processes.
+	/// </summary>
+	class LightweightEvent
+	{
+		public:
+			virtual ~LightweightEvent();
+			LightweightEvent(const bool manualReset, const bool isSignaled);
+
+		// Non-copyable, non-movable: waiters park on the address of m_state
+		public:
+			LightweightEvent(const LightweightEvent&) = delete;
+			virtual LightweightEvent& operator=(const LightweightEvent&) = delete;
+			LightweightEvent(LightweightEvent&&) noexcept = delete;
+			virtual LightweightEvent& operator=(LightweightEvent&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Signals the event, releasing one waiter if it is
+			///		auto-reset, or all waiters if it is manual-reset.
+			/// </summary>
+			/// <exception cref="Error::Win32Error">
+			///		Thrown if the kernel event exists and could not be set.
+			/// </exception>
+			virtual void Signal();
+			virtual void Reset();
+
+			/// <summary>
+			///		Blocks until the event is signalled.
+			/// </summary>
+			virtual void WaitOnEvent();
+
+			/// <summary>
+			///		Blocks until the event is signalled or the timeout
+			///		elapses. Waiting on an auto-reset event consumes the
+			///		signal.
+			/// </summary>
+			/// <param name="millis">
+			///		The timeout in milliseconds, or INFINITE.
+			/// </param>
+			/// <returns>False if the timeout elapsed.</returns>
+			virtual bool WaitOnEvent(const DWORD millis);
+
+			/// <summary>
+			///		Gets the kernel event, creating it on the first call.
+			/// </summary>
+			/// <exception cref="Error::Win32Error">
+			///		Thrown if the kernel event could not be created.
+			/// </exception>
+			virtual HANDLE GetHandle();
+
+			/// <summary>
+			///		Gets the kernel event, creating it on the first call.
+			///		Returns nullptr if it could not be created.
+			/// </summary>
+			virtual HANDLE GetHandle(std::nothrow_t) noexcept;
+
+			virtual bool IsManualReset() const noexcept;
+
+		protected:
+			virtual bool WaitOnKernelEvent(const DWORD millis);
+
+		protected:
+			enum State : uint32_t
+			{
+				Signaled = 1,
+				// The kernel event exists and holds the state from now on.
+				KernelMode = 2
+			};
+			std::atomic<uint32_t> m_state;
+			std::atomic<uint32_t> m_waiters;
+			std::atomic<HANDLE> m_handle;
+			bool m_isManualReset;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "Onyx32/Async/ISemaphore.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		An intra-process counting semaphore. The count is an atomic word,
+	///		so acquiring an available count and releasing with no waiters are
+	///		single atomic operations; threads only park, with WaitOnAddress(),
+	///		when the count is exhausted. Unlike Semaphore, it has no name or
+	///		kernel handle, so it can't be shared with other processes or waited
+	///		on with WaitFor(); GetName() returns an empty string and
+	///		GetHandle() returns nullptr. GetCurrentCount() is exact.
+	/// </summary>
+	class LightweightSemaphore : public Onyx32::Core::Async::ISemaphore
+	{
+		public:
+			/// <summary>
+			///		The number of times an acquiring thread rechecks the count
+			///		before parking.
+			/// </summary>
+			static constexpr uint32_t SpinCount = 64;
+
+		public:
+			virtual ~LightweightSemaphore();
+
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if initialCount exceeds maxCount, or maxCount
+			///		exceeds LONG_MAX.
+			/// </exception>
+			LightweightSemaphore(const ULONG initialCount, const ULONG maxCount);
+
+		// Non-copyable, non-movable: waiters park on the address of m_count
+		public:
+			LightweightSemaphore(const LightweightSemaphore&) = delete;
+			virtual LightweightSemaphore& operator=(const LightweightSemaphore&) = delete;
+			LightweightSemaphore(LightweightSemaphore&&) noexcept = delete;
+			virtual LightweightSemaphore& operator=(LightweightSemaphore&&) noexcept = delete;
+
+		public:
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the release would exceed the maximum count.
+			/// </exception>
+			virtual void Release() override;
+			virtual void Release(const int countToRelease) override;
+
+			/// <summary>
+			///		Decrements the count, waiting up to millisTimeout for it to
+			///		become non-zero. Pass INFINITE to wait indefinitely.
+			/// </summary>
+			/// <returns>False if the timeout elapsed.</returns>
+			virtual bool Acquire(const DWORD millisTimeout) override;
+
+			/// <summary>
+			///		Decrements the count by countToAcquire at once, so a thread
+			///		never holds part of what it asked for while waiting.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if countToAcquire is not positive or exceeds the
+			///		maximum count.
+			/// </exception>
+			virtual bool Acquire(const int countToAcquire, const DWORD millisTimeout) override;
+
+			/// <summary>
+			///		Decrements the count only if it is available now.
+			/// </summary>
+			virtual bool TryAcquire(const int countToAcquire) noexcept;
+
+			virtual const std::wstring& GetName() const override;
+			virtual int GetCurrentCount() const override;
+			virtual int GetMaxCount() const override;
+			virtual HANDLE GetHandle() const override;
+			virtual void Free() override;
+
+		protected:
+			virtual bool Park(const uint32_t countToAcquire, const DWORD millisTimeout);
+
+		protected:
+			std::atomic<uint32_t> m_count;
+			std::atomic<uint32_t> m_waiters;
+			// Waiters that need more than one count. While there are any,
+			// releases wake every waiter, as waking one that can't proceed
+			// would strand the others.
+			std::atomic<uint32_t> m_bulkWaiters;
+			uint32_t m_maxCount;
+			std::wstring m_name;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+#include <Windows.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A snapshot of the contention recorded for one lock.
+	/// </summary>
+	struct LockProfile
+	{
+		static constexpr size_t HistogramBuckets = 32;
+
+		const void* Lock;
+		// The lock's type, e.g. L"Mutex".
+		std::wstring Kind;
+		// The lock's tag, or its name if it is a named Mutex.
+		std::wstring Tag;
+		uint64_t Acquisitions;
+		// Acquisitions that could not take the lock immediately.
+		uint64_t ContendedAcquisitions;
+		uint64_t TotalWaitMicroseconds;
+		uint64_t TotalHoldMicroseconds;
+		// Bucket 0 counts durations under 1us, and bucket i counts
+		// durations in [2^(i-1), 2^i) us, with the last bucket open-ended.
+		std::array<uint64_t, HistogramBuckets> WaitHistogram;
+		// Hold times are not recorded for shared acquisitions.
+		std::array<uint64_t, HistogramBuckets> HoldHistogram;
+		// The return addresses of callers that had to wait, with how often
+		// each did, most frequent first. Resolve these with a debugger or
+		// SymFromAddr().
+		std::vector<std::pair<const void*, uint64_t>> ContendedCallSites;
+	};
+
+	/// <summary>
+	///		Opt-in contention profiling for Mutex, CriticalSectionLock and
+	///		SlimReadWriteLock. While disabled, which is the default, each
+	///		acquisition only pays for one relaxed atomic load. While enabled,
+	///		every acquisition is timed and recorded against the lock's
+	///		address; contended ones also record their caller. Each thread
+	///		caches which profile a lock records to, so recording doesn't
+	///		contend on a lock of its own. Profiles
+	///		outlive their locks, so a new lock at a recycled address adds to
+	///		the old profile; tag locks to tell them apart in reports.
+	/// </summary>
+	class LockProfiler
+	{
+		public:
+			static void Enable() noexcept;
+			static void Disable() noexcept;
+
+			static bool IsEnabled() noexcept
+			{
+				return m_isEnabled.load(std::memory_order_relaxed);
+			}
+
+			/// <summary>
+			///		Labels a lock in profiles and reports.
+			/// </summary>
+			static void SetTag(const void* lock, std::wstring tag);
+
+			/// <summary>
+			///		Gets the profile of every lock recorded since the last
+			///		Reset(), most waited on first.
+			/// </summary>
+			static std::vector<LockProfile> GetProfiles();
+
+			/// <returns>False if nothing has been recorded for the lock.</returns>
+			static bool TryGetProfile(const void* lock, LockProfile& profile);
+
+			/// <summary>
+			///		Formats GetProfiles() as a human-readable report.
+			/// </summary>
+			static std::wstring GetReport();
+
+			/// <summary>
+			///		Discards every profile and tag. Must not race with
+			///		profiled locks, so disable profiling first.
+			/// </summary>
+			static void Reset();
+
+		// Used by the profiled locks
+		public:
+			/// <summary>
+			///		Returns a timestamp in QueryPerformanceCounter() ticks.
+			/// </summary>
+			static uint64_t Now() noexcept;
+
+			/// <param name="name">
+			///		The lock's name, used as its tag if it has none.
+			/// </param>
+			/// <param name="contendedCallSite">
+			///		The caller's return address if it had to wait, or nullptr.
+			/// </param>
+			static void RecordAcquisition(
+				const void* lock,
+				const wchar_t* kind,
+				const std::wstring& name,
+				const uint64_t waitTicks,
+				const void* contendedCallSite
+			);
+			static void RecordRelease(const void* lock, const uint64_t holdTicks);
+
+		protected:
+			struct Stats;
+			struct Registry;
+			static Registry& GetRegistry();
+			static Stats& GetStats(const void* lock, const wchar_t* kind, const std::wstring& name);
+			static LockProfile ToProfile(const void* lock, const Stats& stats);
+
+		protected:
+			static std::atomic<bool> m_isEnabled;
+	};
+}
\ No newline at end of file
@@ -1,17 +1,26 @@
 #pragma once
 #include <Windows.h>
+#include <filesystem>
 #include <string>
 #include "../Raii/Raii.hpp"
+#include "MemoryMappedWindow.hpp"
 
 namespace Boring32::Async
 {
 	/// <summary>
 	///		Represents a <a href="https://docs.microsoft.com/en-us/dotnet/standard/io/memory-mapped-files">Win32 memory-mapped file</a>,
-	///		which allows processes to share memory. This is a copyable
-	///		and movable object.
+	///		which allows processes to share memory or map a file on disk.
+	///		This is a copyable and movable object.
 	/// </summary>
 	class MemoryMappedFile
 	{
+		public:
+			enum class FileAccess
+			{
+				ReadOnly,
+				ReadWrite
+			};
+
 		// Constructors and destructor
 		public:
 			/// <summary>
@@ -32,14 +41,16 @@ namespace Boring32::Async
 			///		The name of the memory mapped file to create or open.
 			/// </param>
 			/// <param name="maxSize">
-			///		The maximum size of the memory mapped file.
+			///		The maximum size of the memory mapped file. The whole
+			///		file is mapped into view, so it must fit in the address
+			///		space.
 			/// </param>
 			/// <param name="inheritable">
 			///		Whether the acquired handle can be inherited by child processes.
 			/// </param>
 			MemoryMappedFile(
 				std::wstring name,
-				const UINT maxSize,
+				const UINT64 maxSize,
 				const bool inheritable
 			);
 
@@ -50,7 +61,9 @@ namespace Boring32::Async
 			///		The name of the memory mapped file to create or open.
 			/// </param>
 			/// <param name="maxSize">
-			///		The maximum size of the memory mapped file.
+			///		The maximum size of the memory mapped file. The whole
+			///		file is mapped into view, so it must fit in the address
+			///		space.
 			/// </param>
 			/// <param name="inheritable">
 			///		Whether the acquired handle can be inherited by child processes.
@@ -60,11 +73,39 @@ namespace Boring32::Async
 			/// </param>
 			MemoryMappedFile(
 				std::wstring name,
-				const UINT maxSize,
+				const UINT64 maxSize,
 				const bool inheritable,
 				const DWORD desiredAccess
 			);
 
+			/// <summary>
+			///		Maps a file on disk. No view is mapped, as the file may be
+			///		larger than the address space; use OpenWindow() to access
+			///		its contents.
+			/// </summary>
+			/// <param name="path">
+			///		The file to map. It must exist.
+			/// </param>
+			/// <param name="access">
+			///		Whether views of the file can be written to.
+			/// </param>
+			/// <param name="size">
+			///		The size of the mapping, or 0 to use the size of the file.
+			///		A read-write file smaller than this is extended.
+			/// </param>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the file is empty and no size is given, or a
+			///		read-only mapping is larger than the file.
+			/// </exception>
+			/// <exception cref="Boring32::Error::Win32Error">
+			///		Thrown if the file could not be opened or mapped.
+			/// </exception>
+			MemoryMappedFile(
+				const std::filesystem::path& path,
+				const FileAccess access,
+				const UINT64 size
+			);
+
 			/// <summary>
 			///		Duplicates the specified MemoryMappedFile.
 			/// </summary>
@@ -99,6 +140,24 @@ namespace Boring32::Async
 			/// <returns>The view object.</returns>
 			virtual void* GetViewPointer();
 
+			/// <summary>
+			///		Creates a sliding window over the mapping, which maps only
+			///		the region being accessed. Several windows can be open on
+			///		the same mapping at once.
+			/// </summary>
+			/// <param name="windowSize">
+			///		The minimum length of each view the window maps.
+			/// </param>
+			/// <param name="readAhead">
+			///		Whether to prefetch each view as it is mapped.
+			/// </param>
+			virtual MemoryMappedWindow OpenWindow(const size_t windowSize, const bool readAhead) const;
+
+			/// <summary>
+			///		Gets the size of the mapping in bytes.
+			/// </summary>
+			virtual UINT64 GetSize() const noexcept;
+
 			/// <summary>
 			///		Get the name of this MemoryMappedFile.
 			/// </summary>
@@ -133,7 +192,9 @@ namespace Boring32::Async
 
 		protected:
 			std::wstring m_name;
-			UINT m_maxSize;
+			UINT64 m_maxSize;
+			// The access views are mapped with.
+			DWORD m_access;
 			Raii::Win32Handle m_mapFile;
 			void* m_view;
 	};
@@ -10,10 +10,9 @@ namespace Boring32::Async
 		public:
 			MemoryMappedView(const std::wstring& name, const bool create, const bool inheritable)
 			:	m_mappedMemory(
-					name,
-					sizeof(T),
-					create,
-					inheritable
+					create
+						? MemoryMappedFile(name, sizeof(T), inheritable)
+						: MemoryMappedFile(name, sizeof(T), inheritable, FILE_MAP_ALL_ACCESS)
 				),
 				m_view(nullptr)
 			{
@@ -0,0 +1,102 @@
+#pragma once
+#include <Windows.h>
+#include <span>
+#include "../Raii/Raii.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A sliding view over part of a file mapping, for mappings too large
+	///		to map at once. Only the region being touched is mapped; asking
+	///		for a region outside the current view unmaps it and maps a new one
+	///		at least windowSize bytes long. Obtained from
+	///		MemoryMappedFile::OpenWindow(). This is a movable object.
+	/// </summary>
+	class MemoryMappedWindow
+	{
+		public:
+			/// <summary>
+			///		Unmaps the current view and releases the mapping handle.
+			/// </summary>
+			virtual ~MemoryMappedWindow();
+
+			/// <summary>
+			///		Default constructor. Does not initialise the window.
+			/// </summary>
+			MemoryMappedWindow();
+
+			/// <param name="mapping">
+			///		The file mapping. The window keeps its own handle to it.
+			/// </param>
+			/// <param name="mappingSize">The size of the file mapping.</param>
+			/// <param name="access">
+			///		The access to map views with. See: https://docs.microsoft.com/en-us/windows/win32/api/memoryapi/nf-memoryapi-mapviewoffile
+			/// </param>
+			/// <param name="windowSize">
+			///		The minimum length of each view, rounded up to the
+			///		allocation granularity.
+			/// </param>
+			/// <param name="readAhead">
+			///		Whether to prefetch each new view into memory as it is
+			///		mapped, for sequential scans.
+			/// </param>
+			MemoryMappedWindow(
+				const Raii::Win32Handle& mapping,
+				const UINT64 mappingSize,
+				const DWORD access,
+				const size_t windowSize,
+				const bool readAhead
+			);
+
+			MemoryMappedWindow(MemoryMappedWindow&& other) noexcept;
+			virtual MemoryMappedWindow& operator=(MemoryMappedWindow&& other) noexcept;
+
+		// Non-copyable: each window owns its view
+		public:
+			MemoryMappedWindow(const MemoryMappedWindow&) = delete;
+			virtual MemoryMappedWindow& operator=(const MemoryMappedWindow&) = delete;
+
+		public:
+			/// <summary>
+			///		Returns the given region of the mapping, remapping the
+			///		view only if the region is not already covered by it.
+			///		The span is invalidated by the next call that remaps.
+			/// </summary>
+			/// <exception cref="std::out_of_range">
+			///		Thrown if the region extends past the end of the mapping.
+			/// </exception>
+			/// <exception cref="Boring32::Error::Win32Error">
+			///		Thrown if the view could not be mapped.
+			/// </exception>
+			virtual std::span<std::byte> Map(const UINT64 offset, const size_t length);
+
+			/// <summary>
+			///		Asks the memory manager to bring the part of the given
+			///		region covered by the current view into memory ahead of
+			///		use. This is a hint; failures are ignored.
+			/// </summary>
+			virtual void Prefetch(const UINT64 offset, const size_t length) noexcept;
+
+			/// <summary>
+			///		Unmaps the current view, if any.
+			/// </summary>
+			virtual void Unmap() noexcept;
+
+			virtual UINT64 GetViewOffset() const noexcept;
+			virtual size_t GetViewSize() const noexcept;
+			virtual UINT64 GetMappingSize() const noexcept;
+
+		protected:
+			virtual void Move(MemoryMappedWindow& other) noexcept;
+
+		protected:
+			Raii::Win32Handle m_mapping;
+			UINT64 m_mappingSize;
+			DWORD m_access;
+			size_t m_windowSize;
+			bool m_readAhead;
+			std::byte* m_view;
+			UINT64 m_viewOffset;
+			size_t m_viewSize;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A move-only, type-erased void() callable. Callables that fit in
+	///		InlineSize bytes and are nothrow-movable are stored inline, so
+	///		submitting typical lambdas to a TaskPool does not allocate.
+	///		Larger callables fall back to a single heap allocation.
+	/// </summary>
+	class MoveOnlyTask
+	{
+		public:
+			static constexpr size_t InlineSize = 6 * sizeof(void*);
+
+		public:
+			~MoveOnlyTask()
+			{
+				Reset();
+			}
+
+			MoveOnlyTask() noexcept
+			:	m_storage{},
+				m_vtable(nullptr)
+			{ }
+
+			template<typename F>
+				requires (!std::is_same_v<std::decay_t<F>, MoveOnlyTask>
+					&& std::is_invocable_v<std::decay_t<F>&>)
+			MoveOnlyTask(F&& func)
+			:	m_storage{},
+				m_vtable(nullptr)
+			{
+				using Callable = std::decay_t<F>;
+				if constexpr (IsStoredInline<Callable>())
+				{
+					new (m_storage) Callable(std::forward<F>(func));
+					m_vtable = &InlineVTable<Callable>;
+				}
+				else
+				{
+					new (m_storage) Callable*(new Callable(std::forward<F>(func)));
+					m_vtable = &HeapVTable<Callable>;
+				}
+			}
+
+			MoveOnlyTask(MoveOnlyTask&& other) noexcept
+			:	m_storage{},
+				m_vtable(nullptr)
+			{
+				Move(other);
+			}
+
+			MoveOnlyTask& operator=(MoveOnlyTask&& other) noexcept
+			{
+				if (this != &other)
+				{
+					Reset();
+					Move(other);
+				}
+				return *this;
+			}
+
+		// Non-copyable
+		public:
+			MoveOnlyTask(const MoveOnlyTask&) = delete;
+			MoveOnlyTask& operator=(const MoveOnlyTask&) = delete;
+
+		public:
+			void operator()()
+			{
+				if (m_vtable == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": task is empty");
+				m_vtable->Invoke(m_storage);
+			}
+
+			explicit operator bool() const noexcept
+			{
+				return m_vtable != nullptr;
+			}
+
+			void Reset() noexcept
+			{
+				if (m_vtable)
+				{
+					m_vtable->Destroy(m_storage);
+					m_vtable = nullptr;
+				}
+			}
+
+		protected:
+			struct VTable
+			{
+				void (*Invoke)(std::byte* storage);
+				void (*Relocate)(std::byte* destination, std::byte* source) noexcept;
+				void (*Destroy)(std::byte* storage) noexcept;
+			};
+
+			template<typename Callable>
+			static constexpr bool IsStoredInline() noexcept
+			{
+				return sizeof(Callable) <= InlineSize
+					&& alignof(Callable) <= alignof(std::max_align_t)
+					&& std::is_nothrow_move_constructible_v<Callable>;
+			}
+
+			template<typename Callable>
+			static constexpr VTable InlineVTable{
+				[](std::byte* storage)
+				{
+					(*std::launder(reinterpret_cast<Callable*>(storage)))();
+				},
+				[](std::byte* destination, std::byte* source) noexcept
+				{
+					Callable* sourceCallable = std::launder(reinterpret_cast<Callable*>(source));
+					new (destination) Callable(std::move(*sourceCallable));
+					sourceCallable->~Callable();
+				},
+				[](std::byte* storage) noexcept
+				{
+					std::launder(reinterpret_cast<Callable*>(storage))->~Callable();
+				}
+			};
+
+			template<typename Callable>
+			static constexpr VTable HeapVTable{
+				[](std::byte* storage)
+				{
+					(**reinterpret_cast<Callable**>(storage))();
+				},
+				[](std::byte* destination, std::byte* source) noexcept
+				{
+					new (destination) Callable*(*reinterpret_cast<Callable**>(source));
+				},
+				[](std::byte* storage) noexcept
+				{
+					delete *reinterpret_cast<Callable**>(storage);
+				}
+			};
+
+			void Move(MoveOnlyTask& other) noexcept
+			{
+				if (other.m_vtable == nullptr)
+					return;
+				other.m_vtable->Relocate(m_storage, other.m_storage);
+				m_vtable = other.m_vtable;
+				other.m_vtable = nullptr;
+			}
+
+		protected:
+			alignas(std::max_align_t) std::byte m_storage[InlineSize];
+			const VTable* m_vtable;
+	};
+}
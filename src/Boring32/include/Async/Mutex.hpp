@@ -1,5 +1,6 @@
 #pragma once
 #include <Windows.h>
+#include <cstdint>
 #include <string>
 #include "../Raii/Raii.hpp"
 
@@ -174,11 +175,15 @@ namespace Boring32::Async
 		protected:
 			virtual void Move(Mutex& other) noexcept;
 			virtual void Copy(const Mutex& other);
+			virtual bool ProfiledLock(const DWORD waitTime, const bool isAlertable, const void* callSite);
 
 		protected:
 			std::wstring m_name;
 			bool m_created;
 			bool m_locked;
 			Raii::Win32Handle m_mutex;
+			// When the lock was acquired, if it was acquired while
+			// LockProfiler was enabled; otherwise 0.
+			uint64_t m_profiledAt;
 	};
 }
\ No newline at end of file
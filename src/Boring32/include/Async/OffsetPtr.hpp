@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A pointer stored as the distance from its own address to its
+	///		target, so it stays valid in shared memory that each process maps
+	///		at a different address, as long as the pointer and its target are
+	///		in the same mapping. A distance of zero means null. Like the other
+	///		types placed in shared memory, it has no virtual members, as a
+	///		vtable pointer is only meaningful in the process that wrote it.
+	/// </summary>
+	template<typename T>
+	class OffsetPtr
+	{
+		public:
+			OffsetPtr() noexcept
+			:	m_offset(0)
+			{ }
+
+			OffsetPtr(T* pointer) noexcept
+			:	m_offset(0)
+			{
+				Set(pointer);
+			}
+
+			/// <summary>
+			///		Points at the same target as other. The offset is
+			///		recomputed, as this pointer is at a different address.
+			/// </summary>
+			OffsetPtr(const OffsetPtr& other) noexcept
+			:	m_offset(0)
+			{
+				Set(other.Get());
+			}
+
+			OffsetPtr& operator=(const OffsetPtr& other) noexcept
+			{
+				Set(other.Get());
+				return *this;
+			}
+
+			OffsetPtr& operator=(T* pointer) noexcept
+			{
+				Set(pointer);
+				return *this;
+			}
+
+		public:
+			T* Get() const noexcept
+			{
+				if (m_offset == 0)
+					return nullptr;
+				const std::byte* self = reinterpret_cast<const std::byte*>(this);
+				return reinterpret_cast<T*>(const_cast<std::byte*>(self + m_offset));
+			}
+
+			T* operator->() const noexcept
+			{
+				return Get();
+			}
+
+			T& operator*() const noexcept
+			{
+				return *Get();
+			}
+
+			T& operator[](const size_t index) const noexcept
+			{
+				return Get()[index];
+			}
+
+			explicit operator bool() const noexcept
+			{
+				return m_offset != 0;
+			}
+
+		protected:
+			void Set(T* pointer) noexcept
+			{
+				m_offset = pointer == nullptr
+					? 0
+					: reinterpret_cast<const std::byte*>(pointer) - reinterpret_cast<const std::byte*>(this);
+			}
+
+		protected:
+			// 64-bit regardless of the process, so 32-bit and 64-bit
+			// processes agree on the layout.
+			int64_t m_offset;
+	};
+}
\ No newline at end of file
@@ -16,6 +16,13 @@ namespace Boring32::Async
 			OverlappedIo(const OverlappedIo& other) = delete;
 			virtual OverlappedIo& operator=(const OverlappedIo& other) = delete;
 
+		public:
+			/// <summary>
+			///		Readies the operation for a new I/O request, emptying
+			///		IoBuffer but keeping its capacity.
+			/// </summary>
+			virtual void Reset() override;
+
 		public:
 			std::wstring IoBuffer;
 
@@ -30,6 +30,14 @@ namespace Boring32::Async
 			virtual bool IsSuccessful() const;
 			virtual bool IsPartial() const;
 			virtual void SetEvent(const bool signaled);
+
+			/// <summary>
+			///		Readies the operation for a new I/O request. The OVERLAPPED
+			///		and event are zeroed and reused rather than reallocated,
+			///		unless they are shared with another operation. Must not be
+			///		called while I/O is outstanding.
+			/// </summary>
+			virtual void Reset();
 			virtual DWORD LastError() const;
 			virtual void LastError(const DWORD lastError);
 
@@ -0,0 +1,96 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "SpinEstimator.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A reusable barrier for threads that work in phases. Unlike
+	///		SynchronizationBarrier, a participant that has no more work can
+	///		leave with ArriveAndDrop(), and an optional callback runs once per
+	///		phase, on the last thread to arrive, before the others are
+	///		released. Waiting threads spin, then yield, then park with
+	///		WaitOnAddress(); the spin limit adapts to how long recent phases
+	///		took to complete, so short phases avoid the wake-up latency of
+	///		parking and long ones don't burn cores.
+	/// </summary>
+	class PhaseBarrier
+	{
+		public:
+			static constexpr uint32_t DefaultMaxSpins = 4000;
+			// The number of times a waiter yields its timeslice before parking.
+			static constexpr uint32_t YieldCount = 4;
+
+		public:
+			virtual ~PhaseBarrier();
+
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if participants is zero.
+			/// </exception>
+			PhaseBarrier(const uint32_t participants);
+
+			/// <param name="onCompletion">
+			///		Called on the last thread to arrive in each phase, before
+			///		the phase ends. Must not throw.
+			/// </param>
+			/// <param name="maxSpins">
+			///		The upper bound on spin iterations before yielding.
+			/// </param>
+			PhaseBarrier(
+				const uint32_t participants,
+				std::function<void()> onCompletion,
+				const uint32_t maxSpins
+			);
+
+		// Non-copyable, non-movable: waiters park on the address of m_phase
+		public:
+			PhaseBarrier(const PhaseBarrier&) = delete;
+			virtual PhaseBarrier& operator=(const PhaseBarrier&) = delete;
+			PhaseBarrier(PhaseBarrier&&) noexcept = delete;
+			virtual PhaseBarrier& operator=(PhaseBarrier&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Blocks until every participant has arrived in the
+			///		current phase.
+			/// </summary>
+			/// <returns>
+			///		True on the last thread to arrive, like
+			///		SynchronizationBarrier::Enter().
+			/// </returns>
+			virtual bool Enter();
+
+			/// <summary>
+			///		Arrives in the current phase without waiting, and leaves
+			///		the barrier, so later phases complete without this thread.
+			/// </summary>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if there are no participants left to drop.
+			/// </exception>
+			virtual void ArriveAndDrop();
+
+			/// <summary>
+			///		Returns the number of phases that have completed.
+			/// </summary>
+			virtual uint32_t GetPhase() const noexcept;
+			virtual uint32_t GetParticipants() const noexcept;
+
+		protected:
+			// Counts one arrival, ending the phase if it was the last.
+			virtual bool Arrive() noexcept;
+			virtual void Wait(const uint32_t phase);
+
+		protected:
+			std::function<void()> m_onCompletion;
+			SpinEstimator m_spins;
+			std::atomic<uint32_t> m_participants;
+			std::atomic<uint32_t> m_waiters;
+			// Each on their own cache line, as every arrival writes
+			// m_remaining and every waiter polls m_phase.
+			alignas(64) std::atomic<uint32_t> m_remaining;
+			alignas(64) std::atomic<uint32_t> m_phase;
+	};
+}
\ No newline at end of file
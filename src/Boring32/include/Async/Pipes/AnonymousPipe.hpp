@@ -1,6 +1,8 @@
 #pragma once
 #include <Windows.h>
+#include <cstdint>
 #include <string>
+#include <span>
 #include <vector>
 #include "../../Raii/Raii.hpp"
 
@@ -8,6 +10,13 @@ namespace Boring32::Async
 {
 	class AnonymousPipe
 	{
+		public:
+			/// <summary>
+			///		The largest message FramedWrite() accepts and FramedRead()
+			///		will buffer.
+			/// </summary>
+			static constexpr uint32_t MaxFrameSize = 64 * 1024 * 1024;
+
 		// Constructors
 		public:
 			virtual ~AnonymousPipe();
@@ -36,6 +45,59 @@ namespace Boring32::Async
 			virtual void DelimitedWrite(const std::wstring& msg);
 			virtual std::wstring Read();
 			virtual std::vector<std::wstring> DelimitedRead();
+
+			/// <summary>
+			///		Writes the bytes as they are, without copying them.
+			/// </summary>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the pipe has insufficient space for the data.
+			/// </exception>
+			virtual void Write(std::span<const std::byte> data);
+
+			/// <summary>
+			///		Reads up to buffer.size() bytes directly into the buffer,
+			///		blocking until at least one byte is available.
+			/// </summary>
+			/// <returns>The number of bytes read.</returns>
+			virtual DWORD Read(std::span<std::byte> buffer);
+
+			/// <summary>
+			///		Writes the message prefixed by its length as a uint32, for
+			///		reading with FramedRead(). Unlike DelimitedWrite(), messages
+			///		may contain any bytes and may be larger than the pipe, as
+			///		this blocks until the reader has made room for all of it.
+			///		The length and message are separate writes, so callers on
+			///		multiple threads must serialise their calls.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the message is larger than MaxFrameSize.
+			/// </exception>
+			/// <exception cref="Error::Win32Error">
+			///		Thrown if the write fails, e.g. because the read end was
+			///		closed.
+			/// </exception>
+			virtual void FramedWrite(std::span<const std::byte> message);
+
+			/// <summary>
+			///		Returns the next message written by FramedWrite(). Data is
+			///		read from the pipe into a reusable buffer as large as 
+			///		possible, so a single read typically yields many messages,
+			///		which are then returned without further reads or copies.
+			///		Blocks until a whole message is available.
+			/// </summary>
+			/// <param name="message">
+			///		Receives a view of the message in the internal buffer, 
+			///		which remains valid until the next call to FramedRead().
+			/// </param>
+			/// <returns>
+			///		False if the write end was closed and all messages have 
+			///		been read.
+			/// </returns>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the write end was closed mid-message, or the 
+			///		data is not framed.
+			/// </exception>
+			virtual bool FramedRead(std::span<const std::byte>& message);
 			virtual void CloseRead();
 			virtual void CloseWrite();
 			virtual void SetMode(const DWORD mode);
@@ -44,6 +106,7 @@ namespace Boring32::Async
 			virtual std::wstring GetDelimiter() const;
 			virtual DWORD GetSize() const;
 			virtual DWORD GetUsedSize() const;
+			virtual DWORD GetUsedBytes() const;
 			virtual DWORD GetRemainingSize() const;
 
 		// Internal methods
@@ -51,6 +114,8 @@ namespace Boring32::Async
 			virtual void Cleanup();
 			virtual void Move(AnonymousPipe& other) noexcept;
 			virtual void Copy(const AnonymousPipe& other);
+			// Blocks until all of the data is written.
+			virtual void WriteAll(std::span<const std::byte> data);
 
 		// Internal variables
 		protected:
@@ -59,5 +124,10 @@ namespace Boring32::Async
 			DWORD m_mode;
 			Raii::Win32Handle m_readHandle;
 			Raii::Win32Handle m_writeHandle;
+			// Reused by FramedRead().
+			std::vector<std::byte> m_readBuffer;
+			// The unconsumed bytes in m_readBuffer.
+			size_t m_readBegin = 0;
+			size_t m_readEnd = 0;
 	};
 }
\ No newline at end of file
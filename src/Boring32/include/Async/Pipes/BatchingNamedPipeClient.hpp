@@ -0,0 +1,107 @@
+#pragma once
+#include <Windows.h>
+#include <span>
+#include <thread>
+#include <vector>
+#include "../Event.hpp"
+#include "BlockingNamedPipeClient.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A blocking pipe client that coalesces small messages into batches,
+	///		so many messages cost a single write. Each message is framed with
+	///		a little-endian uint32_t length, and a batch is written as one pipe
+	///		message; the receiver splits it with NextMessage(). A batch is
+	///		written once it reaches the batch size, when the flush deadline
+	///		after its first message passes, or on FlushBatch() or Close().
+	/// </summary>
+	class BatchingNamedPipeClient : public BlockingNamedPipeClient
+	{
+		public:
+			static constexpr size_t FrameHeaderSize = sizeof(uint32_t);
+
+		public:
+			/// <summary>
+			///		Flushes any pending messages and closes the pipe.
+			/// </summary>
+			virtual ~BatchingNamedPipeClient();
+
+			/// <param name="maxBatchSize">
+			///		The batch size, in bytes including framing, that triggers
+			///		a write. Should not exceed the pipe's buffer size.
+			/// </param>
+			/// <param name="flushDeadline">
+			///		The maximum time in milliseconds a message waits in a
+			///		partial batch, or INFINITE to only flush explicitly.
+			/// </param>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if maxBatchSize is too small to hold a frame.
+			/// </exception>
+			BatchingNamedPipeClient(
+				const std::wstring& name,
+				const size_t maxBatchSize,
+				const DWORD flushDeadline
+			);
+
+		// Non-copyable, non-movable: the flush thread holds a pointer to the client
+		public:
+			BatchingNamedPipeClient(const BatchingNamedPipeClient&) = delete;
+			virtual void operator=(const BatchingNamedPipeClient&) = delete;
+			BatchingNamedPipeClient(BatchingNamedPipeClient&&) noexcept = delete;
+			virtual void operator=(BatchingNamedPipeClient&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Flushes any pending messages, stops the flush thread and
+			///		closes the pipe.
+			/// </summary>
+			virtual void Close() override;
+
+			/// <summary>
+			///		Queues a message, writing the batch first if the message
+			///		doesn't fit. Messages larger than the batch size are sent
+			///		in a batch of their own.
+			/// </summary>
+			virtual void Post(std::span<const std::byte> message);
+
+			/// <summary>
+			///		Queues a message gathered from several buffers.
+			/// </summary>
+			virtual void Post(std::span<const std::span<const std::byte>> buffers);
+
+			/// <summary>
+			///		Writes any pending messages now.
+			/// </summary>
+			virtual void FlushBatch();
+
+			virtual size_t GetPendingBytes() noexcept;
+
+			/// <summary>
+			///		Splits the next message off the front of a received batch.
+			/// </summary>
+			/// <returns>False once the batch is empty.</returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the batch ends part way through a message.
+			/// </exception>
+			static bool NextMessage(
+				std::span<const std::byte>& batch,
+				std::span<const std::byte>& message
+			);
+
+		protected:
+			virtual void Run() noexcept;
+			virtual void InternalFlush();
+
+		protected:
+			size_t m_maxBatchSize;
+			DWORD m_flushDeadline;
+			// Guards the batch and m_isStopping, and serialises writes.
+			SRWLOCK m_batchLock;
+			std::vector<std::byte> m_batch;
+			ULONGLONG m_batchStarted;
+			bool m_isStopping;
+			Event m_wake;
+			std::thread m_flushThread;
+	};
+}
\ No newline at end of file
@@ -21,6 +21,29 @@ namespace Boring32::Async
 			virtual std::wstring Read();
 			virtual bool Read(std::wstring& out, const std::nothrow_t);
 
+			/// <summary>
+			///		Writes the bytes as a single message without copying them.
+			/// </summary>
+			virtual void Write(std::span<const std::byte> data);
+			virtual bool Write(std::span<const std::byte> data, const std::nothrow_t);
+
+			/// <summary>
+			///		Writes the buffers, in order, as a single message.
+			/// </summary>
+			virtual void Write(std::span<const std::span<const std::byte>> buffers);
+
+			/// <summary>
+			///		Reads the next message, or the next part of it, into the
+			///		caller's buffer.
+			/// </summary>
+			/// <param name="buffer">The buffer to read into.</param>
+			/// <param name="bytesRead">Receives the number of bytes read.</param>
+			/// <returns>
+			///		False if the message didn't fit in the buffer; the rest 
+			///		of it is returned by subsequent reads.
+			/// </returns>
+			virtual bool Read(std::span<std::byte> buffer, DWORD& bytesRead);
+
 		protected:
 			virtual void InternalWrite(const std::wstring& msg);
 			virtual std::wstring InternalRead();
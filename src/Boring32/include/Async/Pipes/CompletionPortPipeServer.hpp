@@ -0,0 +1,166 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../Raii/Raii.hpp"
+#include "../IoOperationPool.hpp"
+#include "OverlappedNamedPipeServer.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A message-mode named pipe server that services many concurrent
+	///		clients on a small pool of worker threads. A fixed number of pipe
+	///		instances are created up front and bound to an I/O completion
+	///		port; each instance re-arms its connect and read operations as
+	///		they complete, so a disconnected instance immediately listens for
+	///		the next client. Handlers run on the worker threads; a connection
+	///		only ever has one handler running at a time, and its messages are
+	///		delivered in order.
+	/// </summary>
+	class CompletionPortPipeServer
+	{
+		public:
+			/// <summary>
+			///		Identifies a single client connection. Ids are not reused
+			///		when an instance accepts a new client, so stale ids are
+			///		safely rejected by Send() and Disconnect().
+			/// </summary>
+			using ConnectionId = uint64_t;
+
+			struct Handlers
+			{
+				std::function<void(ConnectionId)> OnConnect;
+				/// <summary>
+				///		Receives each complete message. The span is only valid
+				///		for the duration of the call.
+				/// </summary>
+				std::function<void(ConnectionId, std::span<const std::byte>)> OnMessage;
+				std::function<void(ConnectionId)> OnDisconnect;
+			};
+
+			/// <summary>
+			///		The maximum number of completions a worker dequeues at once.
+			/// </summary>
+			static constexpr ULONG CompletionBatchSize = 16;
+
+		public:
+			virtual ~CompletionPortPipeServer();
+
+			/// <summary>
+			///		Creates the pipe instances and starts listening.
+			/// </summary>
+			/// <param name="instanceCount">
+			///		The number of pipe instances, which is the maximum number of
+			///		concurrently connected clients.
+			/// </param>
+			/// <param name="bufferSize">
+			///		The pipe buffer size and per-instance read buffer size. Longer
+			///		messages are still received whole, at the cost of a copy.
+			/// </param>
+			/// <param name="workerCount">
+			///		The number of threads servicing the completion port.
+			/// </param>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if any count or the buffer size is zero.
+			/// </exception>
+			/// <exception cref="Boring32::Error::Win32Error">
+			///		Thrown if creating the pipes or the completion port fails.
+			/// </exception>
+			CompletionPortPipeServer(
+				const std::wstring& pipeName,
+				const DWORD instanceCount,
+				const DWORD bufferSize,
+				const DWORD workerCount,
+				const std::wstring& sid,
+				const bool isLocalPipe,
+				Handlers handlers
+			);
+
+		// Non-copyable, non-movable: workers hold a pointer to the server
+		public:
+			CompletionPortPipeServer(const CompletionPortPipeServer&) = delete;
+			virtual CompletionPortPipeServer& operator=(const CompletionPortPipeServer&) = delete;
+			CompletionPortPipeServer(CompletionPortPipeServer&&) noexcept = delete;
+			virtual CompletionPortPipeServer& operator=(CompletionPortPipeServer&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Cancels all outstanding I/O, waits for the handlers to
+			///		return, joins the workers and closes the pipes. Must not be
+			///		called from a handler.
+			/// </summary>
+			virtual void Close();
+
+			/// <summary>
+			///		Copies the message into a pooled operation and queues it as a
+			///		single write to the client. Can be called from any thread,
+			///		including handlers.
+			/// </summary>
+			/// <returns>
+			///		False if the connection is gone or the write could not be
+			///		started.
+			/// </returns>
+			virtual bool Send(const ConnectionId id, std::span<const std::byte> message);
+
+			/// <summary>
+			///		Forcibly disconnects the client. OnDisconnect is raised on a
+			///		worker once the instance's pending read fails.
+			/// </summary>
+			/// <returns>False if the connection is already gone.</returns>
+			virtual bool Disconnect(const ConnectionId id);
+
+			virtual size_t GetConnectionCount() const noexcept;
+			virtual size_t GetInstanceCount() const noexcept;
+			virtual const std::wstring& GetName() const noexcept;
+
+		protected:
+			enum class InstanceState
+			{
+				Connecting,
+				Connected
+			};
+
+			struct Instance
+			{
+				// Used for both ConnectNamedPipe() and ReadFile(); only one of
+				// them is ever outstanding.
+				OVERLAPPED Overlapped{};
+				OverlappedNamedPipeServer Server;
+				// Guards State and Generation against Send() and Disconnect().
+				SRWLOCK Lock = SRWLOCK_INIT;
+				InstanceState State = InstanceState::Connecting;
+				uint32_t Generation = 0;
+				std::vector<std::byte> Buffer;
+				// Accumulates messages larger than Buffer.
+				std::vector<std::byte> Partial;
+			};
+
+			virtual void Run() noexcept;
+			virtual void OnCompletion(const OVERLAPPED_ENTRY& entry) noexcept;
+			virtual void ArmConnect(const size_t index) noexcept;
+			virtual void ArmRead(const size_t index) noexcept;
+			virtual void Reset(const size_t index) noexcept;
+			virtual void OnConnected(const size_t index) noexcept;
+			virtual Instance* Find(const ConnectionId id) noexcept;
+			virtual void CompleteOperation() noexcept;
+
+		protected:
+			std::wstring m_pipeName;
+			Handlers m_handlers;
+			// Write operations, sized to bufferSize.
+			IoOperationPool m_writePool;
+			Raii::Win32Handle m_completionPort;
+			std::vector<std::unique_ptr<Instance>> m_instances;
+			std::vector<std::thread> m_workers;
+			std::atomic<bool> m_isClosing = false;
+			// Operations that will still produce a completion packet.
+			std::atomic<uint32_t> m_outstanding = 0;
+			std::atomic<size_t> m_connections = 0;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include <span>
+#include <vector>
 #include "../../Raii/Raii.hpp"
 
 namespace Boring32::Async
@@ -24,6 +26,11 @@ namespace Boring32::Async
 			virtual bool Connect(const DWORD timeout, std::nothrow_t);
 			virtual void Close();
 			virtual DWORD UnreadCharactersRemaining() const;
+			/// <summary>
+			///		Returns the number of bytes left in the current message,
+			///		for sizing a buffer to read the rest of it into.
+			/// </summary>
+			virtual DWORD UnreadBytesRemaining() const;
 			virtual void Flush();
 			virtual void CancelCurrentThreadIo();
 			virtual bool CancelCurrentThreadIo(std::nothrow_t)  noexcept;
@@ -34,9 +41,49 @@ namespace Boring32::Async
 			virtual void Copy(const NamedPipeClientBase& other);
 			virtual void Move(NamedPipeClientBase& other) noexcept;
 
+			/// <summary>
+			///		Writes the bytes as they are, without copying them. The 
+			///		data must remain valid until an overlapped write completes.
+			/// </summary>
+			/// <returns>ERROR_SUCCESS or ERROR_IO_PENDING.</returns>
+			virtual DWORD WriteBytes(
+				std::span<const std::byte> data, 
+				DWORD* bytesWritten, 
+				OVERLAPPED* overlapped
+			);
+
+			/// <summary>
+			///		Reads directly into the caller's buffer. The buffer must
+			///		remain valid until an overlapped read completes.
+			/// </summary>
+			/// <returns>
+			///		ERROR_SUCCESS, ERROR_IO_PENDING, or ERROR_MORE_DATA if the 
+			///		message is larger than the buffer.
+			/// </returns>
+			virtual DWORD ReadBytes(
+				std::span<std::byte> buffer, 
+				DWORD* bytesRead, 
+				OVERLAPPED* overlapped
+			);
+
+			/// <summary>
+			///		Writes the buffers as a single message. Pipes don't support
+			///		gather writes, so the buffers are copied once into a buffer
+			///		kept by the client, which must not be written through again
+			///		until an overlapped write completes.
+			/// </summary>
+			/// <returns>ERROR_SUCCESS or ERROR_IO_PENDING.</returns>
+			virtual DWORD WriteGathered(
+				std::span<const std::span<const std::byte>> buffers,
+				DWORD* bytesWritten,
+				OVERLAPPED* overlapped
+			);
+
 		protected:
 			Raii::Win32Handle m_handle;
 			std::wstring m_pipeName;
 			DWORD m_fileAttributes;
+			// Reused by WriteGathered(); not copied or moved.
+			std::vector<std::byte> m_gatherBuffer;
 	};
 }
\ No newline at end of file
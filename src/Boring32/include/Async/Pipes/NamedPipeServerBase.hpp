@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <span>
 #include "../../Raii/Raii.hpp"
 
 namespace Boring32::Async
@@ -47,6 +48,11 @@ namespace Boring32::Async
 			virtual DWORD GetOpenMode() const;
 			virtual DWORD UnreadCharactersRemaining() const;
 			virtual bool UnreadCharactersRemaining(DWORD& charactersRemaining, std::nothrow_t) const noexcept;
+			/// <summary>
+			///		Returns the number of bytes left in the current message,
+			///		for sizing a buffer to read the rest of it into.
+			/// </summary>
+			virtual DWORD UnreadBytesRemaining() const;
 			virtual void CancelCurrentThreadIo();
 			virtual bool CancelCurrentThreadIo(std::nothrow_t) noexcept;
 			virtual void CancelCurrentProcessIo(OVERLAPPED* overlapped);
@@ -58,6 +64,31 @@ namespace Boring32::Async
 			virtual void Move(NamedPipeServerBase& other) noexcept;
 			virtual bool InternalUnreadCharactersRemaining(DWORD& charactersRemaining, const bool throwOnError) const;
 
+			/// <summary>
+			///		Writes the bytes as they are, without copying them. The 
+			///		data must remain valid until an overlapped write completes.
+			/// </summary>
+			/// <returns>ERROR_SUCCESS or ERROR_IO_PENDING.</returns>
+			virtual DWORD WriteBytes(
+				std::span<const std::byte> data, 
+				DWORD* bytesWritten, 
+				OVERLAPPED* overlapped
+			);
+
+			/// <summary>
+			///		Reads directly into the caller's buffer. The buffer must
+			///		remain valid until an overlapped read completes.
+			/// </summary>
+			/// <returns>
+			///		ERROR_SUCCESS, ERROR_IO_PENDING, or ERROR_MORE_DATA if the 
+			///		message is larger than the buffer.
+			/// </returns>
+			virtual DWORD ReadBytes(
+				std::span<std::byte> buffer, 
+				DWORD* bytesRead, 
+				OVERLAPPED* overlapped
+			);
+
 		protected:
 			Raii::Win32Handle m_pipe;
 			std::wstring m_pipeName;
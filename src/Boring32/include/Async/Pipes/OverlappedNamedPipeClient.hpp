@@ -1,4 +1,5 @@
 #pragma once
+#include "../IoOperationPool.hpp"
 #include "../OverlappedIo.hpp"
 #include "NamedPipeClientBase.hpp"
 
@@ -23,6 +24,50 @@ namespace Boring32::Async
 			virtual void Read(const DWORD noOfCharacters, OverlappedIo& op);
 			virtual bool Read(const DWORD noOfCharacters, OverlappedIo& op, std::nothrow_t) noexcept;
 
+			/// <summary>
+			///		Starts writing the bytes as a single message without 
+			///		copying them. The data must remain valid until the 
+			///		operation completes.
+			/// </summary>
+			virtual void Write(std::span<const std::byte> data, OverlappedOp& op);
+			virtual bool Write(std::span<const std::byte> data, OverlappedOp& op, std::nothrow_t) noexcept;
+
+			/// <summary>
+			///		Starts writing the buffers, in order, as a single message.
+			///		The buffers are copied, so they can be released straight
+			///		away, but only one such write can be outstanding at once.
+			/// </summary>
+			virtual void Write(std::span<const std::span<const std::byte>> buffers, OverlappedOp& op);
+
+			/// <summary>
+			///		Starts reading the next message into the caller's buffer,
+			///		which must remain valid until the operation completes. On
+			///		completion, GetBytesTransferred() returns the size read 
+			///		and IsPartial() indicates the message didn't fit; the rest
+			///		of it is returned by subsequent reads.
+			/// </summary>
+			virtual void Read(std::span<std::byte> buffer, OverlappedOp& op);
+			virtual bool Read(std::span<std::byte> buffer, OverlappedOp& op, std::nothrow_t) noexcept;
+
+			/// <summary>
+			///		Starts writing the bytes as a single message from an
+			///		operation taken from the pool, so nothing is allocated per
+			///		write. The bytes are copied into the operation's buffer and
+			///		can be released straight away. Wait on the returned 
+			///		operation, then release it back to the pool.
+			/// </summary>
+			virtual IoOperation* Write(std::span<const std::byte> data, IoOperationPool& pool);
+
+			/// <summary>
+			///		Starts reading the next message into the buffer of an 
+			///		operation taken from the pool, which holds at least size
+			///		bytes. Once the returned operation completes, the message
+			///		is the first GetBytesTransferred() bytes of GetBuffer(), and
+			///		IsPartial() indicates it didn't fit. Release the operation
+			///		back to the pool afterwards.
+			/// </summary>
+			virtual IoOperation* Read(const DWORD size, IoOperationPool& pool);
+
 		protected:
 			virtual void InternalWrite(const std::wstring& msg, OverlappedIo& op);
 			virtual void InternalRead(const DWORD noOfCharacters, OverlappedIo& op);
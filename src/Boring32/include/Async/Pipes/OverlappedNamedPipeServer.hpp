@@ -2,6 +2,7 @@
 #include <string>
 #include "../../Raii/Raii.hpp"
 #include "../Event.hpp"
+#include "../IoOperationPool.hpp"
 #include "../OverlappedIo.hpp"
 #include "NamedPipeServerBase.hpp"
 
@@ -44,6 +45,43 @@ namespace Boring32::Async
 			virtual void Read(const DWORD noOfCharacters, OverlappedIo& oio);
 			virtual bool Read(const DWORD noOfCharacters, OverlappedIo& oio, std::nothrow_t) noexcept;
 
+			/// <summary>
+			///		Starts writing the bytes as a single message without 
+			///		copying them. The data must remain valid until the 
+			///		operation completes.
+			/// </summary>
+			virtual void Write(std::span<const std::byte> data, OverlappedOp& op);
+			virtual bool Write(std::span<const std::byte> data, OverlappedOp& op, std::nothrow_t) noexcept;
+
+			/// <summary>
+			///		Starts reading the next message into the caller's buffer,
+			///		which must remain valid until the operation completes. On
+			///		completion, GetBytesTransferred() returns the size read 
+			///		and IsPartial() indicates the message didn't fit; the rest
+			///		of it is returned by subsequent reads.
+			/// </summary>
+			virtual void Read(std::span<std::byte> buffer, OverlappedOp& op);
+			virtual bool Read(std::span<std::byte> buffer, OverlappedOp& op, std::nothrow_t) noexcept;
+
+			/// <summary>
+			///		Starts writing the bytes as a single message from an
+			///		operation taken from the pool, so nothing is allocated per
+			///		write. The bytes are copied into the operation's buffer and
+			///		can be released straight away. Wait on the returned 
+			///		operation, then release it back to the pool.
+			/// </summary>
+			virtual IoOperation* Write(std::span<const std::byte> data, IoOperationPool& pool);
+
+			/// <summary>
+			///		Starts reading the next message into the buffer of an 
+			///		operation taken from the pool, which holds at least size
+			///		bytes. Once the returned operation completes, the message
+			///		is the first GetBytesTransferred() bytes of GetBuffer(), and
+			///		IsPartial() indicates it didn't fit. Release the operation
+			///		back to the pool afterwards.
+			/// </summary>
+			virtual IoOperation* Read(const DWORD size, IoOperationPool& pool);
+
 		protected:
 			virtual void InternalWrite(const std::wstring& msg, OverlappedIo& oio);
 			virtual void InternalRead(const DWORD noOfCharacters, OverlappedIo& oio);
@@ -6,3 +6,5 @@
 #include "OverlappedNamedPipeClient.hpp"
 #include "BlockingNamedPipeServer.hpp"
 #include "BlockingNamedPipeClient.hpp"
+#include "BatchingNamedPipeClient.hpp"
+#include "CompletionPortPipeServer.hpp"
@@ -0,0 +1,123 @@
+#pragma once
+#include <concepts>
+#include <mutex>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A lock with the SlimReadWriteLock interface, such as
+	///		SlimReadWriteLock or ReaderBiasedLock.
+	/// </summary>
+	template<typename L>
+	concept ReadWriteLock = requires(L& lock)
+	{
+		lock.AcquireSharedLock();
+		lock.ReleaseSharedLock();
+		lock.AcquireExclusiveLock();
+		lock.ReleaseExclusiveLock();
+		{ lock.TryAcquireSharedLock() } -> std::convertible_to<bool>;
+		{ lock.TryAcquireExclusiveLock() } -> std::convertible_to<bool>;
+	};
+
+	/// <summary>
+	///		Holds a ReadWriteLock's shared lock for its lifetime, so the
+	///		release can't be missed on an early return or exception.
+	/// </summary>
+	template<ReadWriteLock L>
+	class SharedLockGuard
+	{
+		public:
+			~SharedLockGuard()
+			{
+				if (m_ownsLock)
+					m_lock.ReleaseSharedLock();
+			}
+
+			/// <summary>
+			///		Blocks until the shared lock is acquired.
+			/// </summary>
+			SharedLockGuard(L& lock)
+			:	m_lock(lock),
+				m_ownsLock(true)
+			{
+				m_lock.AcquireSharedLock();
+			}
+
+			/// <summary>
+			///		Attempts to acquire the shared lock without blocking;
+			///		check OwnsLock() for the result.
+			/// </summary>
+			SharedLockGuard(L& lock, std::try_to_lock_t)
+			:	m_lock(lock),
+				m_ownsLock(lock.TryAcquireSharedLock())
+			{ }
+
+		// Non-copyable, non-movable: the guard is tied to its scope
+		public:
+			SharedLockGuard(const SharedLockGuard&) = delete;
+			SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+			SharedLockGuard(SharedLockGuard&&) noexcept = delete;
+			SharedLockGuard& operator=(SharedLockGuard&&) noexcept = delete;
+
+		public:
+			bool OwnsLock() const noexcept
+			{
+				return m_ownsLock;
+			}
+
+		protected:
+			L& m_lock;
+			bool m_ownsLock;
+	};
+
+	/// <summary>
+	///		Holds a ReadWriteLock's exclusive lock for its lifetime, so the
+	///		release can't be missed on an early return or exception.
+	/// </summary>
+	template<ReadWriteLock L>
+	class ExclusiveLockGuard
+	{
+		public:
+			~ExclusiveLockGuard()
+			{
+				if (m_ownsLock)
+					m_lock.ReleaseExclusiveLock();
+			}
+
+			/// <summary>
+			///		Blocks until the exclusive lock is acquired.
+			/// </summary>
+			ExclusiveLockGuard(L& lock)
+			:	m_lock(lock),
+				m_ownsLock(true)
+			{
+				m_lock.AcquireExclusiveLock();
+			}
+
+			/// <summary>
+			///		Attempts to acquire the exclusive lock without blocking;
+			///		check OwnsLock() for the result.
+			/// </summary>
+			ExclusiveLockGuard(L& lock, std::try_to_lock_t)
+			:	m_lock(lock),
+				m_ownsLock(lock.TryAcquireExclusiveLock())
+			{ }
+
+		// Non-copyable, non-movable: the guard is tied to its scope
+		public:
+			ExclusiveLockGuard(const ExclusiveLockGuard&) = delete;
+			ExclusiveLockGuard& operator=(const ExclusiveLockGuard&) = delete;
+			ExclusiveLockGuard(ExclusiveLockGuard&&) noexcept = delete;
+			ExclusiveLockGuard& operator=(ExclusiveLockGuard&&) noexcept = delete;
+
+		public:
+			bool OwnsLock() const noexcept
+			{
+				return m_ownsLock;
+			}
+
+		protected:
+			L& m_lock;
+			bool m_ownsLock;
+	};
+}
\ No newline at end of file
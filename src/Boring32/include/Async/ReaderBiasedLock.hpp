@@ -0,0 +1,112 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A reader-writer lock for read-mostly data, with the same interface
+	///		as SlimReadWriteLock. Rather than every reader updating one shared
+	///		lock word, each reader counts itself in one of a set of cache-line
+	///		sized stripes chosen by its thread ID, so readers on different
+	///		cores rarely touch the same line. A writer revokes the readers'
+	///		fast path by raising a flag, then waits for every stripe to drain,
+	///		which makes writes more expensive than with an SRW lock. Readers
+	///		that arrive while a writer is active park until it finishes, so
+	///		writers are not starved. As with SlimReadWriteLock, a thread that
+	///		holds the exclusive lock may acquire it again, but one release
+	///		frees it. Neither lock may be acquired shared by a thread that
+	///		already holds it exclusively.
+	/// </summary>
+	class ReaderBiasedLock
+	{
+		public:
+			static constexpr size_t DefaultStripeCount = 64;
+
+		public:
+			virtual ~ReaderBiasedLock();
+			ReaderBiasedLock();
+
+			/// <param name="stripeCount">
+			///		The number of reader stripes; must be a power of two. More
+			///		stripes mean less contention between readers, but more for
+			///		a writer to scan.
+			/// </param>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if stripeCount is not a power of two.
+			/// </exception>
+			ReaderBiasedLock(const size_t stripeCount);
+
+		// Non-copyable, non-movable: threads park on the addresses of its members
+		public:
+			ReaderBiasedLock(const ReaderBiasedLock&) = delete;
+			virtual ReaderBiasedLock& operator=(const ReaderBiasedLock&) = delete;
+			ReaderBiasedLock(ReaderBiasedLock&&) noexcept = delete;
+			virtual ReaderBiasedLock& operator=(ReaderBiasedLock&&) noexcept = delete;
+
+		public:
+			virtual bool TryAcquireSharedLock();
+			virtual bool TryAcquireExclusiveLock();
+
+			virtual void AcquireSharedLock();
+			virtual void AcquireExclusiveLock();
+
+			virtual void ReleaseSharedLock();
+			virtual void ReleaseExclusiveLock();
+
+		public:
+			// Lowercase forms for the standard SharedLockable requirements.
+			void lock_shared()
+			{
+				AcquireSharedLock();
+			}
+
+			bool try_lock_shared()
+			{
+				return TryAcquireSharedLock();
+			}
+
+			void unlock_shared()
+			{
+				ReleaseSharedLock();
+			}
+
+			void lock()
+			{
+				AcquireExclusiveLock();
+			}
+
+			bool try_lock()
+			{
+				return TryAcquireExclusiveLock();
+			}
+
+			void unlock()
+			{
+				ReleaseExclusiveLock();
+			}
+
+		protected:
+			struct alignas(64) Stripe
+			{
+				std::atomic<uint32_t> Readers;
+			};
+
+			virtual Stripe& GetStripe() const noexcept;
+			// Undoes a reader's count on a stripe, waking a writer draining it.
+			virtual void LeaveStripe(Stripe& stripe) noexcept;
+
+		protected:
+			std::unique_ptr<Stripe[]> m_stripes;
+			size_t m_stripeMask;
+			// Serialises writers, which keeps waiting writers off the stripes.
+			SRWLOCK m_writerLock;
+			// Atomic, as other threads read it to check they aren't the owner.
+			std::atomic<DWORD> m_threadOwningExclusiveLock;
+			// Non-zero while a writer holds or is acquiring the lock. On its
+			// own cache line, as every reader reads it.
+			alignas(64) std::atomic<uint32_t> m_writerActive;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "MemoryMappedView.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		The shared-memory layout behind a SeqLockView.
+	/// </summary>
+	template<typename T>
+	struct alignas(64) SeqLockState
+	{
+		static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+		// Odd while a write is in progress.
+		std::atomic<uint64_t> Sequence;
+		// The value is copied in and out a word at a time with atomic
+		// accesses, so a reader racing a writer sees torn data it will
+		// discard rather than undefined behaviour.
+		std::atomic<uint64_t> Words[WordCount];
+	};
+
+	/// <summary>
+	///		A value of type T in shared memory, protected by a sequence lock:
+	///		a single writer publishes new versions, and any number of reader
+	///		processes take consistent snapshots without locking or entering
+	///		the kernel. A reader that overlaps a write retries. Suits small,
+	///		frequently polled state such as counters. There must only be one
+	///		writer at a time across all processes; serialise writers with a
+	///		Mutex if there can be more. A writer that dies mid-write leaves the
+	///		sequence odd, after which Read() never returns and TryRead() always
+	///		fails, so pollers that must survive this should use TryRead().
+	/// </summary>
+	template<typename T>
+	requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+	class SeqLockView
+	{
+		public:
+			/// <summary>
+			///		The number of failed attempts after which a reader yields
+			///		its timeslice to let the writer finish.
+			/// </summary>
+			static constexpr size_t SpinCount = 64;
+
+		public:
+			virtual ~SeqLockView() = default;
+
+			/// <param name="name">The name of the shared memory.</param>
+			/// <param name="create">
+			///		Whether to create the shared memory, starting at a
+			///		zeroed T, or open it.
+			/// </param>
+			SeqLockView(const std::wstring& name, const bool create, const bool inheritable)
+			:	m_view(name, create, inheritable),
+				m_state(m_view.GetView())
+			{ }
+
+		// Non-copyable, non-movable: m_state points into m_view's mapping
+		public:
+			SeqLockView(const SeqLockView&) = delete;
+			virtual SeqLockView& operator=(const SeqLockView&) = delete;
+			SeqLockView(SeqLockView&&) noexcept = delete;
+			virtual SeqLockView& operator=(SeqLockView&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Publishes a new value. Must only be called by the writer.
+			/// </summary>
+			virtual void Write(const T& value) noexcept
+			{
+				uint64_t words[State::WordCount]{};
+				std::memcpy(words, &value, sizeof(T));
+
+				const uint64_t sequence = m_state->Sequence.load(std::memory_order_relaxed);
+				m_state->Sequence.store(sequence + 1, std::memory_order_relaxed);
+				// Keeps the data stores from moving ahead of the odd sequence.
+				std::atomic_thread_fence(std::memory_order_release);
+				for (size_t i = 0; i < State::WordCount; i++)
+					m_state->Words[i].store(words[i], std::memory_order_relaxed);
+				m_state->Sequence.store(sequence + 2, std::memory_order_release);
+			}
+
+			/// <summary>
+			///		Applies update to the current value and publishes the
+			///		result. Must only be called by the writer.
+			/// </summary>
+			template<typename F>
+			void Update(const F& update)
+			{
+				T value = ReadUnsynchronised();
+				update(value);
+				Write(value);
+			}
+
+			/// <summary>
+			///		Takes a consistent snapshot, retrying while a write is in
+			///		progress.
+			/// </summary>
+			virtual T Read() const noexcept
+			{
+				T value;
+				uint64_t version = 0;
+				ReadSpinning(value, version);
+				return value;
+			}
+
+			/// <summary>
+			///		Makes one attempt at a consistent snapshot.
+			/// </summary>
+			/// <param name="version">
+			///		Receives the version of the snapshot, which increases
+			///		with each write.
+			/// </param>
+			/// <returns>False if a write overlapped the attempt.</returns>
+			virtual bool TryRead(T& value, uint64_t& version) const noexcept
+			{
+				const uint64_t before = m_state->Sequence.load(std::memory_order_acquire);
+				if (before & 1)
+					return false;
+				uint64_t words[State::WordCount];
+				for (size_t i = 0; i < State::WordCount; i++)
+					words[i] = m_state->Words[i].load(std::memory_order_relaxed);
+				// Keeps the data loads from moving past the second sequence load.
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (m_state->Sequence.load(std::memory_order_relaxed) != before)
+					return false;
+				std::memcpy(&value, words, sizeof(T));
+				version = before / 2;
+				return true;
+			}
+
+			/// <summary>
+			///		Takes a snapshot only if the value has been written since
+			///		lastVersion, so pollers skip the copy when nothing changed.
+			/// </summary>
+			/// <param name="lastVersion">
+			///		The version last seen, updated when a newer snapshot is
+			///		taken. Start at 0 to read the first published value.
+			/// </param>
+			/// <returns>True if value holds a newer snapshot.</returns>
+			virtual bool ReadIfChanged(T& value, uint64_t& lastVersion) const noexcept
+			{
+				// A single load answers the common case where nothing changed.
+				if (GetVersion() <= lastVersion)
+					return false;
+				uint64_t version = 0;
+				ReadSpinning(value, version);
+				lastVersion = version;
+				return true;
+			}
+
+			/// <summary>
+			///		Returns the version of the latest completed write.
+			/// </summary>
+			virtual uint64_t GetVersion() const noexcept
+			{
+				return m_state->Sequence.load(std::memory_order_acquire) / 2;
+			}
+
+		protected:
+			using State = SeqLockState<T>;
+
+			virtual void ReadSpinning(T& value, uint64_t& version) const noexcept
+			{
+				for (size_t attempts = 1; TryRead(value, version) == false; attempts++)
+				{
+					if (attempts % SpinCount == 0)
+						SwitchToThread();
+					else
+						YieldProcessor();
+				}
+			}
+
+			// Only the writer may read without checking the sequence, as
+			// nothing else changes the value under it.
+			virtual T ReadUnsynchronised() const noexcept
+			{
+				uint64_t words[State::WordCount];
+				for (size_t i = 0; i < State::WordCount; i++)
+					words[i] = m_state->Words[i].load(std::memory_order_relaxed);
+				T value;
+				std::memcpy(&value, words, sizeof(T));
+				return value;
+			}
+
+		protected:
+			MemoryMappedView<State> m_view;
+			State* m_state;
+	};
+}
\ No newline at end of file
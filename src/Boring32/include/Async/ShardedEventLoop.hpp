@@ -0,0 +1,116 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Event.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		An event loop without the MAXIMUM_WAIT_OBJECTS limit of EventLoop.
+	///		Handles are spread across shards of up to 63 handles, each serviced
+	///		by its own waiter thread that also runs the handlers for its
+	///		handles. Each shard keeps a slot map from handle to wait index, so
+	///		registration, removal and dispatch are O(1) regardless of how many
+	///		handles are registered. Shards are created on demand.
+	/// </summary>
+	class ShardedEventLoop
+	{
+		public:
+			/// <summary>
+			///		The number of handles each shard waits on, excluding its
+			///		own wake event.
+			/// </summary>
+			static constexpr DWORD HandlesPerShard = MAXIMUM_WAIT_OBJECTS - 1;
+
+		public:
+			virtual ~ShardedEventLoop();
+			ShardedEventLoop();
+
+		// Non-copyable, non-movable: shard threads hold a pointer to the loop
+		public:
+			ShardedEventLoop(const ShardedEventLoop&) = delete;
+			virtual ShardedEventLoop& operator=(const ShardedEventLoop&) = delete;
+			ShardedEventLoop(ShardedEventLoop&&) noexcept = delete;
+			virtual ShardedEventLoop& operator=(ShardedEventLoop&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Stops and joins all shard threads and drops all handlers.
+			/// </summary>
+			virtual void Close();
+
+			/// <summary>
+			///		Registers a handler to run on a shard thread each time the
+			///		handle is signalled. Does not wait for the shard to pick up
+			///		the registration.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the handle is null or already registered.
+			/// </exception>
+			virtual void On(HANDLE handle, std::function<void()> handler);
+
+			/// <summary>
+			///		Unregisters a handle. When called from outside a handler, this
+			///		returns once the owning shard has dropped the handle, so the
+			///		handler is guaranteed not to be running or to run again.
+			///		When called from a handler on any shard, this returns without
+			///		waiting, as two shards erasing each other's handles would
+			///		otherwise wait on each other forever; a handle on another
+			///		shard may then still be dispatched once more.
+			/// </summary>
+			/// <returns>True if the handle was registered.</returns>
+			virtual bool Erase(HANDLE handle);
+
+			virtual size_t Size() noexcept;
+			virtual size_t GetShardCount() noexcept;
+
+		protected:
+			struct Change
+			{
+				bool IsAdd = false;
+				HANDLE Handle = nullptr;
+				std::function<void()> Handler;
+			};
+
+			struct Shard
+			{
+				std::thread Thread;
+				Event Wake;
+				// Guards Pending, RequestedGeneration and IsStopping.
+				SRWLOCK Lock = SRWLOCK_INIT;
+				std::vector<Change> Pending;
+				uint32_t RequestedGeneration = 0;
+				bool IsStopping = false;
+				// Published after each batch of changes is applied.
+				std::atomic<uint32_t> AppliedGeneration = 0;
+				// Owned by the shard thread. Index 0 is the wake event.
+				std::vector<HANDLE> Handles;
+				std::vector<std::function<void()>> Handlers;
+				std::unordered_map<HANDLE, size_t> Slots;
+				// Guarded by the loop's lock.
+				size_t Registered = 0;
+				bool HasSpace = true;
+			};
+
+			virtual Shard& GetShardWithSpace();
+			// Must be called with the loop's lock held.
+			virtual bool IsShardThread() const noexcept;
+			virtual uint32_t QueueChange(Shard& shard, Change change);
+			virtual void Run(Shard& shard);
+			virtual bool ApplyChanges(Shard& shard);
+			virtual void Dispatch(Shard& shard, const size_t index) noexcept;
+
+		protected:
+			SRWLOCK m_lock;
+			// Shared so an Erase() waiting on a shard keeps it alive if the
+			// loop is closed meanwhile.
+			std::vector<std::shared_ptr<Shard>> m_shards;
+			std::vector<size_t> m_shardsWithSpace;
+			std::unordered_map<HANDLE, size_t> m_registry;
+	};
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "OffsetPtr.hpp"
+#include "SharedMemoryArena.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		FNV-1a over a key's bytes. Unlike std::hash, this gives the same
+	///		result in every process, which a map shared between processes
+	///		built from different binaries relies on.
+	/// </summary>
+	template<typename K>
+	requires std::has_unique_object_representations_v<K>
+	struct SharedHash
+	{
+		uint64_t operator()(const K& key) const noexcept
+		{
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&key);
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < sizeof(K); i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	};
+
+	/// <summary>
+	///		An open-addressing hash map that lives in a SharedMemoryArena and
+	///		can be searched in place by any process that maps the arena.
+	///		Operations that allocate take the arena. Keys and values must not
+	///		need destroying, and the hash must give the same result in every
+	///		process. Storage left behind when the map grows stays in the
+	///		arena, so Reserve() up front where the size is known. Not
+	///		synchronised: build the map in one process, then publish it with
+	///		SetRoot().
+	/// </summary>
+	template<typename K, typename V, typename Hash = SharedHash<K>>
+	requires std::is_trivially_destructible_v<K> && std::is_trivially_destructible_v<V>
+	class SharedHashMap
+	{
+		public:
+			SharedHashMap() noexcept
+			:	m_slots(),
+				m_size(0),
+				m_capacity(0)
+			{ }
+
+			SharedHashMap(SharedHashMap&& other) noexcept
+			:	m_slots(other.m_slots),
+				m_size(other.m_size),
+				m_capacity(other.m_capacity)
+			{
+				other.m_slots = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+			}
+
+			SharedHashMap& operator=(SharedHashMap&& other) noexcept
+			{
+				m_slots = other.m_slots;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				other.m_slots = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+				return *this;
+			}
+
+		// Non-copyable: copies would share storage
+		public:
+			SharedHashMap(const SharedHashMap&) = delete;
+			SharedHashMap& operator=(const SharedHashMap&) = delete;
+
+		public:
+			/// <summary>
+			///		Ensures room for count entries without rehashing.
+			/// </summary>
+			/// <exception cref="std::bad_alloc">Thrown if the arena is full.</exception>
+			void Reserve(SharedMemoryArena& arena, const size_t count)
+			{
+				// Keeps the load factor at or below 3/4.
+				size_t capacity = m_capacity == 0 ? 8 : static_cast<size_t>(m_capacity);
+				while (count * 4 > capacity * 3)
+					capacity *= 2;
+				if (capacity > m_capacity)
+					Rehash(arena, capacity);
+			}
+
+			/// <summary>
+			///		Inserts an entry if the key is not already present.
+			/// </summary>
+			/// <returns>The key's value, and whether it was inserted.</returns>
+			template<typename...Args>
+			std::pair<V*, bool> TryEmplace(SharedMemoryArena& arena, const K& key, Args&&... args)
+			{
+				if (V* existing = Find(key))
+					return { existing, false };
+				Reserve(arena, static_cast<size_t>(m_size) + 1);
+				Slot& slot = m_slots[Probe(key)];
+				new (slot.Key) K(key);
+				V* value = new (slot.Value) V(std::forward<Args>(args)...);
+				slot.IsOccupied = 1;
+				m_size++;
+				return { value, true };
+			}
+
+			V* Find(const K& key) const noexcept
+			{
+				if (m_size == 0)
+					return nullptr;
+				Slot& slot = m_slots[Probe(key)];
+				return slot.IsOccupied ? GetValue(slot) : nullptr;
+			}
+
+			bool Contains(const K& key) const noexcept
+			{
+				return Find(key) != nullptr;
+			}
+
+			/// <summary>
+			///		Calls callback(const K&, V&) for each entry, in no
+			///		particular order.
+			/// </summary>
+			template<typename F>
+			void ForEach(const F& callback) const
+			{
+				for (size_t i = 0; i < m_capacity; i++)
+				{
+					Slot& slot = m_slots[i];
+					if (slot.IsOccupied)
+						callback(*GetKey(slot), *GetValue(slot));
+				}
+			}
+
+			size_t Size() const noexcept
+			{
+				return static_cast<size_t>(m_size);
+			}
+
+			bool Empty() const noexcept
+			{
+				return m_size == 0;
+			}
+
+		protected:
+			// Arena memory is zeroed, so a new table starts with every slot
+			// free without being initialised.
+			struct Slot
+			{
+				alignas(K) std::byte Key[sizeof(K)];
+				alignas(V) std::byte Value[sizeof(V)];
+				uint8_t IsOccupied;
+			};
+
+			static K* GetKey(Slot& slot) noexcept
+			{
+				return std::launder(reinterpret_cast<K*>(slot.Key));
+			}
+
+			static V* GetValue(Slot& slot) noexcept
+			{
+				return std::launder(reinterpret_cast<V*>(slot.Value));
+			}
+
+			/// <summary>
+			///		Returns the index of the key's slot, or of the free slot
+			///		it would go in. The table is never full, so this ends.
+			/// </summary>
+			size_t Probe(const K& key) const noexcept
+			{
+				const size_t mask = static_cast<size_t>(m_capacity) - 1;
+				size_t index = static_cast<size_t>(Hash()(key)) & mask;
+				while (m_slots[index].IsOccupied && (*GetKey(m_slots[index]) == key) == false)
+					index = (index + 1) & mask;
+				return index;
+			}
+
+			void Rehash(SharedMemoryArena& arena, const size_t capacity)
+			{
+				Slot* slots = static_cast<Slot*>(arena.Allocate(sizeof(Slot) * capacity, alignof(Slot)));
+				Slot* old = m_slots.Get();
+				const size_t oldCapacity = static_cast<size_t>(m_capacity);
+				m_slots = slots;
+				m_capacity = capacity;
+				for (size_t i = 0; i < oldCapacity; i++)
+				{
+					if (old[i].IsOccupied == false)
+						continue;
+					Slot& slot = m_slots[Probe(*GetKey(old[i]))];
+					new (slot.Key) K(std::move(*GetKey(old[i])));
+					new (slot.Value) V(std::move(*GetValue(old[i])));
+					slot.IsOccupied = 1;
+				}
+			}
+
+		protected:
+			OffsetPtr<Slot> m_slots;
+			uint64_t m_size;
+			uint64_t m_capacity;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <new>
+#include <string>
+#include <utility>
+#include "MemoryMappedFile.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A bump allocator over a named MemoryMappedFile, for building data
+	///		structures that other processes map and read in place. Objects are
+	///		linked with OffsetPtr, and a process finds them through the root
+	///		object. Allocation is lock-free and safe from any process with
+	///		write access, but memory is never freed; it is reclaimed when the
+	///		last process closes the mapping. Allocated memory is always zeroed.
+	/// </summary>
+	class SharedMemoryArena
+	{
+		public:
+			virtual ~SharedMemoryArena();
+
+			/// <summary>
+			///		Creates the arena's shared memory.
+			/// </summary>
+			/// <param name="size">
+			///		The size of the mapping, including the arena's header.
+			/// </param>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if size is too small to hold the header.
+			/// </exception>
+			SharedMemoryArena(
+				const std::wstring& name,
+				const UINT size,
+				const bool inheritable
+			);
+
+			/// <summary>
+			///		Opens an arena created by another process.
+			/// </summary>
+			/// <param name="desiredAccess">
+			///		FILE_MAP_READ for processes that only read from the arena,
+			///		or FILE_MAP_ALL_ACCESS to allocate from it.
+			/// </param>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the mapping is not an initialised arena.
+			/// </exception>
+			SharedMemoryArena(
+				const std::wstring& name,
+				const UINT size,
+				const bool inheritable,
+				const DWORD desiredAccess
+			);
+
+		// Non-copyable, non-movable: pointers into the arena are handed out
+		public:
+			SharedMemoryArena(const SharedMemoryArena&) = delete;
+			virtual SharedMemoryArena& operator=(const SharedMemoryArena&) = delete;
+			SharedMemoryArena(SharedMemoryArena&&) noexcept = delete;
+			virtual SharedMemoryArena& operator=(SharedMemoryArena&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Allocates zeroed memory from the arena.
+			/// </summary>
+			/// <param name="alignment">A power of two no greater than 4096.</param>
+			/// <exception cref="std::bad_alloc">
+			///		Thrown if the arena is full.
+			/// </exception>
+			virtual void* Allocate(const size_t size, const size_t alignment);
+
+			/// <summary>
+			///		Allocates and constructs an object in the arena. The object
+			///		is never destroyed, so it should not own process-local
+			///		resources.
+			/// </summary>
+			template<typename T, typename...Args>
+			T* Construct(Args&&... args)
+			{
+				void* memory = Allocate(sizeof(T), alignof(T));
+				return new (memory) T(std::forward<Args>(args)...);
+			}
+
+			/// <summary>
+			///		Publishes the object other processes find with GetRoot().
+			///		Everything the object refers to must be built first.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if root is not in the arena.
+			/// </exception>
+			virtual void SetRoot(const void* root);
+
+			/// <summary>
+			///		Gets the object published with SetRoot(), or nullptr.
+			/// </summary>
+			template<typename T>
+			T* GetRoot() const noexcept
+			{
+				return static_cast<T*>(GetRootPointer());
+			}
+
+			virtual bool Contains(const void* pointer) const noexcept;
+			virtual size_t GetUsedBytes() const noexcept;
+			virtual size_t GetSize() const noexcept;
+			virtual const std::wstring& GetName() const noexcept;
+
+		protected:
+			struct Header
+			{
+				std::atomic<uint32_t> Magic;
+				uint32_t Reserved;
+				uint64_t Size;
+				// The offset from the base of the next free byte.
+				std::atomic<uint64_t> Next;
+				// The offset from the base of the root object, or 0.
+				std::atomic<uint64_t> Root;
+			};
+			static constexpr uint32_t HeaderMagic = 0x41423332;// "B32A"
+
+			virtual void Attach(const UINT size);
+			virtual void* GetRootPointer() const noexcept;
+
+		protected:
+			MemoryMappedFile m_mapping;
+			Header* m_header;
+			std::byte* m_base;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <span>
+#include <string>
+#include <vector>
+#include "Event.hpp"
+#include "MemoryMappedFile.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A cross-process message channel laid out in a MemoryMappedFile.
+	///		Messages are variable-length records in a ring buffer; sending
+	///		and receiving only touch shared memory, and the named events are
+	///		only signalled when the other side is blocked waiting. There is
+	///		a single receiver, and either a single sender or many senders,
+	///		as chosen by the process that creates the channel. The creating
+	///		process is usually the receiver.
+	/// </summary>
+	class SharedMemoryChannel
+	{
+		public:
+			enum class Mode : uint32_t
+			{
+				SingleProducer = 1,
+				MultiProducer = 2
+			};
+
+			static constexpr size_t CacheLineSize = 64;
+			// Each record starts with an 8-byte header and is padded to a
+			// multiple of 8 bytes, so headers are always aligned.
+			static constexpr size_t RecordHeaderSize = sizeof(uint64_t);
+			static constexpr size_t RecordAlignment = sizeof(uint64_t);
+
+		public:
+			virtual ~SharedMemoryChannel();
+
+			/// <summary>
+			///		Creates the channel's shared memory and events.
+			/// </summary>
+			/// <param name="name">
+			///		The name of the mapping. The events are named after it.
+			/// </param>
+			/// <param name="capacity">
+			///		The size of the ring in bytes; must be a power of two of
+			///		at least 64.
+			/// </param>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if capacity is out of range.
+			/// </exception>
+			SharedMemoryChannel(
+				const std::wstring& name,
+				const UINT capacity,
+				const Mode mode,
+				const bool inheritable
+			);
+
+			/// <summary>
+			///		Opens a channel created by another process.
+			/// </summary>
+			/// <param name="capacity">
+			///		The capacity the channel was created with.
+			/// </param>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the mapping is not an initialised channel of
+			///		the given capacity.
+			/// </exception>
+			SharedMemoryChannel(
+				const std::wstring& name,
+				const UINT capacity,
+				const bool inheritable
+			);
+
+		// Non-copyable, non-movable: the view is shared with other processes
+		public:
+			SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+			virtual SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+			SharedMemoryChannel(SharedMemoryChannel&&) noexcept = delete;
+			virtual SharedMemoryChannel& operator=(SharedMemoryChannel&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Attempts to send a message without blocking.
+			/// </summary>
+			/// <returns>True if the message was sent, false if the ring is full.</returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the message is larger than GetMaxMessageSize().
+			/// </exception>
+			virtual bool TrySend(std::span<const std::byte> message);
+
+			/// <summary>
+			///		Sends a message, blocking while the ring is full.
+			/// </summary>
+			/// <param name="millis">
+			///		The period in milliseconds to wait, or INFINITE.
+			/// </param>
+			/// <returns>True if the message was sent, false if the timeout elapsed.</returns>
+			virtual bool Send(std::span<const std::byte> message, const DWORD millis);
+
+			/// <summary>
+			///		Attempts to receive a message without blocking. Must only
+			///		be called by the receiver.
+			/// </summary>
+			/// <returns>True if a message was received, false if the ring is empty.</returns>
+			virtual bool TryReceive(std::vector<std::byte>& message);
+
+			/// <summary>
+			///		Receives a message, blocking while the ring is empty.
+			/// </summary>
+			/// <param name="millis">
+			///		The period in milliseconds to wait, or INFINITE.
+			/// </param>
+			/// <returns>True if a message was received, false if the timeout elapsed.</returns>
+			virtual bool Receive(std::vector<std::byte>& message, const DWORD millis);
+
+			/// <summary>
+			///		Passes the next message to the callback in place, without
+			///		copying it out of the ring, then frees it. If the callback
+			///		throws, the message stays at the front of the ring.
+			/// </summary>
+			/// <returns>True if a message was consumed, false if the ring is empty.</returns>
+			template<typename F>
+			bool TryConsume(const F& callback)
+			{
+				std::span<const std::byte> message;
+				uint64_t recordSize = 0;
+				if (Peek(message, recordSize) == false)
+					return false;
+				callback(message);
+				Free(recordSize);
+				return true;
+			}
+
+			/// <summary>
+			///		Returns the approximate number of bytes, including record
+			///		headers and padding, waiting to be received.
+			/// </summary>
+			virtual size_t GetUsedBytes() const noexcept;
+
+			virtual size_t GetCapacity() const noexcept;
+			virtual size_t GetMaxMessageSize() const noexcept;
+			virtual const std::wstring& GetName() const noexcept;
+
+		protected:
+			struct Header
+			{
+				std::atomic<uint32_t> Magic;
+				uint32_t Mode;
+				uint32_t Capacity;
+				// The next byte to be claimed by a sender.
+				alignas(CacheLineSize) std::atomic<uint64_t> WritePosition;
+				// The next byte to be received.
+				alignas(CacheLineSize) std::atomic<uint64_t> ReadPosition;
+				alignas(CacheLineSize) std::atomic<uint32_t> ReceiverWaiting;
+				std::atomic<uint32_t> SendersWaiting;
+			};
+			static constexpr uint32_t HeaderMagic = 0x52423332;// "B32R"
+			static constexpr uint64_t CommittedFlag = 1ull << 32;
+			static constexpr uint64_t PaddingFlag = 1ull << 33;
+			static constexpr uint64_t LengthMask = 0xFFFFFFFFull;
+
+			static UINT GetMappingSize(const UINT capacity);
+			static uint64_t GetRecordSize(const uint64_t length) noexcept;
+			virtual void Attach(const UINT capacity);
+			virtual bool Peek(std::span<const std::byte>& message, uint64_t& recordSize);
+			virtual void Free(const uint64_t recordSize);
+			virtual void Notify(std::atomic<uint32_t>& waiters, Event& event);
+			virtual uint64_t* GetRecord(const uint64_t position) const noexcept;
+
+			template<typename F>
+			bool BlockUntil(
+				const F& attempt,
+				std::atomic<uint32_t>& waiters,
+				Event& event,
+				const DWORD millis
+			)
+			{
+				if (attempt())
+					return true;
+				const ULONGLONG deadline = millis == INFINITE ? 0 : GetTickCount64() + millis;
+				while (true)
+				{
+					waiters.fetch_add(1, std::memory_order_seq_cst);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					// Recheck after announcing ourselves; pairs with the
+					// fence in Notify() so a concurrent operation is never missed.
+					bool succeeded = attempt();
+					if (succeeded == false)
+					{
+						DWORD remaining = INFINITE;
+						if (millis != INFINITE)
+						{
+							const ULONGLONG now = GetTickCount64();
+							if (now >= deadline)
+							{
+								waiters.fetch_sub(1, std::memory_order_seq_cst);
+								return false;
+							}
+							remaining = static_cast<DWORD>(deadline - now);
+						}
+						try
+						{
+							event.WaitOnEvent(remaining, false);
+						}
+						catch (...)
+						{
+							waiters.fetch_sub(1, std::memory_order_seq_cst);
+							throw;
+						}
+					}
+					waiters.fetch_sub(1, std::memory_order_seq_cst);
+					if (succeeded == false)
+						succeeded = attempt();
+					if (succeeded)
+					{
+						// The events are auto-reset and only wake one waiter,
+						// so pass the wake on to the next sender in line.
+						if (waiters.load(std::memory_order_seq_cst) > 0)
+							event.Signal();
+						return true;
+					}
+				}
+			}
+
+		protected:
+			std::wstring m_name;
+			MemoryMappedFile m_mapping;
+			Header* m_header;
+			std::byte* m_ring;
+			uint64_t m_mask;
+			bool m_isMultiProducer;
+			Event m_notEmpty;
+			Event m_notFull;
+	};
+}
\ No newline at end of file
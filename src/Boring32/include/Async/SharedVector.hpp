@@ -0,0 +1,160 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "OffsetPtr.hpp"
+#include "SharedMemoryArena.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A vector that lives in a SharedMemoryArena and can be read in place
+	///		by any process that maps the arena. Operations that allocate take
+	///		the arena, as the vector itself can't hold a process-local pointer
+	///		to it. Elements may themselves be shared containers, but must not
+	///		need destroying, as arena memory is never freed; storage left
+	///		behind when the vector grows stays in the arena, so Reserve()
+	///		up front where the size is known. Not synchronised: build the
+	///		vector in one process, then publish it with SetRoot().
+	/// </summary>
+	template<typename T>
+	requires std::is_trivially_destructible_v<T>
+	class SharedVector
+	{
+		public:
+			SharedVector() noexcept
+			:	m_data(),
+				m_size(0),
+				m_capacity(0)
+			{ }
+
+			/// <summary>
+			///		Takes over other's elements. Used when a vector of vectors
+			///		grows.
+			/// </summary>
+			SharedVector(SharedVector&& other) noexcept
+			:	m_data(other.m_data),
+				m_size(other.m_size),
+				m_capacity(other.m_capacity)
+			{
+				other.m_data = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+			}
+
+			SharedVector& operator=(SharedVector&& other) noexcept
+			{
+				m_data = other.m_data;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				other.m_data = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+				return *this;
+			}
+
+		// Non-copyable: copies would share storage
+		public:
+			SharedVector(const SharedVector&) = delete;
+			SharedVector& operator=(const SharedVector&) = delete;
+
+		public:
+			/// <summary>
+			///		Ensures room for capacity elements without reallocating.
+			/// </summary>
+			/// <exception cref="std::bad_alloc">Thrown if the arena is full.</exception>
+			void Reserve(SharedMemoryArena& arena, const size_t capacity)
+			{
+				if (capacity <= m_capacity)
+					return;
+				T* data = static_cast<T*>(arena.Allocate(sizeof(T) * capacity, alignof(T)));
+				T* old = m_data.Get();
+				if constexpr (std::is_trivially_copyable_v<T>)
+				{
+					if (m_size > 0)
+						std::memcpy(data, old, sizeof(T) * m_size);
+				}
+				else
+				{
+					for (uint64_t i = 0; i < m_size; i++)
+						new (&data[i]) T(std::move(old[i]));
+				}
+				m_data = data;
+				m_capacity = capacity;
+			}
+
+			template<typename...Args>
+			T& EmplaceBack(SharedMemoryArena& arena, Args&&... args)
+			{
+				if (m_size == m_capacity)
+					Reserve(arena, m_capacity == 0 ? 4 : static_cast<size_t>(m_capacity) * 2);
+				T* element = new (&m_data[static_cast<size_t>(m_size)]) T(std::forward<Args>(args)...);
+				m_size++;
+				return *element;
+			}
+
+			T& PushBack(SharedMemoryArena& arena, const T& value) requires std::copy_constructible<T>
+			{
+				return EmplaceBack(arena, value);
+			}
+
+			/// <summary>
+			///		Empties the vector, keeping its storage.
+			/// </summary>
+			void Clear() noexcept
+			{
+				m_size = 0;
+			}
+
+			/// <exception cref="std::out_of_range">Thrown if index is out of range.</exception>
+			T& At(const size_t index) const
+			{
+				if (index >= m_size)
+					throw std::out_of_range(__FUNCSIG__ ": index is out of range");
+				return m_data[index];
+			}
+
+			T& operator[](const size_t index) const noexcept
+			{
+				return m_data[index];
+			}
+
+			T* Data() const noexcept
+			{
+				return m_data.Get();
+			}
+
+			T* begin() const noexcept
+			{
+				return m_data.Get();
+			}
+
+			T* end() const noexcept
+			{
+				return m_data.Get() + m_size;
+			}
+
+			size_t Size() const noexcept
+			{
+				return static_cast<size_t>(m_size);
+			}
+
+			size_t Capacity() const noexcept
+			{
+				return static_cast<size_t>(m_capacity);
+			}
+
+			bool Empty() const noexcept
+			{
+				return m_size == 0;
+			}
+
+		protected:
+			OffsetPtr<T> m_data;
+			uint64_t m_size;
+			uint64_t m_capacity;
+	};
+}
\ No newline at end of file
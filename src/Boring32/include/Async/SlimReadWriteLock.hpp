@@ -1,5 +1,6 @@
 #pragma once
 #include <Windows.h>
+#include <cstdint>
 
 namespace Boring32::Async
 {
@@ -26,8 +27,14 @@ namespace Boring32::Async
 			SlimReadWriteLock(SlimReadWriteLock&&) noexcept = delete;
 			virtual void operator=(SlimReadWriteLock&&) noexcept = delete;
 
+		protected:
+			virtual void RecordAcquisition(const uint64_t start, const bool isContended, const void* callSite);
+
 		protected:
 			SRWLOCK m_srwLock;
 			DWORD m_threadOwningExclusiveLock;
+			// When the exclusive lock was acquired, if LockProfiler was
+			// enabled; otherwise 0.
+			uint64_t m_exclusiveProfiledAt;
 	};
 }
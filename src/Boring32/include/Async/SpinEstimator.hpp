@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		Tunes how long a waiter spins before falling back to a more
+	///		expensive wait. It keeps a moving average of the spins that recent
+	///		successful waits needed, and the spin limit is twice that plus a
+	///		small floor, capped at a maximum. Waits that outlast the limit pull
+	///		the average down, so waiters give up sooner. Safe to share between
+	///		threads; concurrent updates may overwrite each other, which only
+	///		costs a sample.
+	/// </summary>
+	class SpinEstimator
+	{
+		public:
+			/// <summary>
+			///		The fewest spins the limit allows before the maximum.
+			/// </summary>
+			static constexpr uint32_t MinSpins = 16;
+
+		public:
+			virtual ~SpinEstimator();
+
+			/// <param name="maxSpins">
+			///		The upper bound on the spin limit. Pass 0 to never spin.
+			/// </param>
+			SpinEstimator(const uint32_t maxSpins);
+
+		// Non-copyable, non-movable: shared by the threads that spin
+		public:
+			SpinEstimator(const SpinEstimator&) = delete;
+			virtual SpinEstimator& operator=(const SpinEstimator&) = delete;
+			SpinEstimator(SpinEstimator&&) noexcept = delete;
+			virtual SpinEstimator& operator=(SpinEstimator&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Returns the number of spins to attempt before giving up.
+			/// </summary>
+			virtual uint32_t GetLimit() const noexcept;
+
+			/// <summary>
+			///		Records a wait that succeeded after the given number of
+			///		spins.
+			/// </summary>
+			virtual void Succeeded(const uint32_t spins) noexcept;
+
+			/// <summary>
+			///		Records a wait that spun up to the limit without
+			///		succeeding.
+			/// </summary>
+			virtual void Failed() noexcept;
+
+			virtual uint32_t GetEstimate() const noexcept;
+			virtual uint32_t GetMaxSpins() const noexcept;
+
+		protected:
+			std::atomic<uint32_t> m_estimate;
+			uint32_t m_maxSpins;
+	};
+}
\ No newline at end of file
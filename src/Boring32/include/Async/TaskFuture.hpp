@@ -0,0 +1,187 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <exception>
+#include <stdexcept>
+#include <type_traits>
+#include <Windows.h>
+#include "AsyncFuncs.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		The shared state between a task submitted to a TaskPool and the
+	///		TaskFuture returned to the submitter. Readiness is published via
+	///		an atomic word, and waiters park on it with WaitOnValue(), so no
+	///		kernel object is created per task.
+	/// </summary>
+	class TaskStateBase
+	{
+		public:
+			virtual ~TaskStateBase() = default;
+			TaskStateBase()
+			:	m_ready(0)
+			{ }
+
+		public:
+			virtual void SetException(std::exception_ptr exception)
+			{
+				m_exception = std::move(exception);
+				Publish();
+			}
+
+			virtual bool IsReady() const noexcept
+			{
+				return m_ready.load(std::memory_order_acquire) == 1;
+			}
+
+			virtual bool Wait(const DWORD millis)
+			{
+				if (millis == INFINITE)
+				{
+					while (IsReady() == false)
+						WaitOnValue(m_ready, 0, INFINITE);
+					return true;
+				}
+
+				const ULONGLONG deadline = GetTickCount64() + millis;
+				while (IsReady() == false)
+				{
+					const ULONGLONG now = GetTickCount64();
+					if (now >= deadline)
+						return false;
+					WaitOnValue(m_ready, 0, static_cast<DWORD>(deadline - now));
+				}
+				return true;
+			}
+
+		protected:
+			virtual void Publish() noexcept
+			{
+				m_ready.store(1, std::memory_order_release);
+				WakeAllWaiters(m_ready);
+			}
+
+			virtual void WaitAndRethrow()
+			{
+				Wait(INFINITE);
+				if (m_exception)
+					std::rethrow_exception(m_exception);
+			}
+
+		protected:
+			std::atomic<uint32_t> m_ready;
+			std::exception_ptr m_exception;
+	};
+
+	template<typename T>
+	class TaskState : public TaskStateBase
+	{
+		public:
+			virtual ~TaskState() = default;
+
+		public:
+			virtual void SetValue(T&& value)
+			{
+				m_value.emplace(std::move(value));
+				Publish();
+			}
+
+			virtual T Get()
+			{
+				WaitAndRethrow();
+				return std::move(*m_value);
+			}
+
+		protected:
+			std::optional<T> m_value;
+	};
+
+	template<>
+	class TaskState<void> : public TaskStateBase
+	{
+		public:
+			virtual ~TaskState() = default;
+
+		public:
+			virtual void SetValue()
+			{
+				Publish();
+			}
+
+			virtual void Get()
+			{
+				WaitAndRethrow();
+			}
+	};
+
+	/// <summary>
+	///		A future-like handle to the result of a task submitted to a
+	///		TaskPool. Move-only; Get() may only be called once.
+	/// </summary>
+	template<typename T>
+	class TaskFuture
+	{
+		public:
+			virtual ~TaskFuture() = default;
+			TaskFuture() = default;
+			TaskFuture(std::shared_ptr<TaskState<T>> state)
+			:	m_state(std::move(state))
+			{ }
+
+			TaskFuture(TaskFuture&& other) noexcept = default;
+			virtual TaskFuture& operator=(TaskFuture&& other) noexcept = default;
+
+		// Non-copyable
+		public:
+			TaskFuture(const TaskFuture&) = delete;
+			virtual TaskFuture& operator=(const TaskFuture&) = delete;
+
+		public:
+			/// <summary>
+			///		Whether the task has completed, either with a value or
+			///		an exception.
+			/// </summary>
+			virtual bool IsReady() const noexcept
+			{
+				return m_state && m_state->IsReady();
+			}
+
+			/// <summary>
+			///		Waits for the task to complete.
+			/// </summary>
+			/// <param name="millis">
+			///		The period in milliseconds to wait, or INFINITE.
+			/// </param>
+			/// <returns>
+			///		True if the task completed, false if the timeout elapsed.
+			/// </returns>
+			virtual bool Wait(const DWORD millis)
+			{
+				if (m_state == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": future has no state");
+				return m_state->Wait(millis);
+			}
+
+			/// <summary>
+			///		Waits for the task to complete and returns its result,
+			///		rethrowing any exception the task threw.
+			/// </summary>
+			virtual T Get()
+			{
+				if (m_state == nullptr)
+					throw std::runtime_error(__FUNCSIG__ ": future has no state");
+				std::shared_ptr<TaskState<T>> state = std::move(m_state);
+				return state->Get();
+			}
+
+			virtual bool IsValid() const noexcept
+			{
+				return m_state != nullptr;
+			}
+
+		protected:
+			std::shared_ptr<TaskState<T>> m_state;
+	};
+}
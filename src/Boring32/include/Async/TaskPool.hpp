@@ -0,0 +1,209 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <type_traits>
+#include <Windows.h>
+#include "AsyncFuncs.hpp"
+#include "MoveOnlyTask.hpp"
+#include "TaskFuture.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A work-stealing task pool. Each worker owns a deque; tasks posted
+	///		from a worker go to its own deque and are popped LIFO for cache
+	///		locality, while tasks posted from other threads are distributed
+	///		round-robin. Idle workers steal FIFO from their peers before
+	///		parking on an atomic word, so there is no single global queue
+	///		and no kernel object on the submission path. Workers are plain
+	///		std::threads, so the pool has no dependency on the Win32 thread
+	///		pool. Unlike ThreadPool, tasks are arbitrary move-only callables.
+	/// </summary>
+	class TaskPool
+	{
+		public:
+			/// <summary>
+			///		Stops the pool, after running all queued tasks.
+			/// </summary>
+			virtual ~TaskPool();
+
+			/// <summary>
+			///		Creates a pool with the specified number of workers.
+			/// </summary>
+			/// <param name="threadCount">
+			///		The number of worker threads. Pass 0 to use the number
+			///		of logical processors.
+			/// </param>
+			TaskPool(const DWORD threadCount);
+
+		// Non-copyable, non-movable: workers hold a pointer to the pool
+		public:
+			TaskPool(const TaskPool&) = delete;
+			virtual TaskPool& operator=(const TaskPool&) = delete;
+			TaskPool(TaskPool&&) noexcept = delete;
+			virtual TaskPool& operator=(TaskPool&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Runs all queued tasks, then stops and joins the workers.
+			///		Tasks cannot be posted once the pool is closed.
+			/// </summary>
+			virtual void Close();
+
+			/// <summary>
+			///		Queues a fire-and-forget task. Exceptions escaping the
+			///		task are logged to std::wcerr.
+			/// </summary>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the pool has been closed.
+			/// </exception>
+			virtual void Post(MoveOnlyTask task);
+
+			/// <summary>
+			///		Queues a task and returns a future to its result.
+			///		Exceptions thrown by the task are rethrown by Get().
+			/// </summary>
+			template<typename F>
+			auto Submit(F&& func) -> TaskFuture<std::invoke_result_t<std::decay_t<F>&>>
+			{
+				using ResultType = std::invoke_result_t<std::decay_t<F>&>;
+				auto state = std::make_shared<TaskState<ResultType>>();
+				Post(
+					[state, func = std::forward<F>(func)]() mutable
+					{
+						try
+						{
+							if constexpr (std::is_void_v<ResultType>)
+							{
+								func();
+								state->SetValue();
+							}
+							else
+							{
+								state->SetValue(func());
+							}
+						}
+						catch (...)
+						{
+							state->SetException(std::current_exception());
+						}
+					}
+				);
+				return TaskFuture<ResultType>(std::move(state));
+			}
+
+			/// <summary>
+			///		Calls func(slot, index) for every index in [0, count), spread
+			///		over the workers and the calling thread, and returns once all
+			///		calls have completed. Indices are claimed dynamically, so
+			///		uneven work balances out. slot is in [0, GetThreadCount()]
+			///		and is never used by two calls at once, so it can index
+			///		per-runner state without locking. The calling thread works
+			///		through the indices too, so this also completes when called
+			///		from a worker or when every worker is busy.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if count exceeds UINT32_MAX.
+			/// </exception>
+			/// <remarks>
+			///		Once a call throws, the remaining indices are skipped and the
+			///		first exception is rethrown.
+			/// </remarks>
+			template<typename F>
+			void ParallelFor(const size_t count, F&& func)
+			{
+				if (count == 0)
+					return;
+				if (count > UINT32_MAX)
+					throw std::invalid_argument(__FUNCSIG__ ": count is too large");
+
+				struct State
+				{
+					std::atomic<size_t> Next = 0;
+					std::atomic<uint32_t> Remaining = 0;
+					std::atomic<bool> HasFailed = false;
+					std::exception_ptr Failure;
+				};
+				// Shared, as workers that start after all indices are claimed
+				// may still run after this returns; they only touch State.
+				auto state = std::make_shared<State>();
+				state->Remaining.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
+				auto run = [state, count, &func](const size_t slot)
+				{
+					size_t index = 0;
+					while ((index = state->Next.fetch_add(1, std::memory_order_relaxed)) < count)
+					{
+						if (state->HasFailed.load(std::memory_order_relaxed) == false)
+						{
+							try
+							{
+								func(slot, index);
+							}
+							catch (...)
+							{
+								if (state->HasFailed.exchange(true) == false)
+									state->Failure = std::current_exception();
+							}
+						}
+						if (state->Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+							WakeAllWaiters(state->Remaining);
+					}
+				};
+
+				const size_t helpers = count - 1 < m_queues.size() ? count - 1 : m_queues.size();
+				for (size_t slot = 1; slot <= helpers; slot++)
+				{
+					try
+					{
+						Post([run, slot]() { run(slot); });
+					}
+					catch (...)
+					{
+						// The calling thread picks up whatever isn't claimed.
+						break;
+					}
+				}
+				run(0);
+
+				uint32_t remaining = 0;
+				while ((remaining = state->Remaining.load(std::memory_order_acquire)) != 0)
+					WaitOnValue(state->Remaining, remaining, INFINITE);
+				if (state->HasFailed.load(std::memory_order_acquire))
+					std::rethrow_exception(state->Failure);
+			}
+
+			virtual DWORD GetThreadCount() const noexcept;
+
+			/// <summary>
+			///		Returns the number of tasks queued but not yet started.
+			/// </summary>
+			virtual size_t GetPendingCount() const noexcept;
+
+		protected:
+			struct WorkerQueue
+			{
+				SRWLOCK Lock = SRWLOCK_INIT;
+				std::deque<MoveOnlyTask> Tasks;
+			};
+
+			virtual void Run(const size_t workerIndex);
+			virtual bool TryPop(const size_t workerIndex, MoveOnlyTask& task);
+			virtual bool TrySteal(const size_t thiefIndex, MoveOnlyTask& task);
+			virtual void Execute(MoveOnlyTask& task) noexcept;
+			virtual void WakeWorkers(const bool all) noexcept;
+
+		protected:
+			std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+			std::vector<std::thread> m_workers;
+			std::atomic<uint32_t> m_workSignal;
+			std::atomic<uint32_t> m_sleepingWorkers;
+			std::atomic<size_t> m_pendingTasks;
+			std::atomic<size_t> m_nextQueue;
+			std::atomic<bool> m_isClosing;
+	};
+}
@@ -27,6 +27,13 @@ namespace Boring32::Async
 
 		public:
 			virtual void Close();
+
+			/// <summary>
+			///		Creates a work object for the callback and submits it to
+			///		the pool. The returned work object can be resubmitted, and
+			///		must be closed with CloseThreadpoolWork(). For arbitrary
+			///		callables and futures, see TaskPool.
+			/// </summary>
 			virtual PTP_WORK SubmitWork(
 				ThreadPoolCallback& callback,
 				void* param
@@ -3,7 +3,7 @@
 #include <vector>
 #include <algorithm>
 #include <Windows.h>
-#include "Event.hpp"
+#include "LightweightEvent.hpp"
 #include "CriticalSectionLock.hpp"
 
 namespace Boring32::Async
@@ -18,7 +18,7 @@ namespace Boring32::Async
 			}
 
 			ThreadSafeVector()
-				: m_hasMessages(false, true, false, L"")
+				: m_hasMessages(true, false)
 			{
 				InitializeCriticalSection(&m_criticalSection);
 			}
@@ -194,7 +194,7 @@ namespace Boring32::Async
 
 			virtual HANDLE GetWaitableHandle() noexcept
 			{
-				return m_hasMessages.GetHandle();
+				return m_hasMessages.GetHandle(std::nothrow);
 			}
 
 		protected:
@@ -228,6 +228,6 @@ namespace Boring32::Async
 		protected:
 			std::vector<T> m_collection;
 			CRITICAL_SECTION m_criticalSection;
-			Event m_hasMessages;
+			LightweightEvent m_hasMessages;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+#include <Windows.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "Event.hpp"
+#include "MoveOnlyTask.hpp"
+#include "TaskPool.hpp"
+#include "WaitableTimer.hpp"
+
+namespace Boring32::Async
+{
+	/// <summary>
+	///		A hierarchical timing wheel for large numbers of one-shot timers,
+	///		such as per-connection timeouts that are mostly cancelled before
+	///		they fire. Scheduling, cancelling and rescheduling a timer are O(1)
+	///		and do not touch the kernel; all timers share a single
+	///		WaitableTimer that a driver thread arms for the next due tick.
+	///		Expired tasks are posted to a TaskPool. Timers fire no earlier
+	///		than requested, rounded up to the wheel's resolution.
+	/// </summary>
+	class TimerWheel
+	{
+		public:
+			/// <summary>
+			///		Identifies a scheduled timer. Ids of fired or cancelled
+			///		timers are never reused, so stale ids are safely rejected.
+			/// </summary>
+			using TimerId = uint64_t;
+
+			static constexpr size_t SlotBits = 8;
+			static constexpr size_t SlotsPerLevel = size_t(1) << SlotBits;
+			static constexpr size_t Levels = 4;
+
+		public:
+			/// <summary>
+			///		Stops the driver thread. Pending timers are discarded.
+			/// </summary>
+			virtual ~TimerWheel();
+
+			/// <summary>
+			///		Creates a wheel that posts expired tasks to the pool.
+			/// </summary>
+			/// <param name="pool">
+			///		The pool to run expired tasks on. Must outlive the wheel.
+			/// </param>
+			/// <param name="resolutionMillis">
+			///		The length of one tick in milliseconds. Must not be 0.
+			/// </param>
+			TimerWheel(TaskPool& pool, const DWORD resolutionMillis);
+
+		// Non-copyable, non-movable: the driver thread holds a pointer to the wheel
+		public:
+			TimerWheel(const TimerWheel&) = delete;
+			virtual TimerWheel& operator=(const TimerWheel&) = delete;
+			TimerWheel(TimerWheel&&) noexcept = delete;
+			virtual TimerWheel& operator=(TimerWheel&&) noexcept = delete;
+
+		public:
+			/// <summary>
+			///		Stops and joins the driver thread and discards all pending
+			///		timers. Tasks already posted to the pool are unaffected.
+			/// </summary>
+			virtual void Close();
+
+			/// <summary>
+			///		Schedules a task to be posted to the pool after the delay.
+			/// </summary>
+			/// <exception cref="std::runtime_error">
+			///		Thrown if the wheel has been closed.
+			/// </exception>
+			virtual TimerId Schedule(const DWORD delayMillis, MoveOnlyTask task);
+
+			/// <summary>
+			///		Cancels a pending timer.
+			/// </summary>
+			/// <returns>
+			///		False if the timer has already fired or been cancelled.
+			/// </returns>
+			virtual bool Cancel(const TimerId id);
+
+			/// <summary>
+			///		Moves a pending timer's deadline to the delay from now.
+			/// </summary>
+			/// <returns>
+			///		False if the timer has already fired or been cancelled.
+			/// </returns>
+			virtual bool Reschedule(const TimerId id, const DWORD delayMillis);
+
+			/// <summary>
+			///		Returns the number of pending timers.
+			/// </summary>
+			virtual size_t Size() noexcept;
+
+			virtual DWORD GetResolution() const noexcept;
+
+		protected:
+			static constexpr uint32_t NoNode = UINT32_MAX;
+			static constexpr uint64_t NoDeadline = UINT64_MAX;
+
+			struct TimerNode
+			{
+				MoveOnlyTask Task;
+				uint64_t Expiry = 0;
+				uint32_t Generation = 1;
+				uint32_t Prev = NoNode;
+				uint32_t Next = NoNode;
+				// The wheel slot the node is linked into, or NoNode if free.
+				uint32_t Slot = NoNode;
+			};
+
+			virtual void Run();
+			virtual uint64_t GetCurrentTick() const noexcept;
+			virtual uint64_t ToExpiry(const DWORD delayMillis) const noexcept;
+			virtual TimerNode* Find(const TimerId id) noexcept;
+			virtual void Link(const uint32_t node);
+			virtual void Unlink(const uint32_t node) noexcept;
+			virtual void Free(const uint32_t node) noexcept;
+			virtual void Advance(const uint64_t targetTick, std::vector<MoveOnlyTask>& expired);
+			virtual size_t Cascade(const size_t level);
+			virtual size_t FindOccupiedSlot(const size_t from) const noexcept;
+			virtual uint64_t GetNextDueTick() const noexcept;
+			virtual void ArmTimer(const uint64_t dueTick);
+
+		protected:
+			TaskPool& m_pool;
+			DWORD m_resolution;
+			std::chrono::steady_clock::time_point m_start;
+			// Guards everything below, except the driver-owned m_timer.
+			SRWLOCK m_lock;
+			std::vector<TimerNode> m_nodes;
+			std::vector<uint32_t> m_freeNodes;
+			std::array<uint32_t, Levels * SlotsPerLevel> m_slots;
+			// One bit per level-0 slot, so idle ticks are skipped.
+			std::array<uint64_t, SlotsPerLevel / 64> m_occupied;
+			// Ticks below this have been processed.
+			uint64_t m_currentTick;
+			// The tick the driver's timer is armed for.
+			uint64_t m_armedTick;
+			size_t m_count;
+			bool m_isClosing;
+			Event m_wake;
+			WaitableTimer m_timer;
+			std::thread m_driver;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include "CompressionType.hpp"
+
+namespace Boring32::Compression
+{
+	/// <summary>
+	///		Prefixes buffers produced by Compressor::CompressBufferWithHeader().
+	///		Recording the original size lets the decompressor allocate its
+	///		output exactly and decompress in a single pass, instead of
+	///		probing the compressed data for its size first. Stored
+	///		unaligned, so read and write it with memcpy.
+	/// </summary>
+	struct CompressedHeader
+	{
+		/// <summary>
+		///		"B32C" in little-endian byte order.
+		/// </summary>
+		static constexpr uint32_t Signature = 0x43323342;
+
+		uint32_t Magic = Signature;
+		CompressionType Type = CompressionType::NotSet;
+		uint64_t OriginalSize = 0;
+		uint64_t CompressedSize = 0;
+	};
+}
\ No newline at end of file
@@ -1,4 +1,9 @@
 #pragma once
 #include "CompressionType.hpp"
+#include "CompressedHeader.hpp"
+#include "ICodec.hpp"
+#include "LzCodec.hpp"
 #include "Compressor.hpp"
 #include "Decompressor.hpp"
+#include "StreamCompressor.hpp"
+#include "StreamDecompressor.hpp"
@@ -1,14 +1,22 @@
 #pragma once
-#include <Windows.h>
+#include <cstdint>
 
 namespace Boring32::Compression
 {
-	enum class CompressionType : DWORD
+	/// <summary>
+	///		The algorithm to compress with. The Compression API values match
+	///		the COMPRESS_ALGORITHM_* constants, but this header doesn't include
+	///		Windows.h, so the portable codecs can be built without it.
+	/// </summary>
+	enum class CompressionType : uint32_t
 	{
 		NotSet = 0,
 		MSZIP = 2,
 		XPRESS = 3,
 		XPRESSHuffman = 4,
-		LZMS = 5
+		LZMS = 5,
+		// Values below 0x100 are Compression API algorithms; the
+		// rest are implemented by ICodec types in this library.
+		PortableLZ = 0x100
 	};
 }
\ No newline at end of file
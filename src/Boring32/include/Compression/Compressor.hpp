@@ -1,8 +1,13 @@
 #pragma once
 #include <vector>
+#include <span>
+#include <memory>
 #include <Windows.h>
 #include <compressapi.h>
 #include "CompressionType.hpp"
+#include "CompressedHeader.hpp"
+#include "ICodec.hpp"
+#include "../Async/TaskPool.hpp"
 
 /// <summary>
 /// For reference of the Compression API, see: https://docs.microsoft.com/en-us/windows/win32/cmpapi/using-the-compression-api
@@ -16,8 +21,21 @@ namespace Boring32::Compression
 
 			Compressor();
 
+			/// <summary>
+			///		Creates a compressor for the algorithm. PortableLZ uses the
+			///		built-in LzCodec; the other types use the Compression API.
+			/// </summary>
 			Compressor(const CompressionType type);
 
+			/// <summary>
+			///		Creates a compressor that uses the codec instead of the
+			///		Compression API. Headers record the codec's type.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if codec is null.
+			/// </exception>
+			Compressor(std::unique_ptr<ICodec> codec);
+
 			Compressor(const Compressor& other);
 			virtual Compressor& operator=(const Compressor other);
 
@@ -27,6 +45,8 @@ namespace Boring32::Compression
 		public:
 			/// <summary>
 			///		Returns the size, in bytes, of the compressed buffer specified in the parameter.
+			///		Codec-backed compressors compress the buffer to measure it; use
+			///		GetCompressedBound() to size an output buffer cheaply.
 			/// </summary>
 			/// <param name="buffer">The buffer to determine the compressed size of.</param>
 			/// <returns>The size, in bytes, of the compressed buffer specified in the parameter</returns>
@@ -38,13 +58,62 @@ namespace Boring32::Compression
 			/// <returns>The algorithm used by this compressor.</returns>
 			[[nodiscard]] virtual CompressionType GetType() const;
 
+			/// <summary>
+			///		Returns a conservative upper bound on the compressed size of a buffer of the
+			///		specified size. The Compression API doesn't publish one, so inputs that expand
+			///		beyond it are rare but possible; CompressBuffer() handles these with a second pass.
+			/// </summary>
+			/// <param name="uncompressedSize">The size, in bytes, of the data to compress.</param>
+			/// <returns>The size, in bytes, of an output buffer to compress into.</returns>
+			[[nodiscard]] virtual size_t GetCompressedBound(const size_t uncompressedSize) const noexcept;
+
 			/// <summary>
 			///		Returns a buffer that is the compressed data of the input argument, buffer.
+			///		The data is compressed into a buffer of GetCompressedBound() bytes, which is
+			///		then shrunk, so it is normally only compressed once.
 			/// </summary>
 			/// <param name="buffer">The buffer to compress.</param>
 			/// <returns>The compressed buffer.</returns>
 			[[nodiscard]] virtual std::vector<std::byte> CompressBuffer(const std::vector<std::byte>& buffer);
 
+			/// <summary>
+			///		Compresses the buffer into a caller-supplied output buffer.
+			/// </summary>
+			/// <param name="buffer">The buffer to compress.</param>
+			/// <param name="out">The buffer to receive the compressed data.</param>
+			/// <returns>The number of bytes written to out.</returns>
+			/// <exception cref="Error::Win32Error">
+			///		Thrown with ERROR_INSUFFICIENT_BUFFER if out is too small.
+			/// </exception>
+			virtual size_t CompressBuffer(std::span<const std::byte> buffer, std::span<std::byte> out);
+
+			/// <summary>
+			///		Returns the compressed data prefixed by a CompressedHeader, for use with 
+			///		Decompressor::DecompressBufferWithHeader().
+			/// </summary>
+			/// <param name="buffer">The buffer to compress.</param>
+			/// <returns>The header followed by the compressed data.</returns>
+			[[nodiscard]] virtual std::vector<std::byte> CompressBufferWithHeader(std::span<const std::byte> buffer);
+
+			/// <summary>
+			///		Splits the buffer into blocks and compresses them independently on the pool,
+			///		with one compressor per runner. The result is a sequence of frames, each a 
+			///		CompressedHeader followed by a compressed block, in the same format that 
+			///		StreamCompressor produces. Decompress it with 
+			///		Decompressor::DecompressBufferParallel() or StreamDecompressor.
+			/// </summary>
+			/// <param name="buffer">The buffer to compress.</param>
+			/// <param name="blockSize">
+			///		The size, in bytes, of each independently compressed block.
+			/// </param>
+			/// <param name="pool">The pool to compress on.</param>
+			/// <returns>The frames, in order.</returns>
+			[[nodiscard]] virtual std::vector<std::byte> CompressBufferParallel(
+				std::span<const std::byte> buffer,
+				const size_t blockSize,
+				Async::TaskPool& pool
+			);
+
 			/// <summary>
 			///		Releases all resources associated with this object.
 			/// </summary>
@@ -57,8 +126,20 @@ namespace Boring32::Compression
 			virtual void Move(Compressor& other) noexcept;
 			virtual void Copy(const Compressor& other);
 
+			/// <summary>
+			///		Compresses in a single call. Returns false if out is too small, in which case
+			///		written receives the required size.
+			/// </summary>
+			virtual bool TryCompress(
+				std::span<const std::byte> buffer, 
+				std::span<std::byte> out, 
+				size_t& written
+			) const;
+
 		protected:
 			CompressionType m_type;
 			COMPRESSOR_HANDLE m_compressor;
+			// Used instead of m_compressor when set.
+			std::unique_ptr<ICodec> m_codec;
 	};
 }
\ No newline at end of file
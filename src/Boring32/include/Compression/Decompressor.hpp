@@ -1,7 +1,13 @@
 #pragma once
 #include <vector>
+#include <span>
+#include <memory>
+#include <Windows.h>
 #include <compressapi.h>
 #include "CompressionType.hpp"
+#include "CompressedHeader.hpp"
+#include "ICodec.hpp"
+#include "../Async/TaskPool.hpp"
 
 namespace Boring32::Compression
 {
@@ -17,8 +23,21 @@ namespace Boring32::Compression
 			Decompressor(Decompressor&& other) noexcept;
 			virtual Decompressor& operator=(Decompressor&& other) noexcept;
 
+			/// <summary>
+			///		Creates a decompressor for the algorithm. PortableLZ uses the
+			///		built-in LzCodec; the other types use the Compression API.
+			/// </summary>
 			Decompressor(const CompressionType type);
 
+			/// <summary>
+			///		Creates a decompressor that uses the codec instead of the
+			///		Compression API.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if codec is null.
+			/// </exception>
+			Decompressor(std::unique_ptr<ICodec> codec);
+
 		public:
 			virtual void Close();
 
@@ -42,13 +61,61 @@ namespace Boring32::Compression
 			/// <returns>The decompressed buffer.</returns>
 			[[nodiscard]] virtual std::vector<std::byte> DecompressBuffer(const std::vector<std::byte>& compressedBuffer);
 
+			/// <summary>
+			///		Decompresses the buffer into a caller-supplied output buffer.
+			/// </summary>
+			/// <param name="compressedBuffer">The buffer to decompress.</param>
+			/// <param name="out">The buffer to receive the decompressed data.</param>
+			/// <returns>The number of bytes written to out.</returns>
+			/// <exception cref="Error::Win32Error">
+			///		Thrown with ERROR_INSUFFICIENT_BUFFER if out is too small.
+			/// </exception>
+			virtual size_t DecompressBuffer(std::span<const std::byte> compressedBuffer, std::span<std::byte> out);
+
+			/// <summary>
+			///		Decompresses a buffer produced by Compressor::CompressBufferWithHeader(). The
+			///		output is sized from the header, so the data is decompressed in a single pass.
+			/// </summary>
+			/// <param name="compressedBuffer">The header followed by the compressed data.</param>
+			/// <returns>The decompressed buffer.</returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the header is missing or malformed, or was written by a compressor
+			///		of a different type.
+			/// </exception>
+			[[nodiscard]] virtual std::vector<std::byte> DecompressBufferWithHeader(std::span<const std::byte> compressedBuffer);
+
+			/// <summary>
+			///		Decompresses a sequence of frames, as produced by 
+			///		Compressor::CompressBufferParallel() or StreamCompressor, on the pool. The
+			///		frame headers are scanned first to size the output, and each frame is then
+			///		decompressed directly into its place in it, with one decompressor per runner.
+			/// </summary>
+			/// <param name="frames">The frames to decompress.</param>
+			/// <param name="pool">The pool to decompress on.</param>
+			/// <returns>The decompressed data.</returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if any frame is malformed or truncated, or was written by a 
+			///		compressor of a different type.
+			/// </exception>
+			[[nodiscard]] virtual std::vector<std::byte> DecompressBufferParallel(
+				std::span<const std::byte> frames, 
+				Async::TaskPool& pool
+			);
+
 		protected:
 			virtual void Create();
 			virtual void Copy(const Decompressor& other);
 			virtual void Move(Decompressor& other) noexcept;
 
+			/// <summary>
+			///		Reads and validates the header at the start of the buffer.
+			/// </summary>
+			virtual CompressedHeader ReadHeader(std::span<const std::byte> compressedBuffer) const;
+
 		protected:
 			CompressionType m_type;
 			DECOMPRESSOR_HANDLE m_decompressor;
+			// Used instead of m_decompressor when set.
+			std::unique_ptr<ICodec> m_codec;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <memory>
+#include <span>
+#include "CompressionType.hpp"
+
+namespace Boring32::Compression
+{
+	/// <summary>
+	///		A compression algorithm that Compressor and Decompressor can use
+	///		in place of the Windows Compression API. Codecs must be
+	///		self-describing, i.e. their output must record the original size,
+	///		in the same way as the Compression API's buffer mode. An instance
+	///		is used by one thread at a time, so it may keep scratch state.
+	/// </summary>
+	class ICodec
+	{
+		public:
+			virtual ~ICodec() = default;
+
+		public:
+			/// <summary>
+			///		Returns the type recorded in frame headers for this codec.
+			///		Custom codecs should use values of 0x100 and above.
+			/// </summary>
+			virtual CompressionType GetType() const noexcept = 0;
+
+			/// <summary>
+			///		Returns an independent instance of this codec.
+			/// </summary>
+			virtual std::unique_ptr<ICodec> Clone() const = 0;
+
+			/// <summary>
+			///		Returns the largest possible compressed size of a buffer of 
+			///		the specified size.
+			/// </summary>
+			virtual size_t GetCompressedBound(const size_t uncompressedSize) const noexcept = 0;
+
+			/// <summary>
+			///		Compresses the buffer into out.
+			/// </summary>
+			/// <returns>
+			///		False if out is too small, in which case written receives
+			///		a size that is large enough.
+			/// </returns>
+			virtual bool TryCompress(
+				std::span<const std::byte> buffer, 
+				std::span<std::byte> out, 
+				size_t& written
+			) = 0;
+
+			/// <summary>
+			///		Returns the original size recorded in compressed data.
+			/// </summary>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the data is malformed.
+			/// </exception>
+			virtual size_t GetDecompressedSize(std::span<const std::byte> compressedBuffer) const = 0;
+
+			/// <summary>
+			///		Decompresses the buffer into out.
+			/// </summary>
+			/// <returns>
+			///		False if out is too small, in which case written receives
+			///		the required size.
+			/// </returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the data is malformed.
+			/// </exception>
+			virtual bool TryDecompress(
+				std::span<const std::byte> compressedBuffer, 
+				std::span<std::byte> out, 
+				size_t& written
+			) = 0;
+	};
+}
\ No newline at end of file
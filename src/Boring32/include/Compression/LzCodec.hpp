@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "ICodec.hpp"
+
+namespace Boring32::Compression
+{
+	/// <summary>
+	///		A fast LZ77 codec in the style of LZ4, written in portable C++ so
+	///		it behaves identically on any platform. The output is the original
+	///		size as a little-endian uint64, followed by sequences of a token
+	///		byte (4 bits of literal length, 4 bits of match length), the
+	///		literals, and a 16-bit little-endian match offset. Lengths of 15
+	///		or more continue in following bytes, each adding up to 255.
+	///		Matches are at least 4 bytes and the stream ends with literals.
+	///		It favours speed over ratio; use LZMS or XPRESSHuffman for better
+	///		compression.
+	/// </summary>
+	class LzCodec : public ICodec
+	{
+		public:
+			virtual ~LzCodec();
+			LzCodec();
+
+			LzCodec(const LzCodec& other) = default;
+			virtual LzCodec& operator=(const LzCodec& other) = default;
+
+		public:
+			virtual CompressionType GetType() const noexcept override;
+			virtual std::unique_ptr<ICodec> Clone() const override;
+			virtual size_t GetCompressedBound(const size_t uncompressedSize) const noexcept override;
+			virtual bool TryCompress(
+				std::span<const std::byte> buffer, 
+				std::span<std::byte> out, 
+				size_t& written
+			) override;
+			virtual size_t GetDecompressedSize(std::span<const std::byte> compressedBuffer) const override;
+			virtual bool TryDecompress(
+				std::span<const std::byte> compressedBuffer, 
+				std::span<std::byte> out, 
+				size_t& written
+			) override;
+
+		protected:
+			static constexpr size_t HashBits = 14;
+			static constexpr size_t SizeHeaderLength = sizeof(uint64_t);
+
+			// Maps the hash of 4 bytes to the last position they were seen at.
+			std::array<uint32_t, size_t(1) << HashBits> m_table;
+	};
+}
\ No newline at end of file
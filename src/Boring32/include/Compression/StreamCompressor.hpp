@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+#include "CompressionType.hpp"
+#include "Compressor.hpp"
+
+namespace Boring32::Compression
+{
+	/// <summary>
+	///		Compresses a stream of data in fixed-size blocks, so only one
+	///		block of input has to be held in memory at a time. Each block is
+	///		compressed independently and emitted as a frame: a CompressedHeader
+	///		followed by the compressed data, i.e. exactly what
+	///		Compressor::CompressBufferWithHeader() produces. A stream is the
+	///		concatenation of its frames, which can be located from their
+	///		headers or from GetFrameIndex() and decompressed individually.
+	/// </summary>
+	class StreamCompressor
+	{
+		public:
+			/// <summary>
+			///		Where a frame lies in the compressed stream, and which
+			///		range of the original data it holds.
+			/// </summary>
+			struct FrameLocation
+			{
+				uint64_t CompressedOffset = 0;
+				uint64_t CompressedSize = 0;
+				uint64_t OriginalOffset = 0;
+				uint64_t OriginalSize = 0;
+			};
+
+			/// <summary>
+			///		The block size used when none is given.
+			/// </summary>
+			static constexpr size_t DefaultBlockSize = 1024 * 1024;
+
+		public:
+			virtual ~StreamCompressor();
+
+			/// <summary>
+			///		Creates a stream compressor with DefaultBlockSize blocks.
+			/// </summary>
+			/// <param name="type">The compression algorithm to use.</param>
+			StreamCompressor(const CompressionType type);
+
+			/// <summary>
+			///		Creates a stream compressor.
+			/// </summary>
+			/// <param name="type">The compression algorithm to use.</param>
+			/// <param name="blockSize">
+			///		The size, in bytes, of the blocks that are compressed
+			///		independently. Larger blocks compress better; smaller
+			///		blocks use less memory and give finer random access.
+			/// </param>
+			StreamCompressor(const CompressionType type, const size_t blockSize);
+
+			StreamCompressor(const StreamCompressor& other) = delete;
+			virtual StreamCompressor& operator=(const StreamCompressor& other) = delete;
+
+			StreamCompressor(StreamCompressor&& other) noexcept = default;
+			virtual StreamCompressor& operator=(StreamCompressor&& other) noexcept = default;
+
+		public:
+			/// <summary>
+			///		Appends data to the stream. A frame is emitted each time a
+			///		block fills up; whole blocks are compressed straight from
+			///		data without being copied.
+			/// </summary>
+			virtual void Write(std::span<const std::byte> data);
+
+			/// <summary>
+			///		Compresses any buffered partial block into a frame. Call
+			///		this at the end of the stream.
+			/// </summary>
+			virtual void Flush();
+
+			/// <summary>
+			///		Removes the next completed frame from the stream.
+			/// </summary>
+			/// <returns>False if no frame is ready.</returns>
+			virtual bool Read(std::vector<std::byte>& frame);
+
+			/// <summary>
+			///		Returns the location of every frame emitted so far.
+			/// </summary>
+			virtual const std::vector<FrameLocation>& GetFrameIndex() const noexcept;
+
+			virtual size_t GetBlockSize() const noexcept;
+
+		protected:
+			virtual void EmitFrame(std::span<const std::byte> block);
+
+		protected:
+			Compressor m_compressor;
+			size_t m_blockSize;
+			std::vector<std::byte> m_block;
+			std::deque<std::vector<std::byte>> m_frames;
+			std::vector<FrameLocation> m_index;
+			uint64_t m_compressedOffset;
+			uint64_t m_originalOffset;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "CompressionType.hpp"
+#include "CompressedHeader.hpp"
+#include "Decompressor.hpp"
+
+namespace Boring32::Compression
+{
+	/// <summary>
+	///		Decompresses a stream produced by StreamCompressor. Compressed
+	///		data can be written in chunks of any size; each frame is only
+	///		decompressed once it has been fully written and is read, so at
+	///		most one frame of input and one block of output are held at a
+	///		time.
+	/// </summary>
+	class StreamDecompressor
+	{
+		public:
+			/// <summary>
+			///		The largest frame accepted when no limit is given.
+			/// </summary>
+			static constexpr size_t DefaultMaxFrameSize = 64 * 1024 * 1024;
+
+		public:
+			virtual ~StreamDecompressor();
+
+			/// <summary>
+			///		Creates a stream decompressor that accepts frames of up
+			///		to DefaultMaxFrameSize bytes.
+			/// </summary>
+			/// <param name="type">The compression algorithm of the stream.</param>
+			StreamDecompressor(const CompressionType type);
+
+			/// <summary>
+			///		Creates a stream decompressor.
+			/// </summary>
+			/// <param name="type">The compression algorithm of the stream.</param>
+			/// <param name="maxFrameSize">
+			///		The largest compressed or decompressed frame accepted, in
+			///		bytes, which guards against corrupt headers.
+			/// </param>
+			StreamDecompressor(const CompressionType type, const size_t maxFrameSize);
+
+			StreamDecompressor(const StreamDecompressor& other) = delete;
+			virtual StreamDecompressor& operator=(const StreamDecompressor& other) = delete;
+
+			StreamDecompressor(StreamDecompressor&& other) noexcept = default;
+			virtual StreamDecompressor& operator=(StreamDecompressor&& other) noexcept = default;
+
+		public:
+			/// <summary>
+			///		Appends compressed data to the stream.
+			/// </summary>
+			virtual void Write(std::span<const std::byte> data);
+
+			/// <summary>
+			///		Decompresses the next frame, if it has been fully written.
+			/// </summary>
+			/// <returns>False if no complete frame is buffered.</returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the stream is corrupt.
+			/// </exception>
+			virtual bool Read(std::vector<std::byte>& block);
+
+			/// <summary>
+			///		Decompresses a single frame, such as one located through
+			///		StreamCompressor::GetFrameIndex(), independently of the
+			///		rest of the stream.
+			/// </summary>
+			[[nodiscard]] virtual std::vector<std::byte> DecompressFrame(std::span<const std::byte> frame);
+
+			/// <summary>
+			///		Returns the number of compressed bytes written but not yet
+			///		consumed. Non-zero at the end of a stream indicates that it
+			///		was truncated.
+			/// </summary>
+			virtual size_t GetBufferedSize() const noexcept;
+
+			/// <summary>
+			///		Reads a frame header from the start of the buffer.
+			/// </summary>
+			/// <returns>False if the buffer is too small to hold a header.</returns>
+			/// <exception cref="std::invalid_argument">
+			///		Thrown if the buffer does not start with a header.
+			/// </exception>
+			static bool TryReadHeader(std::span<const std::byte> buffer, CompressedHeader& header);
+
+		protected:
+			Decompressor m_decompressor;
+			size_t m_maxFrameSize;
+			std::vector<std::byte> m_input;
+			size_t m_inputOffset;
+	};
+}
\ No newline at end of file
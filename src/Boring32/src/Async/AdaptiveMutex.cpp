@@ -0,0 +1,93 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/AdaptiveMutex.hpp"
+
+namespace Boring32::Async
+{
+	AdaptiveMutex::~AdaptiveMutex() { }
+
+	AdaptiveMutex::AdaptiveMutex()
+	:	AdaptiveMutex(DefaultMaxSpins)
+	{ }
+
+	AdaptiveMutex::AdaptiveMutex(const uint32_t maxSpins)
+	:	m_state(Unlocked),
+		m_spins(maxSpins)
+	{ }
+
+	bool AdaptiveMutex::Lock(const DWORD waitTime)
+	{
+		if (TryLock())
+			return true;
+		if (Spin())
+			return true;
+		if (waitTime == 0)
+			return false;
+		return Park(waitTime);
+	}
+
+	bool AdaptiveMutex::TryLock() noexcept
+	{
+		uint32_t expected = Unlocked;
+		return m_state.compare_exchange_strong(
+			expected,
+			Locked,
+			std::memory_order_acquire,
+			std::memory_order_relaxed
+		);
+	}
+
+	void AdaptiveMutex::Unlock()
+	{
+		const uint32_t previous = m_state.exchange(Unlocked, std::memory_order_release);
+		if (previous == Unlocked)
+			throw std::runtime_error(__FUNCSIG__ ": the mutex is not locked");
+		// Only pay for the wake syscall if someone may be parked.
+		if (previous == Contended)
+			WakeOneWaiter(m_state);
+	}
+
+	bool AdaptiveMutex::IsLocked() const noexcept
+	{
+		return m_state.load(std::memory_order_relaxed) != Unlocked;
+	}
+
+	bool AdaptiveMutex::Spin() noexcept
+	{
+		const uint32_t limit = m_spins.GetLimit();
+		for (uint32_t spins = 0; spins < limit; spins++)
+		{
+			YieldProcessor();
+			// Spin on a plain load so waiting threads don't steal the
+			// cache line from the owner.
+			if (m_state.load(std::memory_order_relaxed) != Unlocked || TryLock() == false)
+				continue;
+			m_spins.Succeeded(spins);
+			return true;
+		}
+		m_spins.Failed();
+		return false;
+	}
+
+	bool AdaptiveMutex::Park(const DWORD waitTime)
+	{
+		const ULONGLONG deadline = waitTime == INFINITE ? 0 : GetTickCount64() + waitTime;
+		// Marking the mutex contended before parking tells the owner to wake
+		// us. If the exchange finds it unlocked, we have acquired it, though
+		// it stays marked contended, which costs at most one spurious wake.
+		while (m_state.exchange(Contended, std::memory_order_acquire) != Unlocked)
+		{
+			DWORD remaining = INFINITE;
+			if (waitTime != INFINITE)
+			{
+				const ULONGLONG now = GetTickCount64();
+				if (now >= deadline)
+					return false;
+				remaining = static_cast<DWORD>(deadline - now);
+			}
+			WaitOnValue(m_state, Contended, remaining);
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -138,4 +138,32 @@ namespace Boring32::Async
 
 		return false;
 	}
+
+	bool WaitOnValue(
+		std::atomic<uint32_t>& value,
+		const uint32_t undesiredValue,
+		const DWORD timeout
+	)
+	{
+		// https://docs.microsoft.com/en-us/windows/win32/api/synchapi/nf-synchapi-waitonaddress
+		uint32_t compareValue = undesiredValue;
+		if (::WaitOnAddress(&value, &compareValue, sizeof(compareValue), timeout))
+			return true;
+		const DWORD lastError = GetLastError();
+		if (lastError == ERROR_TIMEOUT)
+			return false;
+		throw Error::Win32Error(__FUNCSIG__ ": WaitOnAddress() failed", lastError);
+	}
+
+	void WakeOneWaiter(std::atomic<uint32_t>& value) noexcept
+	{
+		// https://docs.microsoft.com/en-us/windows/win32/api/synchapi/nf-synchapi-wakebyaddresssingle
+		::WakeByAddressSingle(&value);
+	}
+
+	void WakeAllWaiters(std::atomic<uint32_t>& value) noexcept
+	{
+		// https://docs.microsoft.com/en-us/windows/win32/api/synchapi/nf-synchapi-wakebyaddressall
+		::WakeByAddressAll(&value);
+	}
 }
\ No newline at end of file
@@ -1,17 +1,41 @@
 #include "pch.hpp"
 #include <stdexcept>
+#include <intrin.h>
 #include "include/Async/CriticalSectionLock.hpp"
+#include "include/Async/LockProfiler.hpp"
 
 namespace Boring32::Async
 {
 	CriticalSectionLock::CriticalSectionLock(CRITICAL_SECTION& criticalSection)
-		: m_criticalSection(criticalSection)
+		: m_criticalSection(criticalSection),
+		m_profiledAt(0)
 	{
-		EnterCriticalSection(&m_criticalSection);
+		if (LockProfiler::IsEnabled() == false)
+		{
+			EnterCriticalSection(&m_criticalSection);
+			return;
+		}
+
+		const uint64_t start = LockProfiler::Now();
+		const bool isContended = TryEnterCriticalSection(&m_criticalSection) == false;
+		if (isContended)
+			EnterCriticalSection(&m_criticalSection);
+		m_profiledAt = LockProfiler::Now();
+		// Profiles are keyed by the critical section, which outlives this guard.
+		LockProfiler::RecordAcquisition(
+			&m_criticalSection,
+			L"CriticalSection",
+			L"",
+			m_profiledAt - start,
+			isContended ? _ReturnAddress() : nullptr
+		);
 	}
 
 	CriticalSectionLock::~CriticalSectionLock()
 	{
+		const uint64_t releasedAt = m_profiledAt ? LockProfiler::Now() : 0;
 		LeaveCriticalSection(&m_criticalSection);
+		if (m_profiledAt)
+			LockProfiler::RecordRelease(&m_criticalSection, releasedAt - m_profiledAt);
 	}
 }
\ No newline at end of file
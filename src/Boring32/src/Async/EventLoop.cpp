@@ -1,5 +1,6 @@
 #include "pch.hpp"
-#include <algorithm>
+#include <stdexcept>
+#include <string>
 #include "include/Async/CriticalSectionLock.hpp"
 #include "include/Error/Error.hpp"
 #include "include/Async/EventLoop.hpp"
@@ -12,74 +13,240 @@ namespace Boring32::Async
 	}
 	
 	EventLoop::EventLoop() 
+	:	m_nextDispatch(1),
+		m_hasPending(false),
+		m_wake(false, false, false)
 	{
 		InitializeCriticalSection(&m_cs);
+		m_events.push_back(m_wake.GetHandle());
+		m_handlers.emplace_back();
 	}
 
 	void EventLoop::Close()
 	{
 		m_handlers.clear();
 		m_events.clear();
+		m_slots.clear();
+		m_pending.clear();
+		m_registered.clear();
+		m_wake.Close();
 		DeleteCriticalSection(&m_cs);
 	}
 	
 	bool EventLoop::WaitOn(const DWORD millis, const bool waitAll)
 	{
-		if (m_events.size() == 0)
+		ApplyChanges();
+		if (m_events.size() <= 1)
 			throw std::runtime_error("EventLoop::WaitOn(): m_events is empty");
 
-		CriticalSectionLock cs(m_cs);
-
-		DWORD result = WaitForMultipleObjectsEx((DWORD)m_events.size(), &m_events[0], waitAll, millis, true);
-		if (result == WAIT_FAILED)
-			throw Error::Win32Error("EventLoop::WaitOn(): WaitForMultipleObjectsEx() failed", GetLastError());
-		if (result == WAIT_TIMEOUT)
-			return false;
-		if (result >= WAIT_ABANDONED && result <= (WAIT_ABANDONED + m_events.size() - 1))
-			throw std::runtime_error("EventLoop::WaitOn(): a wait object was abandoned");
-
 		if (waitAll)
 		{
+			// The wake event is left out, as it would have to be signalled
+			// too; queued changes are picked up by the next wait instead.
+			const DWORD count = static_cast<DWORD>(m_events.size() - 1);
+			const DWORD result = WaitForMultipleObjectsEx(count, &m_events[1], true, millis, true);
+			if (result == WAIT_FAILED)
+				throw Error::Win32Error("EventLoop::WaitOn(): WaitForMultipleObjectsEx() failed", GetLastError());
+			if (result == WAIT_TIMEOUT || result == WAIT_IO_COMPLETION)
+				return false;
+			if (result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + count)
+				throw std::runtime_error("EventLoop::WaitOn(): a wait object was abandoned");
+
 			// If we waited for all events to fire, then we need to fire
 			// all functions. This is because WaitForMultipleObjectsEx()
 			// returns only the zero index.
-			for (auto& handler : m_handlers)
-				handler();
+			for (size_t i = 1; i < m_handlers.size(); i++)
+				m_handlers[i]();
+			return true;
 		}
-		else
+
+		const ULONGLONG start = GetTickCount64();
+		while (true)
 		{
-			m_handlers.at(result)();
+			const DWORD count = static_cast<DWORD>(m_events.size());
+			const DWORD result = WaitForMultipleObjectsEx(
+				count, 
+				&m_events[0], 
+				false, 
+				GetRemainingMillis(millis, start), 
+				true
+			);
+			if (result == WAIT_FAILED)
+				throw Error::Win32Error("EventLoop::WaitOn(): WaitForMultipleObjectsEx() failed", GetLastError());
+			if (result == WAIT_TIMEOUT || result == WAIT_IO_COMPLETION)
+				return false;
+			if (result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + count)
+				throw std::runtime_error("EventLoop::WaitOn(): a wait object was abandoned");
+
+			const size_t index = result - WAIT_OBJECT_0;
+			if (index == 0)
+			{
+				ApplyChanges();
+				continue;
+			}
+			m_handlers[index]();
+			return true;
 		}
+	}
+
+	size_t EventLoop::WaitAndDrain(const DWORD millis)
+	{
+		ApplyChanges();
+		if (m_events.size() <= 1)
+			throw std::runtime_error("EventLoop::WaitAndDrain(): m_events is empty");
 
-		return true;
+		// Pick up where the previous call left off, so that handles with a 
+		// higher index get their turn before the lowest signalled one.
+		if (m_nextDispatch >= m_events.size())
+			m_nextDispatch = 1;
+		const size_t cursor = m_nextDispatch;
+		size_t dispatched = DrainRange(cursor, m_events.size());
+		dispatched += DrainRange(1, cursor);
+		if (dispatched > 0)
+			return dispatched;
+
+		const ULONGLONG start = GetTickCount64();
+		while (true)
+		{
+			const DWORD count = static_cast<DWORD>(m_events.size());
+			const DWORD result = WaitForMultipleObjectsEx(
+				count,
+				&m_events[0],
+				false,
+				GetRemainingMillis(millis, start),
+				true
+			);
+			if (result == WAIT_FAILED)
+				throw Error::Win32Error("EventLoop::WaitAndDrain(): WaitForMultipleObjectsEx() failed", GetLastError());
+			if (result == WAIT_TIMEOUT || result == WAIT_IO_COMPLETION)
+				return 0;
+			if (result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + count)
+				throw std::runtime_error("EventLoop::WaitAndDrain(): a wait object was abandoned");
+
+			const size_t index = result - WAIT_OBJECT_0;
+			if (index == 0)
+			{
+				ApplyChanges();
+				continue;
+			}
+
+			m_handlers[index]();
+			m_nextDispatch = index + 1;
+			dispatched = 1 + DrainRange(index + 1, m_events.size());
+			return dispatched + DrainRange(1, index);
+		}
 	}
 	
 	void EventLoop::On(HANDLE handle, std::function<void()> handler)
 	{
+		if (handle == nullptr)
+			throw std::invalid_argument("EventLoop::On(): handle is null");
+
 		CriticalSectionLock cs(m_cs);
-		m_events.push_back(handle);
-		m_handlers.push_back(std::move(handler));
+		if (m_registered.contains(handle))
+			throw std::invalid_argument("EventLoop::On(): handle is already registered");
+		if (m_registered.size() >= MaxHandles)
+			throw std::length_error(
+				"EventLoop::On(): the loop is full; at most "
+				+ std::to_string(MaxHandles)
+				+ " handles can be registered"
+			);
+		m_pending.push_back({ .IsAdd = true, .Handle = handle, .Handler = std::move(handler) });
+		m_registered.insert(handle);
+		m_hasPending.store(true, std::memory_order_release);
+		m_wake.Signal();
 	}
 
 	void EventLoop::Erase(HANDLE handle)
 	{
 		CriticalSectionLock cs(m_cs);
-		std::vector<HANDLE>::iterator handlePosIterator = std::find_if(
-			m_events.begin(), 
-			m_events.end(), 
-			[handle](const auto& elem) { return elem == handle; }
-		);
-		if (handlePosIterator != m_events.end())
-		{
-			std::ptrdiff_t iteratorDist = std::distance(m_events.begin(), handlePosIterator);
-			m_events.erase(handlePosIterator);
-			m_handlers.erase(m_handlers.begin() + iteratorDist);
-		}
+		if (m_registered.erase(handle) == 0)
+			return;
+		m_pending.push_back({ .IsAdd = false, .Handle = handle });
+		m_hasPending.store(true, std::memory_order_release);
+		m_wake.Signal();
 	}
 
 	size_t EventLoop::Size() noexcept
 	{
 		CriticalSectionLock cs(m_cs);
-		return m_events.size();
+		return m_registered.size();
+	}
+
+	void EventLoop::ApplyChanges()
+	{
+		if (m_hasPending.load(std::memory_order_acquire) == false)
+			return;
+
+		std::vector<Change> changes;
+		{
+			CriticalSectionLock cs(m_cs);
+			changes.swap(m_pending);
+			m_hasPending.store(false, std::memory_order_relaxed);
+		}
+
+		for (Change& change : changes)
+		{
+			if (change.IsAdd)
+			{
+				m_slots.emplace(change.Handle, m_events.size());
+				m_events.push_back(change.Handle);
+				m_handlers.push_back(std::move(change.Handler));
+				continue;
+			}
+
+			auto slot = m_slots.find(change.Handle);
+			if (slot == m_slots.end())
+				continue;
+			// Swap the last slot into the hole so removal stays O(1).
+			const size_t index = slot->second;
+			const size_t last = m_events.size() - 1;
+			if (index != last)
+			{
+				m_events[index] = m_events[last];
+				m_handlers[index] = std::move(m_handlers[last]);
+				m_slots[m_events[index]] = index;
+			}
+			m_events.pop_back();
+			m_handlers.pop_back();
+			m_slots.erase(slot);
+		}
+	}
+
+	DWORD EventLoop::GetRemainingMillis(const DWORD millis, const ULONGLONG start) const noexcept
+	{
+		if (millis == INFINITE)
+			return INFINITE;
+		const ULONGLONG elapsed = GetTickCount64() - start;
+		return elapsed >= millis ? 0 : static_cast<DWORD>(millis - elapsed);
+	}
+
+	size_t EventLoop::DrainRange(const size_t begin, const size_t end)
+	{
+		size_t dispatched = 0;
+		size_t next = begin;
+		// Stop once a handler queues a change, as it may have erased a 
+		// handle further along the range; the rest is left signalled for 
+		// the next call.
+		while (next < end && m_hasPending.load(std::memory_order_acquire) == false)
+		{
+			// Each poll returns the lowest signalled index in the range, so
+			// this costs one call per dispatched handler plus one.
+			const DWORD count = static_cast<DWORD>(end - next);
+			const DWORD result = WaitForMultipleObjectsEx(count, &m_events[next], false, 0, false);
+			if (result == WAIT_TIMEOUT)
+				break;
+			if (result == WAIT_FAILED)
+				throw Error::Win32Error("EventLoop::DrainRange(): WaitForMultipleObjectsEx() failed", GetLastError());
+			if (result >= WAIT_ABANDONED_0 && result < WAIT_ABANDONED_0 + count)
+				throw std::runtime_error("EventLoop::DrainRange(): a wait object was abandoned");
+
+			const size_t index = next + (result - WAIT_OBJECT_0);
+			m_handlers[index]();
+			dispatched++;
+			m_nextDispatch = index + 1;
+			next = index + 1;
+		}
+		return dispatched;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include <thread>
+#include "include/Error/Win32Error.hpp"
+#include "include/Async/IoOperationPool.hpp"
+
+namespace Boring32::Async
+{
+	std::span<std::byte> IoOperation::GetBuffer() const noexcept
+	{
+		return { Buffer, Length };
+	}
+
+	DWORD IoOperation::GetBytesTransferred() const noexcept
+	{
+		return static_cast<DWORD>(Overlapped.InternalHigh);
+	}
+
+	bool IoOperation::IsComplete() const noexcept
+	{
+		return Overlapped.Internal != STATUS_PENDING;
+	}
+
+	bool IoOperation::IsSuccessful() const noexcept
+	{
+		return Overlapped.Internal == NOERROR;
+	}
+
+	bool IoOperation::IsPartial() const noexcept
+	{
+		return Overlapped.Internal == 0x80000005L;// STATUS_BUFFER_OVERFLOW
+	}
+
+	bool IoOperation::WaitForCompletion(const DWORD timeout) const
+	{
+		if (Event == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": operation is not waitable");
+		const DWORD status = WaitForSingleObject(Event, timeout);
+		if (status == WAIT_OBJECT_0)
+			return true;
+		if (status == WAIT_TIMEOUT)
+			return false;
+		throw Error::Win32Error(__FUNCSIG__ ": WaitForSingleObject() failed", GetLastError());
+	}
+
+	IoOperation* IoOperation::FromOverlapped(OVERLAPPED* overlapped) noexcept
+	{
+		return CONTAINING_RECORD(overlapped, IoOperation, Overlapped);
+	}
+
+	IoOperationPool::~IoOperationPool()
+	{
+		for (Slab& slab : m_slabs)
+		{
+			for (size_t i = 0; i < slab.Count; i++)
+			{
+				if (slab.Operations[i].Event != nullptr)
+					CloseHandle(slab.Operations[i].Event);
+			}
+		}
+	}
+
+	IoOperationPool::IoOperationPool(const DWORD bufferSize, const size_t initialCount)
+	:	m_bufferSize(bufferSize)
+	{
+		if (bufferSize == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": bufferSize must be greater than 0");
+
+		InitializeSRWLock(&m_lock);
+		const size_t processorCount = std::thread::hardware_concurrency();
+		m_lists.resize(processorCount > 0 ? processorCount : 1);
+		if (initialCount > 0)
+		{
+			IoOperation* operation = Grow(initialCount);
+			Push(GetLocalList(), operation, operation);
+		}
+	}
+
+	IoOperation* IoOperationPool::Acquire(const DWORD length)
+	{
+		IoOperation* operation = nullptr;
+		if (length > m_bufferSize)
+		{
+			auto oversized = std::make_unique<IoOperation>();
+			oversized->Buffer = new std::byte[length];
+			oversized->Capacity = length;
+			oversized->IsPooled = false;
+			operation = oversized.release();
+		}
+		else
+		{
+			FreeList& local = GetLocalList();
+			operation = Pop(local);
+			// Operations drift to the lists of the threads that release
+			// them, so take from the other lists before allocating more.
+			for (size_t i = 0; operation == nullptr && i < m_lists.size(); i++)
+			{
+				if (&m_lists[i] != &local)
+					operation = Pop(m_lists[i]);
+			}
+			if (operation == nullptr)
+				operation = Grow(GrowthCount);
+		}
+		Prepare(operation, length);
+		return operation;
+	}
+
+	IoOperation* IoOperationPool::AcquireWaitable(const DWORD length)
+	{
+		IoOperation* operation = Acquire(length);
+		if (operation->Event == nullptr)
+		{
+			operation->Event = CreateEventW(nullptr, true, false, nullptr);
+			if (operation->Event == nullptr)
+			{
+				const DWORD lastError = GetLastError();
+				Release(operation);
+				throw Error::Win32Error(__FUNCSIG__ ": CreateEventW() failed", lastError);
+			}
+		}
+		// The event is reset when the I/O is started.
+		operation->Overlapped.hEvent = operation->Event;
+		return operation;
+	}
+
+	void IoOperationPool::Release(IoOperation* operation) noexcept
+	{
+		if (operation == nullptr)
+			return;
+		if (operation->IsPooled == false)
+		{
+			if (operation->Event != nullptr)
+				CloseHandle(operation->Event);
+			delete[] operation->Buffer;
+			delete operation;
+			return;
+		}
+		operation->Context = 0;
+		Push(GetLocalList(), operation, operation);
+	}
+
+	DWORD IoOperationPool::GetBufferSize() const noexcept
+	{
+		return m_bufferSize;
+	}
+
+	size_t IoOperationPool::GetAllocatedCount() noexcept
+	{
+		AcquireSRWLockShared(&m_lock);
+		size_t count = 0;
+		for (const Slab& slab : m_slabs)
+			count += slab.Count;
+		ReleaseSRWLockShared(&m_lock);
+		return count;
+	}
+
+	IoOperationPool::FreeList& IoOperationPool::GetLocalList() noexcept
+	{
+		return m_lists[GetCurrentProcessorNumber() % m_lists.size()];
+	}
+
+	IoOperation* IoOperationPool::Pop(FreeList& list) noexcept
+	{
+		AcquireSRWLockExclusive(&list.Lock);
+		IoOperation* operation = list.Head;
+		if (operation != nullptr)
+			list.Head = operation->Next;
+		ReleaseSRWLockExclusive(&list.Lock);
+		return operation;
+	}
+
+	void IoOperationPool::Push(FreeList& list, IoOperation* first, IoOperation* last) noexcept
+	{
+		AcquireSRWLockExclusive(&list.Lock);
+		last->Next = list.Head;
+		list.Head = first;
+		ReleaseSRWLockExclusive(&list.Lock);
+	}
+
+	IoOperation* IoOperationPool::Grow(const size_t count)
+	{
+		Slab slab{
+			.Operations = std::make_unique<IoOperation[]>(count),
+			// Left uninitialised; the buffers are overwritten by I/O anyway.
+			.Buffers = std::unique_ptr<std::byte[]>(new std::byte[count * m_bufferSize]),
+			.Count = count
+		};
+		for (size_t i = 0; i < count; i++)
+		{
+			slab.Operations[i].Buffer = slab.Buffers.get() + i * m_bufferSize;
+			slab.Operations[i].Capacity = m_bufferSize;
+			if (i + 1 < count)
+				slab.Operations[i].Next = &slab.Operations[i + 1];
+		}
+		IoOperation* const operations = slab.Operations.get();
+
+		AcquireSRWLockExclusive(&m_lock);
+		try
+		{
+			m_slabs.push_back(std::move(slab));
+		}
+		catch (...)
+		{
+			ReleaseSRWLockExclusive(&m_lock);
+			throw;
+		}
+		ReleaseSRWLockExclusive(&m_lock);
+
+		// The first operation goes to the caller and the rest to the
+		// local list.
+		if (count > 1)
+			Push(GetLocalList(), &operations[1], &operations[count - 1]);
+		return &operations[0];
+	}
+
+	void IoOperationPool::Prepare(IoOperation* operation, const DWORD length) noexcept
+	{
+		operation->Overlapped = {};
+		operation->Length = length;
+		operation->Next = nullptr;
+	}
+}
\ No newline at end of file
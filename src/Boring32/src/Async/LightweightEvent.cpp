@@ -0,0 +1,180 @@
+#include "pch.hpp"
+#include "include/Error/Error.hpp"
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/LightweightEvent.hpp"
+
+namespace Boring32::Async
+{
+	LightweightEvent::~LightweightEvent()
+	{
+		if (HANDLE handle = m_handle.load(std::memory_order_relaxed))
+			CloseHandle(handle);
+	}
+
+	LightweightEvent::LightweightEvent(const bool manualReset, const bool isSignaled)
+	:	m_state(isSignaled ? Signaled : 0),
+		m_waiters(0),
+		m_handle(nullptr),
+		m_isManualReset(manualReset)
+	{ }
+
+	void LightweightEvent::Signal()
+	{
+		uint32_t state = m_state.load(std::memory_order_acquire);
+		do
+		{
+			if (state & KernelMode)
+			{
+				if (SetEvent(m_handle.load(std::memory_order_acquire)) == false)
+					throw Error::Win32Error(__FUNCSIG__ ": SetEvent() failed", GetLastError());
+				return;
+			}
+			if (state & Signaled)
+				return;
+		} while (m_state.compare_exchange_weak(state, state | Signaled, std::memory_order_seq_cst) == false);
+
+		// Either this sees a parked waiter, or the waiter sees the signal
+		// before it parks.
+		if (m_waiters.load(std::memory_order_seq_cst) == 0)
+			return;
+		if (m_isManualReset)
+			WakeAllWaiters(m_state);
+		else
+			WakeOneWaiter(m_state);
+	}
+
+	void LightweightEvent::Reset()
+	{
+		uint32_t state = m_state.load(std::memory_order_acquire);
+		do
+		{
+			if (state & KernelMode)
+			{
+				if (ResetEvent(m_handle.load(std::memory_order_acquire)) == false)
+					throw Error::Win32Error(__FUNCSIG__ ": ResetEvent() failed", GetLastError());
+				return;
+			}
+			if ((state & Signaled) == 0)
+				return;
+		} while (m_state.compare_exchange_weak(state, state & ~Signaled, std::memory_order_relaxed, std::memory_order_acquire) == false);
+	}
+
+	void LightweightEvent::WaitOnEvent()
+	{
+		WaitOnEvent(INFINITE);
+	}
+
+	bool LightweightEvent::WaitOnEvent(const DWORD millis)
+	{
+		const ULONGLONG deadline = millis == INFINITE ? 0 : GetTickCount64() + millis;
+		// Deregisters however we leave, including by WaitOnValue() throwing,
+		// or every later Signal() would pay to wake a waiter that's gone.
+		struct Registration
+		{
+			std::atomic<uint32_t>& Waiters;
+			bool IsWaiting = false;
+
+			void Register()
+			{
+				Waiters.fetch_add(1, std::memory_order_seq_cst);
+				IsWaiting = true;
+			}
+
+			void Deregister()
+			{
+				if (IsWaiting)
+					Waiters.fetch_sub(1, std::memory_order_relaxed);
+				IsWaiting = false;
+			}
+
+			~Registration()
+			{
+				Deregister();
+			}
+		} registration{ m_waiters };
+		while (true)
+		{
+			uint32_t state = m_state.load(std::memory_order_seq_cst);
+			if (state & KernelMode)
+				break;
+			if (state & Signaled)
+			{
+				// Auto-reset events hand the signal to exactly one waiter.
+				if (m_isManualReset || m_state.compare_exchange_strong(state, state & ~Signaled, std::memory_order_acquire))
+					return true;
+				continue;
+			}
+
+			DWORD remaining = INFINITE;
+			if (millis != INFINITE)
+			{
+				const ULONGLONG now = GetTickCount64();
+				if (now >= deadline)
+					return false;
+				remaining = static_cast<DWORD>(deadline - now);
+			}
+			if (registration.IsWaiting == false)
+			{
+				// Registers, then rechecks the state before parking.
+				registration.Register();
+				continue;
+			}
+			WaitOnValue(m_state, state, remaining);
+		}
+
+		// The kernel event took over while we were waiting.
+		registration.Deregister();
+		if (millis == INFINITE)
+			return WaitOnKernelEvent(INFINITE);
+		const ULONGLONG now = GetTickCount64();
+		return WaitOnKernelEvent(now >= deadline ? 0 : static_cast<DWORD>(deadline - now));
+	}
+
+	HANDLE LightweightEvent::GetHandle()
+	{
+		if (HANDLE handle = m_handle.load(std::memory_order_acquire))
+			return handle;
+
+		HANDLE created = CreateEventW(nullptr, m_isManualReset, false, nullptr);
+		if (created == nullptr)
+			throw Error::Win32Error(__FUNCSIG__ ": CreateEventW() failed", GetLastError());
+		HANDLE expected = nullptr;
+		if (m_handle.compare_exchange_strong(expected, created, std::memory_order_acq_rel) == false)
+		{
+			// Another thread created it first.
+			CloseHandle(created);
+			return expected;
+		}
+
+		// Switching modes and taking the signal in one step means a
+		// concurrent Signal() either lands here or goes to the kernel event.
+		const uint32_t state = m_state.exchange(KernelMode, std::memory_order_acq_rel);
+		if ((state & Signaled) && SetEvent(created) == false)
+			throw Error::Win32Error(__FUNCSIG__ ": SetEvent() failed", GetLastError());
+		// Moves threads parked on the state over to the kernel event.
+		WakeAllWaiters(m_state);
+		return created;
+	}
+
+	HANDLE LightweightEvent::GetHandle(std::nothrow_t) noexcept
+	{
+		HANDLE handle = nullptr;
+		Error::TryCatchLogToWCerr([this, &handle] { handle = GetHandle(); }, __FUNCSIG__);
+		return handle;
+	}
+
+	bool LightweightEvent::IsManualReset() const noexcept
+	{
+		return m_isManualReset;
+	}
+
+	bool LightweightEvent::WaitOnKernelEvent(const DWORD millis)
+	{
+		const DWORD result = WaitForSingleObject(m_handle.load(std::memory_order_acquire), millis);
+		if (result == WAIT_OBJECT_0)
+			return true;
+		if (result == WAIT_TIMEOUT)
+			return false;
+		throw Error::Win32Error(__FUNCSIG__ ": WaitForSingleObject() failed", GetLastError());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "pch.hpp"
+#include <climits>
+#include <stdexcept>
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/LightweightSemaphore.hpp"
+
+namespace Boring32::Async
+{
+	LightweightSemaphore::~LightweightSemaphore() { }
+
+	LightweightSemaphore::LightweightSemaphore(const ULONG initialCount, const ULONG maxCount)
+	:	m_count(initialCount),
+		m_waiters(0),
+		m_bulkWaiters(0),
+		m_maxCount(maxCount),
+		m_name(L"")
+	{
+		if (initialCount > maxCount)
+			throw std::invalid_argument(__FUNCSIG__ ": initialCount exceeds maxCount");
+		if (maxCount > LONG_MAX)
+			throw std::invalid_argument(__FUNCSIG__ ": maxCount exceeds LONG_MAX");
+	}
+
+	void LightweightSemaphore::Release()
+	{
+		Release(1);
+	}
+
+	void LightweightSemaphore::Release(const int countToRelease)
+	{
+		if (countToRelease <= 0)
+			throw std::invalid_argument(__FUNCSIG__ ": countToRelease must be positive");
+		const uint32_t releasing = static_cast<uint32_t>(countToRelease);
+		uint32_t count = m_count.load(std::memory_order_relaxed);
+		do
+		{
+			if (releasing > m_maxCount - count)
+				throw std::runtime_error(__FUNCSIG__ ": the release would exceed the maximum count");
+		} while (m_count.compare_exchange_weak(count, count + releasing, std::memory_order_seq_cst) == false);
+
+		// Either this sees a waiter, or the waiter sees the new count
+		// before it parks.
+		const uint32_t waiters = m_waiters.load(std::memory_order_seq_cst);
+		if (waiters == 0)
+			return;
+		if (m_bulkWaiters.load(std::memory_order_seq_cst) > 0 || releasing >= waiters)
+		{
+			WakeAllWaiters(m_count);
+			return;
+		}
+		for (uint32_t i = 0; i < releasing; i++)
+			WakeOneWaiter(m_count);
+	}
+
+	bool LightweightSemaphore::Acquire(const DWORD millisTimeout)
+	{
+		return Acquire(1, millisTimeout);
+	}
+
+	bool LightweightSemaphore::Acquire(const int countToAcquire, const DWORD millisTimeout)
+	{
+		if (countToAcquire <= 0)
+			throw std::invalid_argument(__FUNCSIG__ ": countToAcquire must be positive");
+		if (static_cast<uint32_t>(countToAcquire) > m_maxCount)
+			throw std::invalid_argument(__FUNCSIG__ ": cannot acquire more than the maximum count");
+
+		for (uint32_t i = 0; i < SpinCount; i++)
+		{
+			if (TryAcquire(countToAcquire))
+				return true;
+			YieldProcessor();
+		}
+		if (millisTimeout == 0)
+			return false;
+		return Park(static_cast<uint32_t>(countToAcquire), millisTimeout);
+	}
+
+	bool LightweightSemaphore::TryAcquire(const int countToAcquire) noexcept
+	{
+		const uint32_t acquiring = static_cast<uint32_t>(countToAcquire);
+		uint32_t count = m_count.load(std::memory_order_relaxed);
+		while (count >= acquiring)
+		{
+			if (m_count.compare_exchange_weak(count, count - acquiring, std::memory_order_acquire, std::memory_order_relaxed))
+				return true;
+		}
+		return false;
+	}
+
+	bool LightweightSemaphore::Park(const uint32_t countToAcquire, const DWORD millisTimeout)
+	{
+		const ULONGLONG deadline = millisTimeout == INFINITE ? 0 : GetTickCount64() + millisTimeout;
+		m_waiters.fetch_add(1, std::memory_order_seq_cst);
+		if (countToAcquire > 1)
+			m_bulkWaiters.fetch_add(1, std::memory_order_seq_cst);
+		// Deregisters however we leave, including by WaitOnValue() throwing,
+		// or every later release would pay to wake a waiter that's gone.
+		struct Deregistration
+		{
+			std::atomic<uint32_t>& Waiters;
+			std::atomic<uint32_t>* BulkWaiters;
+
+			~Deregistration()
+			{
+				if (BulkWaiters)
+					BulkWaiters->fetch_sub(1, std::memory_order_relaxed);
+				Waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
+		} deregistration{ m_waiters, countToAcquire > 1 ? &m_bulkWaiters : nullptr };
+
+		bool acquired = false;
+		while (true)
+		{
+			uint32_t count = m_count.load(std::memory_order_seq_cst);
+			while (count >= countToAcquire && acquired == false)
+			{
+				acquired = m_count.compare_exchange_weak(
+					count,
+					count - countToAcquire,
+					std::memory_order_acquire,
+					std::memory_order_relaxed
+				);
+			}
+			if (acquired)
+				break;
+
+			DWORD remaining = INFINITE;
+			if (millisTimeout != INFINITE)
+			{
+				const ULONGLONG now = GetTickCount64();
+				if (now >= deadline)
+					break;
+				remaining = static_cast<DWORD>(deadline - now);
+			}
+			// Returns at once if the count has moved on from what we saw.
+			WaitOnValue(m_count, count, remaining);
+		}
+		return acquired;
+	}
+
+	const std::wstring& LightweightSemaphore::GetName() const
+	{
+		return m_name;
+	}
+
+	int LightweightSemaphore::GetCurrentCount() const
+	{
+		return static_cast<int>(m_count.load(std::memory_order_relaxed));
+	}
+
+	int LightweightSemaphore::GetMaxCount() const
+	{
+		return static_cast<int>(m_maxCount);
+	}
+
+	HANDLE LightweightSemaphore::GetHandle() const
+	{
+		return nullptr;
+	}
+
+	void LightweightSemaphore::Free()
+	{
+		delete this;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "pch.hpp"
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include "include/Async/LockProfiler.hpp"
+
+namespace Boring32::Async
+{
+	struct LockProfiler::Stats
+	{
+		std::wstring Kind;
+		std::wstring Tag;
+		std::atomic<uint64_t> Acquisitions{ 0 };
+		std::atomic<uint64_t> ContendedAcquisitions{ 0 };
+		std::atomic<uint64_t> TotalWaitMicroseconds{ 0 };
+		std::atomic<uint64_t> TotalHoldMicroseconds{ 0 };
+		std::atomic<uint64_t> WaitHistogram[LockProfile::HistogramBuckets]{};
+		std::atomic<uint64_t> HoldHistogram[LockProfile::HistogramBuckets]{};
+		// Only touched on contended acquisitions, so a lock is fine.
+		mutable SRWLOCK CallSitesLock = SRWLOCK_INIT;
+		std::unordered_map<const void*, uint64_t> CallSites;
+	};
+
+	struct LockProfiler::Registry
+	{
+		SRWLOCK Lock = SRWLOCK_INIT;
+		std::unordered_map<const void*, std::unique_ptr<Stats>> Locks;
+		// Bumped by Reset(), which frees every Stats, so that threads drop
+		// the pointers they have cached.
+		std::atomic<uint64_t> Generation{ 1 };
+	};
+
+	namespace
+	{
+		uint64_t ToMicroseconds(const uint64_t ticks) noexcept
+		{
+			static const uint64_t frequency =
+				[]()
+				{
+					LARGE_INTEGER result;
+					QueryPerformanceFrequency(&result);
+					return static_cast<uint64_t>(result.QuadPart);
+				}();
+			return ticks / frequency * 1000000 + ticks % frequency * 1000000 / frequency;
+		}
+
+		size_t GetBucket(const uint64_t micros) noexcept
+		{
+			size_t bucket = 0;
+			for (uint64_t value = micros; value > 0 && bucket < LockProfile::HistogramBuckets - 1; value >>= 1)
+				bucket++;
+			return bucket;
+		}
+
+		void FormatHistogram(
+			std::wstringstream& wss,
+			const wchar_t* label,
+			const std::array<uint64_t, LockProfile::HistogramBuckets>& histogram
+		)
+		{
+			wss << L"    " << label << L" (us):";
+			for (size_t i = 0; i < histogram.size(); i++)
+			{
+				if (histogram[i] == 0)
+					continue;
+				if (i == 0)
+					wss << L" <1:";
+				else if (i == histogram.size() - 1)
+					wss << L" >=" << (1ull << (i - 1)) << L":";
+				else
+					wss << L" " << (1ull << (i - 1)) << L"-" << (1ull << i) << L":";
+				wss << histogram[i];
+			}
+			wss << L"\n";
+		}
+	}
+
+	std::atomic<bool> LockProfiler::m_isEnabled(false);
+
+	LockProfiler::Registry& LockProfiler::GetRegistry()
+	{
+		// Constructed on first use, as locks may be profiled during static
+		// initialisation.
+		static Registry registry;
+		return registry;
+	}
+
+	void LockProfiler::Enable() noexcept
+	{
+		m_isEnabled.store(true, std::memory_order_relaxed);
+	}
+
+	void LockProfiler::Disable() noexcept
+	{
+		m_isEnabled.store(false, std::memory_order_relaxed);
+	}
+
+	void LockProfiler::SetTag(const void* lock, std::wstring tag)
+	{
+		Stats& stats = GetStats(lock, L"", L"");
+		Registry& registry = GetRegistry();
+		AcquireSRWLockExclusive(&registry.Lock);
+		stats.Tag = std::move(tag);
+		ReleaseSRWLockExclusive(&registry.Lock);
+	}
+
+	std::vector<LockProfile> LockProfiler::GetProfiles()
+	{
+		std::vector<LockProfile> profiles;
+		Registry& registry = GetRegistry();
+		AcquireSRWLockShared(&registry.Lock);
+		profiles.reserve(registry.Locks.size());
+		for (const auto& [lock, stats] : registry.Locks)
+			profiles.push_back(ToProfile(lock, *stats));
+		ReleaseSRWLockShared(&registry.Lock);
+
+		std::sort(
+			profiles.begin(),
+			profiles.end(),
+			[](const LockProfile& a, const LockProfile& b) { return a.TotalWaitMicroseconds > b.TotalWaitMicroseconds; }
+		);
+		return profiles;
+	}
+
+	bool LockProfiler::TryGetProfile(const void* lock, LockProfile& profile)
+	{
+		Registry& registry = GetRegistry();
+		AcquireSRWLockShared(&registry.Lock);
+		auto entry = registry.Locks.find(lock);
+		const bool found = entry != registry.Locks.end();
+		if (found)
+			profile = ToProfile(lock, *entry->second);
+		ReleaseSRWLockShared(&registry.Lock);
+		return found;
+	}
+
+	std::wstring LockProfiler::GetReport()
+	{
+		const std::vector<LockProfile> profiles = GetProfiles();
+		std::wstringstream wss;
+		wss << L"Lock profile: " << profiles.size() << L" lock(s)\n";
+		for (const LockProfile& profile : profiles)
+		{
+			wss << (profile.Kind.empty() ? L"Lock" : profile.Kind) << L" " << profile.Lock;
+			if (profile.Tag.empty() == false)
+				wss << L" \"" << profile.Tag << L"\"";
+			wss << L": acquisitions=" << profile.Acquisitions
+				<< L" contended=" << profile.ContendedAcquisitions
+				<< L" wait=" << profile.TotalWaitMicroseconds << L"us"
+				<< L" hold=" << profile.TotalHoldMicroseconds << L"us\n";
+			FormatHistogram(wss, L"wait", profile.WaitHistogram);
+			FormatHistogram(wss, L"hold", profile.HoldHistogram);
+			const size_t callSites = profile.ContendedCallSites.size() < 5 ? profile.ContendedCallSites.size() : 5;
+			for (size_t i = 0; i < callSites; i++)
+			{
+				wss << L"    contended at " << profile.ContendedCallSites[i].first
+					<< L": " << profile.ContendedCallSites[i].second << L"\n";
+			}
+		}
+		return wss.str();
+	}
+
+	void LockProfiler::Reset()
+	{
+		Registry& registry = GetRegistry();
+		AcquireSRWLockExclusive(&registry.Lock);
+		registry.Locks.clear();
+		registry.Generation.fetch_add(1, std::memory_order_relaxed);
+		ReleaseSRWLockExclusive(&registry.Lock);
+	}
+
+	uint64_t LockProfiler::Now() noexcept
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return static_cast<uint64_t>(now.QuadPart);
+	}
+
+	void LockProfiler::RecordAcquisition(
+		const void* lock,
+		const wchar_t* kind,
+		const std::wstring& name,
+		const uint64_t waitTicks,
+		const void* contendedCallSite
+	)
+	{
+		Stats& stats = GetStats(lock, kind, name);
+		const uint64_t micros = ToMicroseconds(waitTicks);
+		stats.Acquisitions.fetch_add(1, std::memory_order_relaxed);
+		stats.TotalWaitMicroseconds.fetch_add(micros, std::memory_order_relaxed);
+		stats.WaitHistogram[GetBucket(micros)].fetch_add(1, std::memory_order_relaxed);
+		if (contendedCallSite == nullptr)
+			return;
+		stats.ContendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+		AcquireSRWLockExclusive(&stats.CallSitesLock);
+		stats.CallSites[contendedCallSite]++;
+		ReleaseSRWLockExclusive(&stats.CallSitesLock);
+	}
+
+	void LockProfiler::RecordRelease(const void* lock, const uint64_t holdTicks)
+	{
+		Stats& stats = GetStats(lock, L"", L"");
+		const uint64_t micros = ToMicroseconds(holdTicks);
+		stats.TotalHoldMicroseconds.fetch_add(micros, std::memory_order_relaxed);
+		stats.HoldHistogram[GetBucket(micros)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	LockProfiler::Stats& LockProfiler::GetStats(
+		const void* lock,
+		const wchar_t* kind,
+		const std::wstring& name
+	)
+	{
+		// Every acquisition and release comes through here, so each thread
+		// caches what it has looked up rather than taking the registry lock,
+		// which would add contention of its own to what is being measured.
+		// The cache is direct-mapped, so a colliding lock just evicts.
+		struct CacheEntry
+		{
+			const void* Lock = nullptr;
+			Stats* Entry = nullptr;
+		};
+		thread_local std::array<CacheEntry, 64> cache;
+		thread_local uint64_t cacheGeneration = 0;
+
+		Registry& registry = GetRegistry();
+		// Reset() doesn't race with profiled locks, so a relaxed load is
+		// enough to see that it happened.
+		const uint64_t generation = registry.Generation.load(std::memory_order_relaxed);
+		if (cacheGeneration != generation)
+		{
+			cache = {};
+			cacheGeneration = generation;
+		}
+		CacheEntry& cached = cache[(reinterpret_cast<uintptr_t>(lock) >> 4) % cache.size()];
+		if (cached.Lock == lock)
+			return *cached.Entry;
+
+		AcquireSRWLockShared(&registry.Lock);
+		auto entry = registry.Locks.find(lock);
+		Stats* stats = entry == registry.Locks.end() ? nullptr : entry->second.get();
+		bool isComplete = stats && (stats->Kind.empty() == false || *kind == L'\0');
+		// Once set, Kind never changes, so only then is it safe to cache.
+		bool isCacheable = stats && stats->Kind.empty() == false;
+		ReleaseSRWLockShared(&registry.Lock);
+
+		if (isComplete == false)
+		{
+			AcquireSRWLockExclusive(&registry.Lock);
+			std::unique_ptr<Stats>& slot = registry.Locks[lock];
+			if (slot == nullptr)
+				slot = std::make_unique<Stats>();
+			// A lock tagged before its first acquisition learns its kind here.
+			if (slot->Kind.empty())
+				slot->Kind = kind;
+			if (slot->Tag.empty())
+				slot->Tag = name;
+			stats = slot.get();
+			isCacheable = slot->Kind.empty() == false;
+			ReleaseSRWLockExclusive(&registry.Lock);
+		}
+		// Stats are only freed by Reset(), so the pointer stays valid until
+		// the generation changes.
+		if (isCacheable)
+			cached = { lock, stats };
+		return *stats;
+	}
+
+	LockProfile LockProfiler::ToProfile(const void* lock, const Stats& stats)
+	{
+		LockProfile profile{
+			.Lock = lock,
+			.Kind = stats.Kind,
+			.Tag = stats.Tag,
+			.Acquisitions = stats.Acquisitions.load(std::memory_order_relaxed),
+			.ContendedAcquisitions = stats.ContendedAcquisitions.load(std::memory_order_relaxed),
+			.TotalWaitMicroseconds = stats.TotalWaitMicroseconds.load(std::memory_order_relaxed),
+			.TotalHoldMicroseconds = stats.TotalHoldMicroseconds.load(std::memory_order_relaxed)
+		};
+		for (size_t i = 0; i < LockProfile::HistogramBuckets; i++)
+		{
+			profile.WaitHistogram[i] = stats.WaitHistogram[i].load(std::memory_order_relaxed);
+			profile.HoldHistogram[i] = stats.HoldHistogram[i].load(std::memory_order_relaxed);
+		}
+		AcquireSRWLockShared(&stats.CallSitesLock);
+		profile.ContendedCallSites.assign(stats.CallSites.begin(), stats.CallSites.end());
+		ReleaseSRWLockShared(&stats.CallSitesLock);
+		std::sort(
+			profile.ContendedCallSites.begin(),
+			profile.ContendedCallSites.end(),
+			[](const auto& a, const auto& b) { return a.second > b.second; }
+		);
+		return profile;
+	}
+}
\ No newline at end of file
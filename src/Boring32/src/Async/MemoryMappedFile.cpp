@@ -23,17 +23,19 @@ namespace Boring32::Async
 	MemoryMappedFile::MemoryMappedFile()
 	:	m_name(L""),
 		m_maxSize(0),
+		m_access(0),
 		m_mapFile(nullptr),
 		m_view(nullptr)
 	{ }
 	
 	MemoryMappedFile::MemoryMappedFile(
 		std::wstring name,
-		const UINT maxSize,
+		const UINT64 maxSize,
 		const bool inheritable
 	)
 	:	m_name(std::move(name)),
 		m_maxSize(maxSize),
+		m_access(FILE_MAP_ALL_ACCESS),
 		m_mapFile(nullptr),
 		m_view(nullptr)
 	{
@@ -41,8 +43,8 @@ namespace Boring32::Async
 			INVALID_HANDLE_VALUE,		// use paging file
 			nullptr,					// default security
 			PAGE_READWRITE,				// read/write access
-			0,							// maximum object size (high-order DWORD)
-			m_maxSize,					// maximum object size (low-order DWORD)
+			static_cast<DWORD>(maxSize >> 32),	// maximum object size (high-order DWORD)
+			static_cast<DWORD>(maxSize),		// maximum object size (low-order DWORD)
 			m_name.c_str());			// m_name of mapping object
 		if (m_mapFile == nullptr)
 			throw Error::Win32Error("Failed to open memory mapped file", GetLastError());
@@ -53,7 +55,7 @@ namespace Boring32::Async
 			FILE_MAP_ALL_ACCESS,	// read/write permission
 			0,
 			0,
-			maxSize
+			static_cast<SIZE_T>(maxSize)
 		);
 		if (m_view == nullptr)
 		{
@@ -61,17 +63,18 @@ namespace Boring32::Async
 			throw Error::Win32Error("MapViewOfFile() failed", GetLastError());
 		}
 
-		RtlSecureZeroMemory(m_view, m_maxSize);
+		RtlSecureZeroMemory(m_view, static_cast<SIZE_T>(maxSize));
 	}
 
 	MemoryMappedFile::MemoryMappedFile(
 		std::wstring name,
-		const UINT maxSize,
+		const UINT64 maxSize,
 		const bool inheritable,
 		const DWORD desiredAccess
 	)
 	:	m_name(std::move(name)),
 		m_maxSize(maxSize),
+		m_access(desiredAccess),
 		m_mapFile(nullptr),
 		m_view(nullptr)
 	{
@@ -89,7 +92,7 @@ namespace Boring32::Async
 			desiredAccess,	// read/write permission
 			0,
 			0,
-			maxSize
+			static_cast<SIZE_T>(maxSize)
 		);
 		if (m_view == nullptr)
 		{
@@ -98,10 +101,62 @@ namespace Boring32::Async
 		}
 	}
 
+	MemoryMappedFile::MemoryMappedFile(
+		const std::filesystem::path& path,
+		const FileAccess access,
+		const UINT64 size
+	)
+	:	m_name(path.wstring()),
+		m_maxSize(size),
+		m_access(access == FileAccess::ReadWrite ? FILE_MAP_READ | FILE_MAP_WRITE : FILE_MAP_READ),
+		m_mapFile(nullptr),
+		m_view(nullptr)
+	{
+		const bool isWritable = access == FileAccess::ReadWrite;
+		Raii::Win32Handle file(
+			CreateFileW(
+				m_name.c_str(),
+				isWritable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+				FILE_SHARE_READ,
+				nullptr,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL,
+				nullptr
+			)
+		);
+		if (file == INVALID_HANDLE_VALUE)
+			throw Error::Win32Error(__FUNCSIG__ ": CreateFileW() failed", GetLastError());
+
+		LARGE_INTEGER fileSize{ 0 };
+		if (GetFileSizeEx(file.GetHandle(), &fileSize) == false)
+			throw Error::Win32Error(__FUNCSIG__ ": GetFileSizeEx() failed", GetLastError());
+		if (m_maxSize == 0)
+			m_maxSize = static_cast<UINT64>(fileSize.QuadPart);
+		if (m_maxSize == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": cannot map an empty file");
+		if (isWritable == false && m_maxSize > static_cast<UINT64>(fileSize.QuadPart))
+			throw std::invalid_argument(__FUNCSIG__ ": a read-only mapping cannot be larger than the file");
+
+		// The mapping holds its own reference to the file, so the file
+		// handle is closed once the mapping exists.
+		m_mapFile = CreateFileMappingW(
+			file.GetHandle(),
+			nullptr,
+			isWritable ? PAGE_READWRITE : PAGE_READONLY,
+			static_cast<DWORD>(m_maxSize >> 32),
+			static_cast<DWORD>(m_maxSize),
+			nullptr
+		);
+		if (m_mapFile == nullptr)
+			throw Error::Win32Error(__FUNCSIG__ ": CreateFileMappingW() failed", GetLastError());
+	}
+
 	MemoryMappedFile::MemoryMappedFile(const MemoryMappedFile& other)
 	:	m_name(other.m_name),
 		m_maxSize(other.m_maxSize),
-		m_mapFile(nullptr)
+		m_access(other.m_access),
+		m_mapFile(nullptr),
+		m_view(nullptr)
 	{
 		Copy(other);
 	}
@@ -118,15 +173,17 @@ namespace Boring32::Async
 		Close();
 		m_name = other.m_name;
 		m_maxSize = other.m_maxSize;
+		m_access = other.m_access;
 		m_mapFile = other.m_mapFile;
-		if (m_mapFile != nullptr)
+		// File-backed mappings have no whole view to duplicate.
+		if (m_mapFile != nullptr && other.m_view != nullptr)
 		{
 			m_view = MapViewOfFile(
 				m_mapFile.GetHandle(),   // handle to map object
-				FILE_MAP_ALL_ACCESS, // read/write permission
+				m_access, // read/write permission
 				0,
 				0,
-				m_maxSize
+				static_cast<SIZE_T>(m_maxSize)
 			);
 			if (m_view == nullptr)
 			{
@@ -137,6 +194,9 @@ namespace Boring32::Async
 	}
 
 	MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+	:	m_maxSize(0),
+		m_access(0),
+		m_view(nullptr)
 	{
 		Move(other);
 	}
@@ -153,6 +213,7 @@ namespace Boring32::Async
 		m_name = std::move(other.m_name);
 		m_mapFile = std::move(other.m_mapFile);
 		m_maxSize = other.m_maxSize;
+		m_access = other.m_access;
 		m_view = other.m_view;
 		other.m_mapFile = nullptr;
 		other.m_view = nullptr;
@@ -163,6 +224,18 @@ namespace Boring32::Async
 		return m_view;
 	}
 
+	MemoryMappedWindow MemoryMappedFile::OpenWindow(const size_t windowSize, const bool readAhead) const
+	{
+		if (m_mapFile == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": the MemoryMappedFile is not initialised");
+		return MemoryMappedWindow(m_mapFile, m_maxSize, m_access, windowSize, readAhead);
+	}
+
+	UINT64 MemoryMappedFile::GetSize() const noexcept
+	{
+		return m_maxSize;
+	}
+
 	const std::wstring& MemoryMappedFile::GetName() const
 	{
 		return m_name;
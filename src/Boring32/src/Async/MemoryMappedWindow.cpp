@@ -0,0 +1,162 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Error/Win32Error.hpp"
+#include "include/Async/MemoryMappedWindow.hpp"
+
+namespace Boring32::Async
+{
+	MemoryMappedWindow::~MemoryMappedWindow()
+	{
+		Unmap();
+	}
+
+	MemoryMappedWindow::MemoryMappedWindow()
+	:	m_mapping(nullptr),
+		m_mappingSize(0),
+		m_access(0),
+		m_windowSize(0),
+		m_readAhead(false),
+		m_view(nullptr),
+		m_viewOffset(0),
+		m_viewSize(0)
+	{ }
+
+	MemoryMappedWindow::MemoryMappedWindow(
+		const Raii::Win32Handle& mapping,
+		const UINT64 mappingSize,
+		const DWORD access,
+		const size_t windowSize,
+		const bool readAhead
+	)
+	:	m_mapping(mapping),
+		m_mappingSize(mappingSize),
+		m_access(access),
+		m_windowSize(0),
+		m_readAhead(readAhead),
+		m_view(nullptr),
+		m_viewOffset(0),
+		m_viewSize(0)
+	{
+		if (m_mapping == nullptr)
+			throw std::invalid_argument(__FUNCSIG__ ": mapping is null");
+		if (windowSize == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": windowSize must be greater than 0");
+
+		SYSTEM_INFO systemInfo;
+		GetSystemInfo(&systemInfo);
+		const size_t granularity = systemInfo.dwAllocationGranularity;
+		m_windowSize = (windowSize + granularity - 1) / granularity * granularity;
+	}
+
+	MemoryMappedWindow::MemoryMappedWindow(MemoryMappedWindow&& other) noexcept
+	:	m_view(nullptr)
+	{
+		Move(other);
+	}
+
+	MemoryMappedWindow& MemoryMappedWindow::operator=(MemoryMappedWindow&& other) noexcept
+	{
+		Move(other);
+		return *this;
+	}
+
+	void MemoryMappedWindow::Move(MemoryMappedWindow& other) noexcept
+	{
+		Unmap();
+		m_mapping = std::move(other.m_mapping);
+		m_mappingSize = other.m_mappingSize;
+		m_access = other.m_access;
+		m_windowSize = other.m_windowSize;
+		m_readAhead = other.m_readAhead;
+		m_view = other.m_view;
+		m_viewOffset = other.m_viewOffset;
+		m_viewSize = other.m_viewSize;
+		other.m_view = nullptr;
+		other.m_viewOffset = 0;
+		other.m_viewSize = 0;
+	}
+
+	std::span<std::byte> MemoryMappedWindow::Map(const UINT64 offset, const size_t length)
+	{
+		if (offset > m_mappingSize || length > m_mappingSize - offset)
+			throw std::out_of_range(__FUNCSIG__ ": the region extends past the end of the mapping");
+		if (length == 0)
+			return {};
+
+		const bool isCovered = m_view != nullptr
+			&& offset >= m_viewOffset
+			&& offset + length <= m_viewOffset + m_viewSize;
+		if (isCovered == false)
+		{
+			Unmap();
+			// Views must start on a multiple of the allocation granularity,
+			// which m_windowSize is also a multiple of.
+			const UINT64 viewOffset = offset - offset % m_windowSize;
+			UINT64 viewSize = offset + length - viewOffset;
+			if (viewSize < m_windowSize)
+				viewSize = m_windowSize;
+			if (viewSize > m_mappingSize - viewOffset)
+				viewSize = m_mappingSize - viewOffset;
+			if (viewSize > SIZE_MAX)
+				throw std::out_of_range(__FUNCSIG__ ": the region is too large to map in this process");
+
+			void* view = MapViewOfFile(
+				m_mapping.GetHandle(),
+				m_access,
+				static_cast<DWORD>(viewOffset >> 32),
+				static_cast<DWORD>(viewOffset),
+				static_cast<SIZE_T>(viewSize)
+			);
+			if (view == nullptr)
+				throw Error::Win32Error(__FUNCSIG__ ": MapViewOfFile() failed", GetLastError());
+			m_view = static_cast<std::byte*>(view);
+			m_viewOffset = viewOffset;
+			m_viewSize = static_cast<size_t>(viewSize);
+			if (m_readAhead)
+				Prefetch(m_viewOffset, m_viewSize);
+		}
+		return { m_view + (offset - m_viewOffset), length };
+	}
+
+	void MemoryMappedWindow::Prefetch(const UINT64 offset, const size_t length) noexcept
+	{
+		if (m_view == nullptr)
+			return;
+		const UINT64 viewEnd = m_viewOffset + m_viewSize;
+		const UINT64 start = offset > m_viewOffset ? offset : m_viewOffset;
+		const UINT64 end = offset + length < viewEnd ? offset + length : viewEnd;
+		if (start >= end)
+			return;
+
+		WIN32_MEMORY_RANGE_ENTRY range{
+			.VirtualAddress = m_view + (start - m_viewOffset),
+			.NumberOfBytes = static_cast<SIZE_T>(end - start)
+		};
+		PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+
+	void MemoryMappedWindow::Unmap() noexcept
+	{
+		if (m_view == nullptr)
+			return;
+		UnmapViewOfFile(m_view);
+		m_view = nullptr;
+		m_viewOffset = 0;
+		m_viewSize = 0;
+	}
+
+	UINT64 MemoryMappedWindow::GetViewOffset() const noexcept
+	{
+		return m_viewOffset;
+	}
+
+	size_t MemoryMappedWindow::GetViewSize() const noexcept
+	{
+		return m_viewSize;
+	}
+
+	UINT64 MemoryMappedWindow::GetMappingSize() const noexcept
+	{
+		return m_mappingSize;
+	}
+}
\ No newline at end of file
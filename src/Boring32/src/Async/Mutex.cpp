@@ -1,7 +1,9 @@
 #include "pch.hpp"
 #include <stdexcept>
 #include "include/Error/Error.hpp"
+#include <intrin.h>
 #include "include/Async/Mutex.hpp"
+#include "include/Async/LockProfiler.hpp"
 
 namespace Boring32::Async
 {
@@ -24,14 +26,16 @@ namespace Boring32::Async
 	:	m_name(L""),
 		m_created(false),
 		m_mutex(nullptr),
-		m_locked(false)
+		m_locked(false),
+		m_profiledAt(0)
 	{ }
 
 	Mutex::Mutex(const bool acquire, const bool inheritable)
 	:	m_name(L""),
 		m_created(false),
 		m_locked(acquire),
-		m_mutex(nullptr)
+		m_mutex(nullptr),
+		m_profiledAt(0)
 	{
 		m_mutex = CreateMutexW(
 			nullptr,
@@ -51,7 +55,8 @@ namespace Boring32::Async
 	:	m_name(std::move(name)),
 		m_created(true),
 		m_mutex(nullptr),
-		m_locked(false)
+		m_locked(false),
+		m_profiledAt(0)
 	{
 		m_mutex = CreateMutexW(
 			nullptr,
@@ -74,7 +79,8 @@ namespace Boring32::Async
 	:	m_name(name),
 		m_created(false),
 		m_mutex(nullptr),
-		m_locked(false)
+		m_locked(false),
+		m_profiledAt(0)
 	{
 		if(m_name == L"")
 			throw std::runtime_error(__FUNCSIG__ ": cannot open mutex with empty name");
@@ -103,6 +109,7 @@ namespace Boring32::Async
 		m_created = false;
 		m_locked = other.m_locked;
 		m_mutex = other.m_mutex;
+		m_profiledAt = 0;
 	}
 
 	Mutex::Mutex(Mutex&& other) noexcept
@@ -122,6 +129,7 @@ namespace Boring32::Async
 		m_created = other.m_created;
 		m_locked = other.m_locked;
 		m_mutex = std::move(other.m_mutex);
+		m_profiledAt = other.m_profiledAt;
 	}
 
 	bool Mutex::Lock(const DWORD waitTime, const bool isAlertable)
@@ -129,6 +137,9 @@ namespace Boring32::Async
 		if (m_mutex == nullptr)
 			throw std::runtime_error(__FUNCSIG__ ": cannot wait on null mutex");
 
+		if (LockProfiler::IsEnabled())
+			return ProfiledLock(waitTime, isAlertable, _ReturnAddress());
+
 		DWORD result = WaitForSingleObjectEx(m_mutex.GetHandle(), waitTime, isAlertable);
 		if (result == WAIT_FAILED)
 			throw Error::Win32Error(__FUNCSIG__ ": failed to acquire mutex", GetLastError());
@@ -139,6 +150,31 @@ namespace Boring32::Async
 		return m_locked;
 	}
 
+	bool Mutex::ProfiledLock(const DWORD waitTime, const bool isAlertable, const void* callSite)
+	{
+		const uint64_t start = LockProfiler::Now();
+		// A zero-timeout attempt first tells us whether we had to wait.
+		DWORD result = WaitForSingleObjectEx(m_mutex.GetHandle(), 0, isAlertable);
+		const bool isContended = result == WAIT_TIMEOUT;
+		if (isContended && waitTime != 0)
+			result = WaitForSingleObjectEx(m_mutex.GetHandle(), waitTime, isAlertable);
+		if (result == WAIT_FAILED)
+			throw Error::Win32Error(__FUNCSIG__ ": failed to acquire mutex", GetLastError());
+		m_locked = result == WAIT_OBJECT_0;
+		if (m_locked == false)
+			return false;
+
+		m_profiledAt = LockProfiler::Now();
+		LockProfiler::RecordAcquisition(
+			this,
+			L"Mutex",
+			m_name,
+			m_profiledAt - start,
+			isContended ? callSite : nullptr
+		);
+		return true;
+	}
+
 	bool Mutex::Lock(const DWORD waitTime, const bool isAlertable, std::nothrow_t) noexcept
 	{
 		return Error::TryCatchLogToWCerr(
@@ -151,10 +187,18 @@ namespace Boring32::Async
 	{
 		if (m_mutex == nullptr)
 			throw std::runtime_error(__FUNCSIG__ ": cannot wait on null mutex");
+		const uint64_t profiledAt = m_profiledAt;
+		m_profiledAt = 0;
+		const uint64_t releasedAt = profiledAt ? LockProfiler::Now() : 0;
+		// Cleared first, as the next owner may set it as soon as we release.
+		m_locked = false;
 		if (ReleaseMutex(m_mutex.GetHandle()) == false)
+		{
+			m_locked = true;
 			throw Error::Win32Error(__FUNCSIG__ ": failed to release mutex", GetLastError());
-
-		m_locked = false;
+		}
+		if (profiledAt)
+			LockProfiler::RecordRelease(this, releasedAt - profiledAt);
 	}
 
 	bool Mutex::Unlock(std::nothrow_t) noexcept
@@ -26,6 +26,12 @@ namespace Boring32::Async
 		IoBuffer = std::move(other.IoBuffer);
 	}
 
+	void OverlappedIo::Reset()
+	{
+		OverlappedOp::Reset();
+		IoBuffer.clear();
+	}
+
 	void OverlappedIo::ResizeBuffer()
 	{
 		if (IsSuccessful() == false)
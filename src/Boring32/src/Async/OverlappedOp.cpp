@@ -115,6 +115,22 @@ namespace Boring32::Async
 			m_ioEvent.Reset();
 	}
 
+	void OverlappedOp::Reset()
+	{
+		if (m_ioOverlapped == nullptr || m_ioOverlapped.use_count() > 1 || m_ioEvent.GetHandle() == nullptr)
+		{
+			m_ioEvent = Event(false, true, false, L"");
+			m_ioOverlapped = std::make_shared<OVERLAPPED>();
+		}
+		else
+		{
+			*m_ioOverlapped = {};
+			m_ioEvent.Reset();
+		}
+		m_ioOverlapped->hEvent = m_ioEvent.GetHandle();
+		m_lastError = 0;
+	}
+
 	DWORD OverlappedOp::LastError() const
 	{
 		return m_lastError;
@@ -0,0 +1,106 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/PhaseBarrier.hpp"
+
+namespace Boring32::Async
+{
+	PhaseBarrier::~PhaseBarrier() { }
+
+	PhaseBarrier::PhaseBarrier(const uint32_t participants)
+	:	PhaseBarrier(participants, nullptr, DefaultMaxSpins)
+	{ }
+
+	PhaseBarrier::PhaseBarrier(
+		const uint32_t participants,
+		std::function<void()> onCompletion,
+		const uint32_t maxSpins
+	)
+	:	m_onCompletion(std::move(onCompletion)),
+		m_spins(maxSpins),
+		m_participants(participants),
+		m_waiters(0),
+		m_remaining(participants),
+		m_phase(0)
+	{
+		if (participants == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": participants must be non-zero");
+	}
+
+	bool PhaseBarrier::Enter()
+	{
+		// Read before arriving: the phase can't end until we have.
+		const uint32_t phase = m_phase.load(std::memory_order_acquire);
+		if (Arrive())
+			return true;
+		Wait(phase);
+		return false;
+	}
+
+	void PhaseBarrier::ArriveAndDrop()
+	{
+		uint32_t participants = m_participants.load(std::memory_order_relaxed);
+		do
+		{
+			if (participants == 0)
+				throw std::runtime_error(__FUNCSIG__ ": there are no participants to drop");
+		} while (m_participants.compare_exchange_weak(participants, participants - 1, std::memory_order_relaxed) == false);
+		// Arriving after the drop means whoever ends this phase resets the
+		// count without us.
+		Arrive();
+	}
+
+	uint32_t PhaseBarrier::GetPhase() const noexcept
+	{
+		return m_phase.load(std::memory_order_acquire);
+	}
+
+	uint32_t PhaseBarrier::GetParticipants() const noexcept
+	{
+		return m_participants.load(std::memory_order_relaxed);
+	}
+
+	bool PhaseBarrier::Arrive() noexcept
+	{
+		if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return false;
+
+		if (m_onCompletion)
+			m_onCompletion();
+		// Reset for the next phase before releasing anyone into it.
+		m_remaining.store(m_participants.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		m_phase.fetch_add(1, std::memory_order_seq_cst);
+		// Either this sees a parked waiter, or the waiter sees the new phase
+		// before it parks.
+		if (m_waiters.load(std::memory_order_seq_cst) > 0)
+			WakeAllWaiters(m_phase);
+		return true;
+	}
+
+	void PhaseBarrier::Wait(const uint32_t phase)
+	{
+		const uint32_t limit = m_spins.GetLimit();
+		for (uint32_t spins = 0; spins < limit; spins++)
+		{
+			if (m_phase.load(std::memory_order_acquire) != phase)
+			{
+				m_spins.Succeeded(spins);
+				return;
+			}
+			YieldProcessor();
+		}
+		m_spins.Failed();
+
+		for (uint32_t i = 0; i < YieldCount; i++)
+		{
+			if (m_phase.load(std::memory_order_acquire) != phase)
+				return;
+			SwitchToThread();
+		}
+
+		m_waiters.fetch_add(1, std::memory_order_seq_cst);
+		while (m_phase.load(std::memory_order_seq_cst) == phase)
+			WaitOnValue(m_phase, phase, INFINITE);
+		m_waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
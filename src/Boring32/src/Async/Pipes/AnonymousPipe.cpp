@@ -1,5 +1,7 @@
 #include "pch.hpp"
 #include <stdexcept>
+#include <cstring>
+#include "include/Error/Win32Error.hpp"
 #include "include/Async/Pipes/AnonymousPipe.hpp"
 #include "include/Strings/Strings.hpp"
 #include <iostream>
@@ -36,6 +38,9 @@ namespace Boring32::Async
 		m_readHandle = other.m_readHandle;
 		m_writeHandle = other.m_writeHandle;
 		m_mode = other.m_mode;
+		m_readBuffer = other.m_readBuffer;
+		m_readBegin = other.m_readBegin;
+		m_readEnd = other.m_readEnd;
 	}
 
 	AnonymousPipe::AnonymousPipe(AnonymousPipe&& other) noexcept
@@ -58,6 +63,11 @@ namespace Boring32::Async
 			m_readHandle = std::move(other.m_readHandle);
 		if (other.m_writeHandle != nullptr)
 			m_writeHandle = std::move(other.m_writeHandle);
+		m_readBuffer = std::move(other.m_readBuffer);
+		m_readBegin = other.m_readBegin;
+		m_readEnd = other.m_readEnd;
+		other.m_readBegin = 0;
+		other.m_readEnd = 0;
 	}
 
 	AnonymousPipe::AnonymousPipe(
@@ -96,6 +106,8 @@ namespace Boring32::Async
 	{
 		m_readHandle.Close();
 		m_writeHandle.Close();
+		m_readBegin = 0;
+		m_readEnd = 0;
 	}
 
 	void AnonymousPipe::DelimitedWrite(const std::wstring& msg)
@@ -103,38 +115,31 @@ namespace Boring32::Async
 		if (m_writeHandle == nullptr)
 			throw std::runtime_error("No active write handle.");
 
-		std::wstring delimitedMsg(msg);
-		if (m_delimiter != L"")
-			delimitedMsg = m_delimiter + delimitedMsg + m_delimiter;
-
-		if ((GetUsedSize() + delimitedMsg.size()) >= m_size)
-			throw std::runtime_error("Pipe cannot fit message");
-
-		DWORD bytesWritten = 0;
-		bool success = WriteFile(
-			m_writeHandle.GetHandle(),
-			delimitedMsg.data(),
-			(DWORD)(delimitedMsg.size()*sizeof(wchar_t)),
-			&bytesWritten,
-			nullptr
-		);
-		if (success == false)
-			throw std::runtime_error("Write operation failed.");
+		if (m_delimiter == L"")
+		{
+			Write(msg);
+			return;
+		}
+		Write(m_delimiter + msg + m_delimiter);
 	}
 
 	void AnonymousPipe::Write(const std::wstring& msg)
+	{
+		Write(std::as_bytes(std::span(msg)));
+	}
+
+	void AnonymousPipe::Write(std::span<const std::byte> data)
 	{
 		if (m_writeHandle == nullptr)
 			throw std::runtime_error("No active write handle.");
-
-		if ((GetUsedSize() + msg.size()) >= m_size)
+		if (data.size() > m_size || GetUsedBytes() + data.size() > m_size)
 			throw std::runtime_error("Pipe cannot fit message");
 
 		DWORD bytesWritten = 0;
 		bool success = WriteFile(
 			m_writeHandle.GetHandle(),
-			msg.data(),
-			(DWORD)(msg.size()*sizeof(wchar_t)),
+			data.data(),
+			(DWORD)data.size(),
 			&bytesWritten,
 			nullptr
 		);
@@ -143,26 +148,125 @@ namespace Boring32::Async
 	}
 
 	std::wstring AnonymousPipe::Read()
+	{
+		std::wstring msg(m_size / sizeof(wchar_t), L'\0');
+		const DWORD bytesRead = Read(std::as_writable_bytes(std::span(msg)));
+		msg.resize(bytesRead / sizeof(wchar_t));
+		return msg;
+	}
+
+	DWORD AnonymousPipe::Read(std::span<std::byte> buffer)
 	{
 		if (m_readHandle == nullptr)
 			throw std::runtime_error("No active read handle.");
+		if (buffer.size() > MAXDWORD)
+			throw std::invalid_argument("Read buffer is too large");
 
-		std::wstring msg;
 		DWORD bytesRead = 0;
-		msg.resize(m_size);
 		bool success = ReadFile(
 			m_readHandle.GetHandle(),
-			&msg[0],
-			(DWORD)(msg.size() * sizeof(wchar_t)),
+			buffer.data(),
+			(DWORD)buffer.size(),
 			&bytesRead,
 			nullptr
 		);
 		if (success == false)
 			throw std::runtime_error("Read operation failed");
 
-		msg.erase(std::find(msg.begin(), msg.end(), '\0'), msg.end());
+		return bytesRead;
+	}
 
-		return msg;
+	void AnonymousPipe::FramedWrite(std::span<const std::byte> message)
+	{
+		if (message.size() > MaxFrameSize)
+			throw std::invalid_argument(__FUNCSIG__ ": message is too large");
+
+		if (m_writeHandle == nullptr)
+			throw std::runtime_error("No active write handle.");
+
+		// Unlike Write(), this doesn't check for space up front, so a writer
+		// that gets ahead of the reader waits for it instead of failing.
+		const uint32_t length = static_cast<uint32_t>(message.size());
+		WriteAll(std::as_bytes(std::span(&length, 1)));
+		WriteAll(message);
+	}
+
+	void AnonymousPipe::WriteAll(std::span<const std::byte> data)
+	{
+		while (data.empty() == false)
+		{
+			DWORD bytesWritten = 0;
+			const bool succeeded = WriteFile(
+				m_writeHandle.GetHandle(),
+				data.data(),
+				static_cast<DWORD>(data.size()),
+				&bytesWritten,
+				nullptr
+			);
+			if (succeeded == false)
+				throw Error::Win32Error(__FUNCSIG__ ": WriteFile() failed", GetLastError());
+			data = data.subspan(bytesWritten);
+		}
+	}
+
+	bool AnonymousPipe::FramedRead(std::span<const std::byte>& message)
+	{
+		if (m_readHandle == nullptr)
+			throw std::runtime_error("No active read handle.");
+
+		while (true)
+		{
+			const size_t buffered = m_readEnd - m_readBegin;
+			size_t required = sizeof(uint32_t);
+			if (buffered >= sizeof(uint32_t))
+			{
+				uint32_t length = 0;
+				std::memcpy(&length, m_readBuffer.data() + m_readBegin, sizeof(length));
+				if (length > MaxFrameSize)
+					throw std::runtime_error(__FUNCSIG__ ": frame exceeds MaxFrameSize");
+				required += length;
+				if (buffered >= required)
+				{
+					message = std::span<const std::byte>(m_readBuffer).subspan(m_readBegin + sizeof(length), length);
+					m_readBegin += required;
+					return true;
+				}
+			}
+
+			// Move the partial frame to the front, so the read can fill the
+			// rest of the buffer.
+			if (m_readBegin > 0)
+			{
+				if (buffered > 0)
+					std::memmove(m_readBuffer.data(), m_readBuffer.data() + m_readBegin, buffered);
+				m_readBegin = 0;
+				m_readEnd = buffered;
+			}
+			if (m_readBuffer.size() < required)
+			{
+				const size_t defaultSize = m_size > 4096 ? m_size : 4096;
+				m_readBuffer.resize(required > defaultSize ? required : defaultSize);
+			}
+
+			DWORD bytesRead = 0;
+			const bool succeeded = ReadFile(
+				m_readHandle.GetHandle(),
+				m_readBuffer.data() + m_readEnd,
+				static_cast<DWORD>(m_readBuffer.size() - m_readEnd),
+				&bytesRead,
+				nullptr
+			);
+			if (succeeded == false)
+			{
+				const DWORD lastError = GetLastError();
+				if (lastError != ERROR_BROKEN_PIPE)
+					throw Error::Win32Error(__FUNCSIG__ ": ReadFile() failed", lastError);
+				if (m_readEnd > 0)
+					throw std::runtime_error(__FUNCSIG__ ": pipe closed mid-message");
+				return false;
+			}
+			m_readEnd += bytesRead;
+		}
 	}
 
 	void AnonymousPipe::SetMode(const DWORD mode)
@@ -208,6 +312,8 @@ namespace Boring32::Async
 	void AnonymousPipe::CloseRead()
 	{
 		m_readHandle.Close();
+		m_readBegin = 0;
+		m_readEnd = 0;
 	}
 
 	void AnonymousPipe::CloseWrite()
@@ -237,7 +343,12 @@ namespace Boring32::Async
 
 	DWORD AnonymousPipe::GetUsedSize() const
 	{
-		DWORD charactersInPipe = 0;
+		return GetUsedBytes() / sizeof(wchar_t);
+	}
+
+	DWORD AnonymousPipe::GetUsedBytes() const
+	{
+		DWORD bytesInPipe = 0;
 		// We do this sequence of actions to determine how much space
 		// is used in the passed pipe handles, if any.
 		HANDLE handleToDetermineBytesAvailable = nullptr;
@@ -248,17 +359,16 @@ namespace Boring32::Async
 		if (handleToDetermineBytesAvailable)
 		{
 			PeekNamedPipe(
-				m_readHandle.GetHandle(),
+				handleToDetermineBytesAvailable,
 				nullptr,
 				0,
 				nullptr,
-				&charactersInPipe,
+				&bytesInPipe,
 				nullptr
 			);
-			charactersInPipe /= sizeof(wchar_t);
 		}
 
-		return charactersInPipe;
+		return bytesInPipe;
 	}
 
 	DWORD AnonymousPipe::GetRemainingSize() const
@@ -0,0 +1,212 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/Pipes/BatchingNamedPipeClient.hpp"
+
+namespace Boring32::Async
+{
+	BatchingNamedPipeClient::~BatchingNamedPipeClient()
+	{
+		try
+		{
+			Close();
+		}
+		catch (const std::exception& ex)
+		{
+			std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+		}
+	}
+
+	BatchingNamedPipeClient::BatchingNamedPipeClient(
+		const std::wstring& name,
+		const size_t maxBatchSize,
+		const DWORD flushDeadline
+	)
+	:	BlockingNamedPipeClient(name),
+		m_maxBatchSize(maxBatchSize),
+		m_flushDeadline(flushDeadline),
+		m_batchStarted(0),
+		m_isStopping(false),
+		m_wake(false, false, false, L"")
+	{
+		if (maxBatchSize <= FrameHeaderSize || maxBatchSize > MAXDWORD)
+			throw std::invalid_argument(__FUNCSIG__ ": maxBatchSize is out of range");
+
+		InitializeSRWLock(&m_batchLock);
+		m_batch.reserve(maxBatchSize);
+		if (flushDeadline != INFINITE)
+			m_flushThread = std::thread([this] { Run(); });
+	}
+
+	void BatchingNamedPipeClient::Close()
+	{
+		AcquireSRWLockExclusive(&m_batchLock);
+		m_isStopping = true;
+		ReleaseSRWLockExclusive(&m_batchLock);
+		if (m_flushThread.joinable())
+		{
+			m_wake.Signal();
+			m_flushThread.join();
+		}
+
+		try
+		{
+			if (m_handle != nullptr)
+				FlushBatch();
+		}
+		catch (...)
+		{
+			m_batch.clear();
+			BlockingNamedPipeClient::Close();
+			throw;
+		}
+		m_batch.clear();
+		BlockingNamedPipeClient::Close();
+	}
+
+	void BatchingNamedPipeClient::Post(std::span<const std::byte> message)
+	{
+		const std::span<const std::byte> buffers[] = { message };
+		Post(buffers);
+	}
+
+	void BatchingNamedPipeClient::Post(std::span<const std::span<const std::byte>> buffers)
+	{
+		size_t messageSize = 0;
+		for (const std::span<const std::byte>& buffer : buffers)
+			messageSize += buffer.size();
+		if (messageSize > UINT32_MAX - FrameHeaderSize)
+			throw std::invalid_argument(__FUNCSIG__ ": message is too large");
+		const size_t frameSize = FrameHeaderSize + messageSize;
+
+		AcquireSRWLockExclusive(&m_batchLock);
+		try
+		{
+			if (m_batch.size() + frameSize > m_maxBatchSize)
+				InternalFlush();
+
+			const bool wasEmpty = m_batch.empty();
+			const uint32_t length = static_cast<uint32_t>(messageSize);
+			for (size_t i = 0; i < FrameHeaderSize; i++)
+				m_batch.push_back(static_cast<std::byte>(length >> (8 * i)));
+			for (const std::span<const std::byte>& buffer : buffers)
+				m_batch.insert(m_batch.end(), buffer.begin(), buffer.end());
+
+			// An oversized message is sent in a batch of its own.
+			if (m_batch.size() >= m_maxBatchSize)
+			{
+				InternalFlush();
+			}
+			else if (wasEmpty)
+			{
+				m_batchStarted = GetTickCount64();
+				if (m_flushThread.joinable())
+					m_wake.Signal();
+			}
+		}
+		catch (...)
+		{
+			ReleaseSRWLockExclusive(&m_batchLock);
+			throw;
+		}
+		ReleaseSRWLockExclusive(&m_batchLock);
+	}
+
+	void BatchingNamedPipeClient::FlushBatch()
+	{
+		AcquireSRWLockExclusive(&m_batchLock);
+		try
+		{
+			InternalFlush();
+		}
+		catch (...)
+		{
+			ReleaseSRWLockExclusive(&m_batchLock);
+			throw;
+		}
+		ReleaseSRWLockExclusive(&m_batchLock);
+	}
+
+	size_t BatchingNamedPipeClient::GetPendingBytes() noexcept
+	{
+		AcquireSRWLockShared(&m_batchLock);
+		const size_t pending = m_batch.size();
+		ReleaseSRWLockShared(&m_batchLock);
+		return pending;
+	}
+
+	bool BatchingNamedPipeClient::NextMessage(
+		std::span<const std::byte>& batch,
+		std::span<const std::byte>& message
+	)
+	{
+		if (batch.empty())
+			return false;
+		if (batch.size() < FrameHeaderSize)
+			throw std::invalid_argument(__FUNCSIG__ ": frame header is truncated");
+
+		uint32_t length = 0;
+		for (size_t i = 0; i < FrameHeaderSize; i++)
+			length |= static_cast<uint32_t>(batch[i]) << (8 * i);
+		if (length > batch.size() - FrameHeaderSize)
+			throw std::invalid_argument(__FUNCSIG__ ": message is truncated");
+
+		message = batch.subspan(FrameHeaderSize, length);
+		batch = batch.subspan(FrameHeaderSize + length);
+		return true;
+	}
+
+	void BatchingNamedPipeClient::Run() noexcept
+	{
+		while (true)
+		{
+			DWORD timeout = INFINITE;
+			AcquireSRWLockExclusive(&m_batchLock);
+			if (m_isStopping)
+			{
+				ReleaseSRWLockExclusive(&m_batchLock);
+				return;
+			}
+			if (m_batch.empty() == false)
+			{
+				const ULONGLONG elapsed = GetTickCount64() - m_batchStarted;
+				if (elapsed >= m_flushDeadline)
+				{
+					try
+					{
+						InternalFlush();
+					}
+					catch (const std::exception& ex)
+					{
+						// The batch is dropped; the next write surfaces the
+						// error to the caller.
+						std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+						m_batch.clear();
+					}
+				}
+				else
+				{
+					timeout = static_cast<DWORD>(m_flushDeadline - elapsed);
+				}
+			}
+			ReleaseSRWLockExclusive(&m_batchLock);
+			try
+			{
+				m_wake.WaitOnEvent(timeout, false);
+			}
+			catch (const std::exception& ex)
+			{
+				std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+				return;
+			}
+		}
+	}
+
+	void BatchingNamedPipeClient::InternalFlush()
+	{
+		if (m_batch.empty())
+			return;
+		DWORD bytesWritten = 0;
+		WriteBytes(m_batch, &bytesWritten, nullptr);
+		m_batch.clear();
+	}
+}
\ No newline at end of file
@@ -53,22 +53,41 @@ namespace Boring32::Async
 		}
 	}
 
-	void BlockingNamedPipeClient::InternalWrite(const std::wstring& msg)
+	void BlockingNamedPipeClient::Write(std::span<const std::byte> data)
 	{
-		if (m_handle == nullptr)
-			throw std::runtime_error("No pipe to write to");
+		DWORD bytesWritten = 0;
+		WriteBytes(data, &bytesWritten, nullptr);
+	}
 
+	bool BlockingNamedPipeClient::Write(std::span<const std::byte> data, const std::nothrow_t)
+	{
+		try
+		{
+			Write(data);
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	void BlockingNamedPipeClient::Write(std::span<const std::span<const std::byte>> buffers)
+	{
+		DWORD bytesWritten = 0;
+		WriteGathered(buffers, &bytesWritten, nullptr);
+	}
+
+	bool BlockingNamedPipeClient::Read(std::span<std::byte> buffer, DWORD& bytesRead)
+	{
+		bytesRead = 0;
+		return ReadBytes(buffer, &bytesRead, nullptr) != ERROR_MORE_DATA;
+	}
+
+	void BlockingNamedPipeClient::InternalWrite(const std::wstring& msg)
+	{
 		DWORD bytesWritten = 0;
-		// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-writefile
-		bool successfulWrite = WriteFile(
-			m_handle.GetHandle(),   // pipe handle 
-			msg.c_str(),        // message 
-			(DWORD)msg.size(),         // message length 
-			&bytesWritten,      // bytes written 
-			nullptr);           // not overlapped 
-
-		if (successfulWrite == false)
-			throw Error::Win32Error("Failed to write to client pipe", GetLastError());
+		WriteBytes(std::as_bytes(std::span(msg)), &bytesWritten, nullptr);
 	}
 
 	std::wstring BlockingNamedPipeClient::Read()
@@ -91,38 +110,28 @@ namespace Boring32::Async
 
 	std::wstring BlockingNamedPipeClient::InternalRead()
 	{
-		if (m_handle == nullptr)
-			throw std::runtime_error("No pipe to read from");
-
 		std::wstring dataBuffer;
 		constexpr DWORD blockSize = 1024;
-		dataBuffer.resize(1024);
+		dataBuffer.resize(blockSize);
 
-		bool continueReading = true;
-		DWORD totalBytesRead = 0;
-		while (continueReading)
+		// Each read continues the message where the last one stopped, so
+		// no data is copied or overwritten as the buffer grows.
+		size_t totalBytesRead = 0;
+		while (true)
 		{
 			DWORD currentBytesRead = 0;
-			// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-readfile
-			bool successfulRead = ReadFile(
-				m_handle.GetHandle(),    // pipe handle 
-				&dataBuffer[0],    // buffer to receive reply 
-				(DWORD)(dataBuffer.size() * sizeof(TCHAR)),  // size of buffer 
-				&currentBytesRead,  // number of bytes read 
-				nullptr);    // not overlapped
+			const DWORD status = ReadBytes(
+				std::as_writable_bytes(std::span(dataBuffer)).subspan(totalBytesRead),
+				&currentBytesRead,
+				nullptr
+			);
 			totalBytesRead += currentBytesRead;
-			
-			const DWORD lastError = GetLastError();
-			if (successfulRead == false && lastError != ERROR_MORE_DATA)
-				throw Error::Win32Error("Failed to read from pipe", GetLastError());
-			if (lastError == ERROR_MORE_DATA)
-				dataBuffer.resize(dataBuffer.size() + blockSize);
-			continueReading = !successfulRead;
+			if (status != ERROR_MORE_DATA)
+				break;
+			dataBuffer.resize(dataBuffer.size() + blockSize);
 		}
 
-		if (totalBytesRead > 0)
-			dataBuffer.resize(totalBytesRead / sizeof(wchar_t));
-
+		dataBuffer.resize(totalBytesRead / sizeof(wchar_t));
 		return dataBuffer;
 	}
 }
\ No newline at end of file
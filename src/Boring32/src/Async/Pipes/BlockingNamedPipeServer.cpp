@@ -86,7 +86,8 @@ namespace Boring32::Async
         if (m_pipe == nullptr)
             throw std::runtime_error("No valid pipe handle to connect");
 
-        if (ConnectNamedPipe(m_pipe.GetHandle(), nullptr) == false)
+        // A client may connect between the pipe being created and this call.
+        if (ConnectNamedPipe(m_pipe.GetHandle(), nullptr) == false && GetLastError() != ERROR_PIPE_CONNECTED)
             throw std::runtime_error("Failed to connect named pipe");
     }
 
@@ -108,21 +109,35 @@ namespace Boring32::Async
         }
     }
 
-    void BlockingNamedPipeServer::InternalWrite(const std::wstring& msg)
+    void BlockingNamedPipeServer::Write(std::span<const std::byte> data)
     {
-        if (m_pipe == nullptr)
-            throw std::runtime_error("No pipe to write to");
+        DWORD bytesWritten = 0;
+        WriteBytes(data, &bytesWritten, nullptr);
+    }
+
+    bool BlockingNamedPipeServer::Write(std::span<const std::byte> data, const std::nothrow_t)
+    {
+        try
+        {
+            Write(data);
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    bool BlockingNamedPipeServer::Read(std::span<std::byte> buffer, DWORD& bytesRead)
+    {
+        bytesRead = 0;
+        return ReadBytes(buffer, &bytesRead, nullptr) != ERROR_MORE_DATA;
+    }
 
+    void BlockingNamedPipeServer::InternalWrite(const std::wstring& msg)
+    {
         DWORD bytesWritten = 0;
-        bool success = WriteFile(
-            m_pipe.GetHandle(),     // handle to pipe 
-            &msg[0],                // buffer to write from 
-            (DWORD)(msg.size()*sizeof(wchar_t)), // number of bytes to write 
-            &bytesWritten,          // number of bytes written 
-            nullptr                 // not overlapped I/O
-        );               
-        if (success == false)
-            throw std::runtime_error("Failed to read pipe");
+        WriteBytes(std::as_bytes(std::span(msg)), &bytesWritten, nullptr);
     }
 
     std::wstring BlockingNamedPipeServer::Read()
@@ -145,38 +160,28 @@ namespace Boring32::Async
 
     std::wstring BlockingNamedPipeServer::InternalRead()
     {
-        if (m_pipe == nullptr)
-            throw std::runtime_error("No pipe to read from");
-
         std::wstring dataBuffer;
         constexpr DWORD blockSize = 1024;
-        dataBuffer.resize(1024);
+        dataBuffer.resize(blockSize);
 
-        bool continueReading = true;
-        DWORD totalBytesRead = 0;
-        while (continueReading)
+        // Each read continues the message where the last one stopped, so
+        // no data is copied or overwritten as the buffer grows.
+        size_t totalBytesRead = 0;
+        while (true)
         {
             DWORD currentBytesRead = 0;
-            // https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-readfile
-            bool successfulRead = ReadFile(
-                m_pipe.GetHandle(),    // pipe handle 
-                &dataBuffer[0],    // buffer to receive reply 
-                (DWORD)(dataBuffer.size() * sizeof(TCHAR)),  // size of buffer 
-                &currentBytesRead,  // number of bytes read 
-                nullptr);    // not overlapped
+            const DWORD status = ReadBytes(
+                std::as_writable_bytes(std::span(dataBuffer)).subspan(totalBytesRead),
+                &currentBytesRead,
+                nullptr
+            );
             totalBytesRead += currentBytesRead;
-
-            const DWORD lastError = GetLastError();
-            if (successfulRead == false && lastError != ERROR_MORE_DATA)
-                throw std::runtime_error("Failed to read from pipe");
-            if (lastError == ERROR_MORE_DATA)
-                dataBuffer.resize(dataBuffer.size() + blockSize);
-            continueReading = !successfulRead;
+            if (status != ERROR_MORE_DATA)
+                break;
+            dataBuffer.resize(dataBuffer.size() + blockSize);
         }
 
-        if (totalBytesRead > 0)
-            dataBuffer.resize(totalBytesRead / sizeof(wchar_t));
-
+        dataBuffer.resize(totalBytesRead / sizeof(wchar_t));
         return dataBuffer;
     }
 }
\ No newline at end of file
@@ -0,0 +1,440 @@
+#include "pch.hpp"
+#include <cstring>
+#include <stdexcept>
+#include "include/Error/Win32Error.hpp"
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/Pipes/CompletionPortPipeServer.hpp"
+
+namespace Boring32::Async
+{
+	namespace
+	{
+		// Posted once per worker to stop it.
+		constexpr ULONG_PTR ShutdownKey = ~static_cast<ULONG_PTR>(0);
+		// Completed operations leave an NTSTATUS in OVERLAPPED::Internal.
+		constexpr DWORD StatusSuccess = 0;
+		// A message-mode read of a message larger than the buffer.
+		constexpr DWORD StatusBufferOverflow = 0x80000005;
+
+		template<typename TFunc, typename...TArgs>
+		void Invoke(const TFunc& func, TArgs&&...args) noexcept
+		{
+			if (func == nullptr)
+				return;
+			try
+			{
+				func(std::forward<TArgs>(args)...);
+			}
+			catch (const std::exception& ex)
+			{
+				std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+			}
+			catch (...)
+			{
+				std::wcerr << __FUNCSIG__ << L" unknown exception" << std::endl;
+			}
+		}
+
+		CompletionPortPipeServer::ConnectionId MakeId(const size_t index, const uint32_t generation) noexcept
+		{
+			return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(index);
+		}
+	}
+
+	CompletionPortPipeServer::~CompletionPortPipeServer()
+	{
+		Close();
+	}
+
+	CompletionPortPipeServer::CompletionPortPipeServer(
+		const std::wstring& pipeName,
+		const DWORD instanceCount,
+		const DWORD bufferSize,
+		const DWORD workerCount,
+		const std::wstring& sid,
+		const bool isLocalPipe,
+		Handlers handlers
+	)
+	:	m_handlers(std::move(handlers)),
+		m_writePool(bufferSize, instanceCount)
+	{
+		if (instanceCount == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": instanceCount must be greater than 0");
+		if (workerCount == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": workerCount must be greater than 0");
+
+		m_completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, workerCount);
+		if (m_completionPort == nullptr)
+			throw Error::Win32Error(__FUNCSIG__ ": CreateIoCompletionPort() failed", GetLastError());
+
+		m_instances.reserve(instanceCount);
+		for (DWORD i = 0; i < instanceCount; i++)
+		{
+			auto instance = std::make_unique<Instance>();
+			instance->Server = OverlappedNamedPipeServer(
+				pipeName,
+				bufferSize,
+				instanceCount,
+				sid,
+				false,
+				isLocalPipe
+			);
+			instance->Buffer.resize(bufferSize);
+			// The instance index is the completion key.
+			const HANDLE port = CreateIoCompletionPort(
+				instance->Server.GetInternalHandle().GetHandle(),
+				m_completionPort.GetHandle(),
+				i,
+				0
+			);
+			if (port == nullptr)
+				throw Error::Win32Error(__FUNCSIG__ ": CreateIoCompletionPort() failed", GetLastError());
+			m_instances.push_back(std::move(instance));
+		}
+		m_pipeName = m_instances.front()->Server.GetName();
+
+		m_workers.reserve(workerCount);
+		try
+		{
+			for (DWORD i = 0; i < workerCount; i++)
+				m_workers.emplace_back([this] { Run(); });
+		}
+		catch (...)
+		{
+			Close();
+			throw;
+		}
+		for (size_t i = 0; i < m_instances.size(); i++)
+			ArmConnect(i);
+	}
+
+	void CompletionPortPipeServer::Close()
+	{
+		if (m_isClosing.exchange(true))
+			return;
+
+		// Anything armed after the flag is set sees it under the instance
+		// lock, so cancelling under the same lock catches every operation.
+		for (std::unique_ptr<Instance>& instance : m_instances)
+		{
+			AcquireSRWLockExclusive(&instance->Lock);
+			CancelIoEx(instance->Server.GetInternalHandle().GetHandle(), nullptr);
+			ReleaseSRWLockExclusive(&instance->Lock);
+		}
+		// Cancelled operations still post their completions, which must be
+		// drained before the instances they point into can be freed.
+		while (true)
+		{
+			const uint32_t outstanding = m_outstanding.load();
+			if (outstanding == 0)
+				break;
+			WaitOnValue(m_outstanding, outstanding, INFINITE);
+		}
+
+		for (size_t i = 0; i < m_workers.size(); i++)
+			PostQueuedCompletionStatus(m_completionPort.GetHandle(), 0, ShutdownKey, nullptr);
+		for (std::thread& worker : m_workers)
+		{
+			if (worker.joinable())
+				worker.join();
+		}
+		m_workers.clear();
+		m_instances.clear();
+		m_completionPort.Close();
+		m_connections = 0;
+	}
+
+	bool CompletionPortPipeServer::Send(const ConnectionId id, std::span<const std::byte> message)
+	{
+		if (message.size() > MAXDWORD)
+			throw std::invalid_argument(__FUNCSIG__ ": message is too large");
+
+		Instance* instance = Find(id);
+		if (instance == nullptr)
+			return false;
+
+		IoOperation* op = m_writePool.Acquire(static_cast<DWORD>(message.size()));
+		if (message.empty() == false)
+			std::memcpy(op->Buffer, message.data(), message.size());
+
+		AcquireSRWLockShared(&instance->Lock);
+		if (m_isClosing
+			|| instance->State != InstanceState::Connected
+			|| instance->Generation != static_cast<uint32_t>(id >> 32))
+		{
+			ReleaseSRWLockShared(&instance->Lock);
+			m_writePool.Release(op);
+			return false;
+		}
+		m_outstanding++;
+		const bool succeeded = WriteFile(
+			instance->Server.GetInternalHandle().GetHandle(),
+			op->Buffer,
+			op->Length,
+			nullptr,
+			&op->Overlapped
+		);
+		const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+		ReleaseSRWLockShared(&instance->Lock);
+
+		// A write that fails outright doesn't queue a completion.
+		if (succeeded == false && lastError != ERROR_IO_PENDING)
+		{
+			m_writePool.Release(op);
+			CompleteOperation();
+			return false;
+		}
+		// Released by the worker that dequeues the completion.
+		return true;
+	}
+
+	bool CompletionPortPipeServer::Disconnect(const ConnectionId id)
+	{
+		Instance* instance = Find(id);
+		if (instance == nullptr)
+			return false;
+
+		AcquireSRWLockShared(&instance->Lock);
+		const bool isCurrent = instance->State == InstanceState::Connected
+			&& instance->Generation == static_cast<uint32_t>(id >> 32);
+		// The pending read fails, and the worker resets the instance.
+		if (isCurrent)
+			instance->Server.Disconnect();
+		ReleaseSRWLockShared(&instance->Lock);
+		return isCurrent;
+	}
+
+	size_t CompletionPortPipeServer::GetConnectionCount() const noexcept
+	{
+		return m_connections;
+	}
+
+	size_t CompletionPortPipeServer::GetInstanceCount() const noexcept
+	{
+		return m_instances.size();
+	}
+
+	const std::wstring& CompletionPortPipeServer::GetName() const noexcept
+	{
+		return m_pipeName;
+	}
+
+	void CompletionPortPipeServer::Run() noexcept
+	{
+		OVERLAPPED_ENTRY entries[CompletionBatchSize];
+		while (true)
+		{
+			ULONG count = 0;
+			const bool succeeded = GetQueuedCompletionStatusEx(
+				m_completionPort.GetHandle(),
+				entries,
+				CompletionBatchSize,
+				&count,
+				INFINITE,
+				false
+			);
+			if (succeeded == false)
+			{
+				std::wcerr
+					<< __FUNCSIG__
+					<< L": GetQueuedCompletionStatusEx() failed: "
+					<< GetLastError()
+					<< std::endl;
+				return;
+			}
+
+			ULONG shutdowns = 0;
+			for (ULONG i = 0; i < count; i++)
+			{
+				if (entries[i].lpCompletionKey == ShutdownKey)
+					shutdowns++;
+				else
+					OnCompletion(entries[i]);
+			}
+			if (shutdowns == 0)
+				continue;
+			// One batch can take the packets meant for other workers.
+			for (ULONG i = 1; i < shutdowns; i++)
+				PostQueuedCompletionStatus(m_completionPort.GetHandle(), 0, ShutdownKey, nullptr);
+			return;
+		}
+	}
+
+	void CompletionPortPipeServer::OnCompletion(const OVERLAPPED_ENTRY& entry) noexcept
+	{
+		const size_t index = entry.lpCompletionKey;
+		Instance& instance = *m_instances[index];
+		const DWORD status = static_cast<DWORD>(entry.lpOverlapped->Internal);
+
+		if (entry.lpOverlapped != &instance.Overlapped)
+		{
+			// Write failures surface through the pending read.
+			m_writePool.Release(IoOperation::FromOverlapped(entry.lpOverlapped));
+			CompleteOperation();
+			return;
+		}
+
+		if (instance.State == InstanceState::Connecting)
+		{
+			if (status == StatusSuccess)
+				OnConnected(index);
+			else
+				Reset(index);
+			CompleteOperation();
+			return;
+		}
+
+		const std::span<const std::byte> received(
+			instance.Buffer.data(),
+			entry.dwNumberOfBytesTransferred
+		);
+		if (status == StatusBufferOverflow)
+		{
+			instance.Partial.insert(instance.Partial.end(), received.begin(), received.end());
+			ArmRead(index);
+		}
+		else if (status == StatusSuccess)
+		{
+			const ConnectionId id = MakeId(index, instance.Generation);
+			if (instance.Partial.empty())
+			{
+				Invoke(m_handlers.OnMessage, id, received);
+			}
+			else
+			{
+				instance.Partial.insert(instance.Partial.end(), received.begin(), received.end());
+				Invoke(m_handlers.OnMessage, id, std::span<const std::byte>(instance.Partial));
+				instance.Partial.clear();
+			}
+			ArmRead(index);
+		}
+		else
+		{
+			Reset(index);
+		}
+		// Only after the instance is no longer touched, as Close() frees it
+		// once this drops to zero.
+		CompleteOperation();
+	}
+
+	void CompletionPortPipeServer::ArmConnect(const size_t index) noexcept
+	{
+		Instance& instance = *m_instances[index];
+		while (true)
+		{
+			AcquireSRWLockExclusive(&instance.Lock);
+			if (m_isClosing)
+			{
+				ReleaseSRWLockExclusive(&instance.Lock);
+				return;
+			}
+			m_outstanding++;
+			instance.Overlapped = {};
+			const bool succeeded = ConnectNamedPipe(
+				instance.Server.GetInternalHandle().GetHandle(),
+				&instance.Overlapped
+			);
+			const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+			ReleaseSRWLockExclusive(&instance.Lock);
+			if (succeeded || lastError == ERROR_IO_PENDING)
+				return;
+
+			// The remaining outcomes don't queue a completion.
+			CompleteOperation();
+			if (lastError == ERROR_PIPE_CONNECTED)
+			{
+				// A client connected between DisconnectNamedPipe() and here.
+				OnConnected(index);
+				return;
+			}
+			if (lastError == ERROR_NO_DATA)
+			{
+				// The client connected and already closed its end.
+				instance.Server.Disconnect();
+				continue;
+			}
+			std::wcerr
+				<< __FUNCSIG__
+				<< L": ConnectNamedPipe() failed, instance is no longer listening: "
+				<< lastError
+				<< std::endl;
+			return;
+		}
+	}
+
+	void CompletionPortPipeServer::ArmRead(const size_t index) noexcept
+	{
+		Instance& instance = *m_instances[index];
+		AcquireSRWLockShared(&instance.Lock);
+		if (m_isClosing)
+		{
+			ReleaseSRWLockShared(&instance.Lock);
+			Reset(index);
+			return;
+		}
+		m_outstanding++;
+		instance.Overlapped = {};
+		const bool succeeded = ReadFile(
+			instance.Server.GetInternalHandle().GetHandle(),
+			instance.Buffer.data(),
+			static_cast<DWORD>(instance.Buffer.size()),
+			nullptr,
+			&instance.Overlapped
+		);
+		const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+		ReleaseSRWLockShared(&instance.Lock);
+		// Synchronous completions, including partial messages, are still
+		// queued to the port.
+		if (succeeded || lastError == ERROR_IO_PENDING || lastError == ERROR_MORE_DATA)
+			return;
+
+		CompleteOperation();
+		Reset(index);
+	}
+
+	void CompletionPortPipeServer::Reset(const size_t index) noexcept
+	{
+		Instance& instance = *m_instances[index];
+		AcquireSRWLockExclusive(&instance.Lock);
+		const bool wasConnected = instance.State == InstanceState::Connected;
+		const ConnectionId id = MakeId(index, instance.Generation);
+		instance.State = InstanceState::Connecting;
+		instance.Server.Disconnect();
+		ReleaseSRWLockExclusive(&instance.Lock);
+		instance.Partial.clear();
+
+		if (wasConnected)
+		{
+			m_connections--;
+			Invoke(m_handlers.OnDisconnect, id);
+		}
+		ArmConnect(index);
+	}
+
+	void CompletionPortPipeServer::OnConnected(const size_t index) noexcept
+	{
+		Instance& instance = *m_instances[index];
+		AcquireSRWLockExclusive(&instance.Lock);
+		instance.State = InstanceState::Connected;
+		const ConnectionId id = MakeId(index, ++instance.Generation);
+		ReleaseSRWLockExclusive(&instance.Lock);
+
+		m_connections++;
+		Invoke(m_handlers.OnConnect, id);
+		ArmRead(index);
+	}
+
+	CompletionPortPipeServer::Instance* CompletionPortPipeServer::Find(const ConnectionId id) noexcept
+	{
+		const size_t index = static_cast<uint32_t>(id);
+		if (index >= m_instances.size())
+			return nullptr;
+		return m_instances[index].get();
+	}
+
+	void CompletionPortPipeServer::CompleteOperation() noexcept
+	{
+		if (--m_outstanding == 0)
+			WakeAllWaiters(m_outstanding);
+	}
+}
\ No newline at end of file
@@ -133,6 +133,91 @@ namespace Boring32::Async
 		return bytesLeft / sizeof(wchar_t);
 	}
 
+	DWORD NamedPipeClientBase::UnreadBytesRemaining() const
+	{
+		if (m_handle == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": no pipe to read from");
+		DWORD bytesLeft = 0;
+		if (PeekNamedPipe(m_handle.GetHandle(), nullptr, 0, nullptr, nullptr, &bytesLeft) == false)
+			throw Error::Win32Error(__FUNCSIG__ ": PeekNamedPipe() failed", GetLastError());
+		return bytesLeft;
+	}
+
+	DWORD NamedPipeClientBase::WriteBytes(
+		std::span<const std::byte> data, 
+		DWORD* bytesWritten, 
+		OVERLAPPED* overlapped
+	)
+	{
+		if (m_handle == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": no pipe to write to");
+		if (data.size() > MAXDWORD)
+			throw std::invalid_argument(__FUNCSIG__ ": data is too large");
+
+		// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-writefile
+		const bool succeeded = WriteFile(
+			m_handle.GetHandle(),			// pipe handle 
+			data.data(),					// message 
+			static_cast<DWORD>(data.size()),// message length, in bytes
+			bytesWritten,					// bytes written 
+			overlapped						// overlapped 
+		);
+		const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+		if (lastError != ERROR_SUCCESS && lastError != ERROR_IO_PENDING)
+			throw Error::Win32Error(__FUNCSIG__ ": WriteFile() failed", lastError);
+		return lastError;
+	}
+
+	DWORD NamedPipeClientBase::WriteGathered(
+		std::span<const std::span<const std::byte>> buffers,
+		DWORD* bytesWritten,
+		OVERLAPPED* overlapped
+	)
+	{
+		size_t totalSize = 0;
+		for (const std::span<const std::byte>& buffer : buffers)
+			totalSize += buffer.size();
+		if (totalSize > MAXDWORD)
+			throw std::invalid_argument(__FUNCSIG__ ": data is too large");
+
+		m_gatherBuffer.clear();
+		m_gatherBuffer.reserve(totalSize);
+		for (const std::span<const std::byte>& buffer : buffers)
+			m_gatherBuffer.insert(m_gatherBuffer.end(), buffer.begin(), buffer.end());
+		return WriteBytes(m_gatherBuffer, bytesWritten, overlapped);
+	}
+
+	DWORD NamedPipeClientBase::ReadBytes(
+		std::span<std::byte> buffer, 
+		DWORD* bytesRead, 
+		OVERLAPPED* overlapped
+	)
+	{
+		if (m_handle == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": no pipe to read from");
+		if (buffer.size() > MAXDWORD)
+			throw std::invalid_argument(__FUNCSIG__ ": buffer is too large");
+
+		// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-readfile
+		const bool succeeded = ReadFile(
+			m_handle.GetHandle(),				// pipe handle 
+			buffer.data(),						// buffer to receive reply 
+			static_cast<DWORD>(buffer.size()),	// size of buffer, in bytes 
+			bytesRead,							// number of bytes read 
+			overlapped							// overlapped
+		);
+		const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+		if (
+			lastError != ERROR_SUCCESS
+			&& lastError != ERROR_IO_PENDING
+			&& lastError != ERROR_MORE_DATA
+		)
+		{
+			throw Error::Win32Error(__FUNCSIG__ ": ReadFile() failed", lastError);
+		}
+		return lastError;
+	}
+
 	void NamedPipeClientBase::Flush()
 	{
 		if (m_handle == nullptr)
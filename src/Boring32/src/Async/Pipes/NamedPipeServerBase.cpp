@@ -1,4 +1,5 @@
 #include "pch.hpp"
+#include <stdexcept>
 #include <Sddl.h>
 #include "include/Error/Win32Error.hpp"
 #include "include/Async/Pipes/NamedPipeServerBase.hpp"
@@ -228,6 +229,71 @@ namespace Boring32::Async
         return true;
     }
 
+    DWORD NamedPipeServerBase::UnreadBytesRemaining() const
+    {
+        if (m_pipe == nullptr)
+            throw std::runtime_error(__FUNCSIG__ ": no pipe to read from");
+        DWORD bytesRemaining = 0;
+        if (PeekNamedPipe(m_pipe.GetHandle(), nullptr, 0, nullptr, nullptr, &bytesRemaining) == false)
+            throw Error::Win32Error(__FUNCSIG__ ": PeekNamedPipe() failed", GetLastError());
+        return bytesRemaining;
+    }
+
+    DWORD NamedPipeServerBase::WriteBytes(
+        std::span<const std::byte> data,
+        DWORD* bytesWritten,
+        OVERLAPPED* overlapped
+    )
+    {
+        if (m_pipe == nullptr)
+            throw std::runtime_error(__FUNCSIG__ ": no pipe to write to");
+        if (data.size() > MAXDWORD)
+            throw std::invalid_argument(__FUNCSIG__ ": data is too large");
+
+        const bool succeeded = WriteFile(
+            m_pipe.GetHandle(),                 // handle to pipe 
+            data.data(),                        // buffer to write from 
+            static_cast<DWORD>(data.size()),    // number of bytes to write 
+            bytesWritten,                       // number of bytes written 
+            overlapped                          // overlapped I/O, if any
+        );
+        const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+        if (lastError != ERROR_SUCCESS && lastError != ERROR_IO_PENDING)
+            throw Error::Win32Error(__FUNCSIG__ ": WriteFile() failed", lastError);
+        return lastError;
+    }
+
+    DWORD NamedPipeServerBase::ReadBytes(
+        std::span<std::byte> buffer,
+        DWORD* bytesRead,
+        OVERLAPPED* overlapped
+    )
+    {
+        if (m_pipe == nullptr)
+            throw std::runtime_error(__FUNCSIG__ ": no pipe to read from");
+        if (buffer.size() > MAXDWORD)
+            throw std::invalid_argument(__FUNCSIG__ ": buffer is too large");
+
+        // https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-readfile
+        const bool succeeded = ReadFile(
+            m_pipe.GetHandle(),                 // pipe handle 
+            buffer.data(),                      // buffer to receive data 
+            static_cast<DWORD>(buffer.size()),  // size of buffer, in bytes
+            bytesRead,                          // number of bytes read 
+            overlapped                          // overlapped I/O, if any
+        );
+        const DWORD lastError = succeeded ? ERROR_SUCCESS : GetLastError();
+        if (
+            lastError != ERROR_SUCCESS
+            && lastError != ERROR_IO_PENDING
+            && lastError != ERROR_MORE_DATA
+        )
+        {
+            throw Error::Win32Error(__FUNCSIG__ ": ReadFile() failed", lastError);
+        }
+        return lastError;
+    }
+
     void NamedPipeServerBase::Flush()
     {
         if (m_pipe == nullptr)
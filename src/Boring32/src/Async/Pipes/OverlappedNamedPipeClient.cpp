@@ -1,4 +1,5 @@
 #include "pch.hpp"
+#include <cstring>
 #include <stdexcept>
 #include "include/Error/Win32Error.hpp"
 #include "include/Strings/Strings.hpp"
@@ -60,20 +61,95 @@ namespace Boring32::Async
 
 	void OverlappedNamedPipeClient::InternalWrite(const std::wstring& msg, OverlappedIo& oio)
 	{
-		if (m_handle == nullptr)
-			throw std::runtime_error("OverlappedNamedPipeClient::InternalWrite(): No pipe to write to");
+		oio.Reset();
+		oio.LastError(WriteBytes(std::as_bytes(std::span(msg)), nullptr, oio.GetOverlapped()));
+	}
 
-		oio = OverlappedIo();
-		// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-writefile
-		bool succeeded = WriteFile(
-			m_handle.GetHandle(),					// pipe handle 
-			msg.c_str(),							// message 
-			(DWORD)(msg.size()*sizeof(wchar_t)),	// message length, in bytes
-			nullptr,								// bytes written 
-			oio.GetOverlapped());					// overlapped 
-		oio.LastError(GetLastError());
-		if (succeeded == false && oio.LastError() != ERROR_IO_PENDING)
-			throw Error::Win32Error("OverlappedNamedPipeClient::InternalWrite(): WriteFile() failed", oio.LastError());
+	void OverlappedNamedPipeClient::Write(std::span<const std::byte> data, OverlappedOp& op)
+	{
+		op.Reset();
+		op.LastError(WriteBytes(data, nullptr, op.GetOverlapped()));
+	}
+
+	bool OverlappedNamedPipeClient::Write(std::span<const std::byte> data, OverlappedOp& op, std::nothrow_t) noexcept
+	{
+		try
+		{
+			Write(data, op);
+			return true;
+		}
+		catch (const std::exception& ex)
+		{
+			std::wcerr 
+				<< L"OverlappedNamedPipeClient::Write(): " 
+				<< ex.what() 
+				<< std::endl;
+			return false;
+		}
+	}
+
+	void OverlappedNamedPipeClient::Write(std::span<const std::span<const std::byte>> buffers, OverlappedOp& op)
+	{
+		op.Reset();
+		op.LastError(WriteGathered(buffers, nullptr, op.GetOverlapped()));
+	}
+
+	void OverlappedNamedPipeClient::Read(std::span<std::byte> buffer, OverlappedOp& op)
+	{
+		op.Reset();
+		op.LastError(ReadBytes(buffer, nullptr, op.GetOverlapped()));
+	}
+
+	bool OverlappedNamedPipeClient::Read(std::span<std::byte> buffer, OverlappedOp& op, std::nothrow_t) noexcept
+	{
+		try
+		{
+			Read(buffer, op);
+			return true;
+		}
+		catch (const std::exception& ex)
+		{
+			std::wcerr
+				<< L"OverlappedNamedPipeClient::Read(): "
+				<< ex.what()
+				<< std::endl;
+			return false;
+		}
+	}
+
+	IoOperation* OverlappedNamedPipeClient::Write(std::span<const std::byte> data, IoOperationPool& pool)
+	{
+		if (data.size() > MAXDWORD)
+			throw std::invalid_argument(__FUNCSIG__ ": data is too large");
+		IoOperation* op = pool.AcquireWaitable(static_cast<DWORD>(data.size()));
+		if (data.empty() == false)
+			std::memcpy(op->Buffer, data.data(), data.size());
+		try
+		{
+			WriteBytes(op->GetBuffer(), nullptr, &op->Overlapped);
+		}
+		catch (...)
+		{
+			pool.Release(op);
+			throw;
+		}
+		return op;
+	}
+
+	IoOperation* OverlappedNamedPipeClient::Read(const DWORD size, IoOperationPool& pool)
+	{
+		IoOperation* op = pool.AcquireWaitable(size);
+		try
+		{
+			// A message that doesn't fit is reported through IsPartial().
+			ReadBytes(op->GetBuffer(), nullptr, &op->Overlapped);
+		}
+		catch (...)
+		{
+			pool.Release(op);
+			throw;
+		}
+		return op;
 	}
 
 	void OverlappedNamedPipeClient::Read(const DWORD noOfCharacters, OverlappedIo& op)
@@ -100,26 +176,8 @@ namespace Boring32::Async
 
 	void OverlappedNamedPipeClient::InternalRead(const DWORD noOfCharacters, OverlappedIo& oio)
 	{
-		if (m_handle == nullptr)
-			throw std::runtime_error("OverlappedNamedPipeClient::InternalRead(): No pipe to read from");
-
-		oio = OverlappedIo();
+		oio.Reset();
 		oio.IoBuffer.resize(noOfCharacters);
-		// https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-readfile
-		bool succeeded = ReadFile(
-			m_handle.GetHandle(),							// pipe handle 
-			&oio.IoBuffer[0],								// buffer to receive reply 
-			(DWORD)(oio.IoBuffer.size()*sizeof(wchar_t)),	// size of buffer, in bytes 
-			nullptr,										// number of bytes read 
-			oio.GetOverlapped());							// overlapped
-		oio.LastError(GetLastError());
-		if ( 
-			succeeded == false 
-			&& oio.LastError() != ERROR_IO_PENDING
-			&& oio.LastError() != ERROR_MORE_DATA
-		)
-		{
-			throw Error::Win32Error("OverlappedNamedPipeClient::InternalRead(): ReadFile() failed", oio.LastError());
-		}
+		oio.LastError(ReadBytes(std::as_writable_bytes(std::span(oio.IoBuffer)), nullptr, oio.GetOverlapped()));
 	}
 }
\ No newline at end of file
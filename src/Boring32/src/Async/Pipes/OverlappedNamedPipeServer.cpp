@@ -1,4 +1,5 @@
 #include "pch.hpp"
+#include <cstring>
 #include <stdexcept>
 #include "include/Error/Win32Error.hpp"
 #include "include/Async/Pipes/OverlappedNamedPipeServer.hpp"
@@ -107,7 +108,7 @@ namespace Boring32::Async
     {
         if (m_pipe == nullptr)
             throw std::runtime_error("OverlappedNamedPipeServer::Connect(): No valid pipe handle to connect");
-        oio = OverlappedOp();
+        oio.Reset();
         bool succeeded = ConnectNamedPipe(m_pipe.GetHandle(), oio.GetOverlapped());
         oio.LastError(GetLastError());
         if (succeeded == false && oio.LastError() != ERROR_IO_PENDING)
@@ -150,20 +151,89 @@ namespace Boring32::Async
 
     void OverlappedNamedPipeServer::InternalWrite(const std::wstring& msg, OverlappedIo& oio)
     {
-        if (m_pipe == nullptr)
-            throw std::runtime_error("OverlappedNamedPipeServer::InternalWrite(): No pipe to write to");
-
-        oio = OverlappedIo();
-        bool succeeded = WriteFile(
-            m_pipe.GetHandle(),     // handle to pipe 
-            &msg[0],                // buffer to write from 
-            (DWORD)(msg.size()*sizeof(wchar_t)), // number of bytes to write 
-            nullptr,          // number of bytes written 
-            oio.GetOverlapped()       // overlapped I/O
-        );
-        oio.LastError(GetLastError());
-        if (succeeded == false && oio.LastError() != ERROR_IO_PENDING)
-            throw Error::Win32Error("OverlappedNamedPipeServer::Write(): WriteFile() failed", oio.LastError());
+        oio.Reset();
+        oio.LastError(WriteBytes(std::as_bytes(std::span(msg)), nullptr, oio.GetOverlapped()));
+    }
+
+    void OverlappedNamedPipeServer::Write(std::span<const std::byte> data, OverlappedOp& op)
+    {
+        op.Reset();
+        op.LastError(WriteBytes(data, nullptr, op.GetOverlapped()));
+    }
+
+    bool OverlappedNamedPipeServer::Write(std::span<const std::byte> data, OverlappedOp& op, std::nothrow_t) noexcept
+    {
+        try
+        {
+            Write(data, op);
+            return true;
+        }
+        catch (const std::exception& ex)
+        {
+            std::wcerr
+                << L"OverlappedNamedPipeServer::Write(): "
+                << ex.what()
+                << std::endl;
+            return false;
+        }
+    }
+
+    void OverlappedNamedPipeServer::Read(std::span<std::byte> buffer, OverlappedOp& op)
+    {
+        op.Reset();
+        op.LastError(ReadBytes(buffer, nullptr, op.GetOverlapped()));
+    }
+
+    bool OverlappedNamedPipeServer::Read(std::span<std::byte> buffer, OverlappedOp& op, std::nothrow_t) noexcept
+    {
+        try
+        {
+            Read(buffer, op);
+            return true;
+        }
+        catch (const std::exception& ex)
+        {
+            std::wcerr
+                << L"OverlappedNamedPipeServer::Read(): "
+                << ex.what()
+                << std::endl;
+            return false;
+        }
+    }
+
+    IoOperation* OverlappedNamedPipeServer::Write(std::span<const std::byte> data, IoOperationPool& pool)
+    {
+        if (data.size() > MAXDWORD)
+            throw std::invalid_argument(__FUNCSIG__ ": data is too large");
+        IoOperation* op = pool.AcquireWaitable(static_cast<DWORD>(data.size()));
+        if (data.empty() == false)
+            std::memcpy(op->Buffer, data.data(), data.size());
+        try
+        {
+            WriteBytes(op->GetBuffer(), nullptr, &op->Overlapped);
+        }
+        catch (...)
+        {
+            pool.Release(op);
+            throw;
+        }
+        return op;
+    }
+
+    IoOperation* OverlappedNamedPipeServer::Read(const DWORD size, IoOperationPool& pool)
+    {
+        IoOperation* op = pool.AcquireWaitable(size);
+        try
+        {
+            // A message that doesn't fit is reported through IsPartial().
+            ReadBytes(op->GetBuffer(), nullptr, &op->Overlapped);
+        }
+        catch (...)
+        {
+            pool.Release(op);
+            throw;
+        }
+        return op;
     }
 
     void OverlappedNamedPipeServer::Read(const DWORD noOfCharacters, OverlappedIo& oio)
@@ -190,26 +260,8 @@ namespace Boring32::Async
 
     void OverlappedNamedPipeServer::InternalRead(const DWORD noOfCharacters, OverlappedIo& oio)
     {
-        if (m_pipe == nullptr)
-            throw std::runtime_error("OverlappedNamedPipeServer::InternalRead(): No pipe to read from");
-
-        oio = OverlappedIo();
+        oio.Reset();
         oio.IoBuffer.resize(noOfCharacters);
-
-        bool succeeded = ReadFile(
-            m_pipe.GetHandle(),                             // pipe handle 
-            &oio.IoBuffer[0],                               // buffer to receive reply 
-            (DWORD)(oio.IoBuffer.size()*sizeof(wchar_t)),   // size of buffer, in bytes
-            nullptr,                                        // number of bytes read 
-            oio.GetOverlapped());                           // overlapped
-        oio.LastError(GetLastError());
-        if (
-            succeeded == false
-            && oio.LastError() != ERROR_IO_PENDING
-            && oio.LastError() != ERROR_MORE_DATA
-        )
-        {
-            throw Error::Win32Error("OverlappedNamedPipeServer::Read(): ReadFile() failed", oio.LastError());
-        }
+        oio.LastError(ReadBytes(std::as_writable_bytes(std::span(oio.IoBuffer)), nullptr, oio.GetOverlapped()));
     }
 }
@@ -0,0 +1,115 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/ReaderBiasedLock.hpp"
+
+namespace Boring32::Async
+{
+	ReaderBiasedLock::~ReaderBiasedLock() { }
+
+	ReaderBiasedLock::ReaderBiasedLock()
+	:	ReaderBiasedLock(DefaultStripeCount)
+	{ }
+
+	ReaderBiasedLock::ReaderBiasedLock(const size_t stripeCount)
+	:	m_stripeMask(stripeCount - 1),
+		m_threadOwningExclusiveLock(0),
+		m_writerActive(0)
+	{
+		if (stripeCount == 0 || (stripeCount & (stripeCount - 1)) != 0)
+			throw std::invalid_argument(__FUNCSIG__ ": stripeCount must be a power of two");
+		m_stripes = std::make_unique<Stripe[]>(stripeCount);
+		InitializeSRWLock(&m_writerLock);
+	}
+
+	bool ReaderBiasedLock::TryAcquireSharedLock()
+	{
+		Stripe& stripe = GetStripe();
+		// Both sides are sequentially consistent: either the writer sees our
+		// count when it scans, or we see its flag here.
+		stripe.Readers.fetch_add(1, std::memory_order_seq_cst);
+		if (m_writerActive.load(std::memory_order_seq_cst) == 0)
+			return true;
+		LeaveStripe(stripe);
+		return false;
+	}
+
+	bool ReaderBiasedLock::TryAcquireExclusiveLock()
+	{
+		const DWORD currentThreadId = GetCurrentThreadId();
+		if (m_threadOwningExclusiveLock.load(std::memory_order_relaxed) == currentThreadId)
+			return true;
+		if (TryAcquireSRWLockExclusive(&m_writerLock) == false)
+			return false;
+
+		m_writerActive.store(1, std::memory_order_seq_cst);
+		for (size_t i = 0; i <= m_stripeMask; i++)
+		{
+			if (m_stripes[i].Readers.load(std::memory_order_seq_cst) == 0)
+				continue;
+			m_writerActive.store(0, std::memory_order_seq_cst);
+			WakeAllWaiters(m_writerActive);
+			ReleaseSRWLockExclusive(&m_writerLock);
+			return false;
+		}
+		m_threadOwningExclusiveLock.store(currentThreadId, std::memory_order_relaxed);
+		return true;
+	}
+
+	void ReaderBiasedLock::AcquireSharedLock()
+	{
+		while (TryAcquireSharedLock() == false)
+		{
+			while (m_writerActive.load(std::memory_order_acquire) != 0)
+				WaitOnValue(m_writerActive, 1, INFINITE);
+		}
+	}
+
+	void ReaderBiasedLock::AcquireExclusiveLock()
+	{
+		const DWORD currentThreadId = GetCurrentThreadId();
+		if (m_threadOwningExclusiveLock.load(std::memory_order_relaxed) == currentThreadId)
+			return;
+
+		AcquireSRWLockExclusive(&m_writerLock);
+		m_writerActive.store(1, std::memory_order_seq_cst);
+		// New readers now back off, so each stripe only drains.
+		for (size_t i = 0; i <= m_stripeMask; i++)
+		{
+			std::atomic<uint32_t>& readers = m_stripes[i].Readers;
+			for (uint32_t count = readers.load(std::memory_order_seq_cst); count != 0; count = readers.load(std::memory_order_seq_cst))
+				WaitOnValue(readers, count, INFINITE);
+		}
+		m_threadOwningExclusiveLock.store(currentThreadId, std::memory_order_relaxed);
+	}
+
+	void ReaderBiasedLock::ReleaseSharedLock()
+	{
+		LeaveStripe(GetStripe());
+	}
+
+	void ReaderBiasedLock::ReleaseExclusiveLock()
+	{
+		if (m_threadOwningExclusiveLock.load(std::memory_order_relaxed) != GetCurrentThreadId())
+			return;
+		m_threadOwningExclusiveLock.store(0, std::memory_order_relaxed);
+		m_writerActive.store(0, std::memory_order_seq_cst);
+		WakeAllWaiters(m_writerActive);
+		ReleaseSRWLockExclusive(&m_writerLock);
+	}
+
+	ReaderBiasedLock::Stripe& ReaderBiasedLock::GetStripe() const noexcept
+	{
+		// Thread IDs are multiples of four; the multiply spreads
+		// neighbouring IDs across the stripes.
+		const uint32_t hash = (GetCurrentThreadId() >> 2) * 0x9E3779B1u;
+		return m_stripes[(hash >> 16) & m_stripeMask];
+	}
+
+	void ReaderBiasedLock::LeaveStripe(Stripe& stripe) noexcept
+	{
+		stripe.Readers.fetch_sub(1, std::memory_order_seq_cst);
+		if (m_writerActive.load(std::memory_order_seq_cst) != 0)
+			WakeOneWaiter(stripe.Readers);
+	}
+}
\ No newline at end of file
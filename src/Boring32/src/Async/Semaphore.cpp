@@ -125,7 +125,7 @@ namespace Boring32::Async
 	{
 		if (m_handle == nullptr)
 			throw std::runtime_error("Semaphore::Release(): m_handle is nullptr");
-		if (ReleaseSemaphore(m_handle.GetHandle(), 1, 0) == false)
+		if (ReleaseSemaphore(m_handle.GetHandle(), countToRelease, 0) == false)
 			throw Error::Win32Error("Failed to release semaphore", GetLastError());
 		InterlockedAdd(&m_currentCount, countToRelease);
 	}
@@ -137,7 +137,7 @@ namespace Boring32::Async
 		DWORD status = WaitForSingleObject(m_handle.GetHandle(), millisTimeout);
 		if (status == WAIT_OBJECT_0)
 		{
-			m_currentCount--;
+			InterlockedDecrement(&m_currentCount);
 			return true;
 		}
 		if (status == WAIT_TIMEOUT)
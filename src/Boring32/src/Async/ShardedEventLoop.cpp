@@ -0,0 +1,254 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/ShardedEventLoop.hpp"
+
+namespace Boring32::Async
+{
+	ShardedEventLoop::~ShardedEventLoop()
+	{
+		Close();
+	}
+
+	ShardedEventLoop::ShardedEventLoop()
+	{
+		InitializeSRWLock(&m_lock);
+	}
+
+	void ShardedEventLoop::Close()
+	{
+		AcquireSRWLockExclusive(&m_lock);
+		std::vector<std::shared_ptr<Shard>> shards = std::move(m_shards);
+		m_shards.clear();
+		m_shardsWithSpace.clear();
+		m_registry.clear();
+		ReleaseSRWLockExclusive(&m_lock);
+
+		for (std::shared_ptr<Shard>& shard : shards)
+		{
+			AcquireSRWLockExclusive(&shard->Lock);
+			shard->IsStopping = true;
+			ReleaseSRWLockExclusive(&shard->Lock);
+			shard->Wake.Signal();
+			if (shard->Thread.joinable())
+				shard->Thread.join();
+		}
+	}
+
+	void ShardedEventLoop::On(HANDLE handle, std::function<void()> handler)
+	{
+		if (handle == nullptr)
+			throw std::invalid_argument(__FUNCSIG__ ": handle is null");
+		if (handler == nullptr)
+			throw std::invalid_argument(__FUNCSIG__ ": handler is empty");
+
+		AcquireSRWLockExclusive(&m_lock);
+		try
+		{
+			if (m_registry.contains(handle))
+				throw std::invalid_argument(__FUNCSIG__ ": handle is already registered");
+			Shard& shard = GetShardWithSpace();
+			const size_t shardIndex = m_shardsWithSpace.back();
+			m_registry.emplace(handle, shardIndex);
+			shard.Registered++;
+			if (shard.Registered == HandlesPerShard)
+			{
+				shard.HasSpace = false;
+				m_shardsWithSpace.pop_back();
+			}
+			QueueChange(shard, { .IsAdd = true, .Handle = handle, .Handler = std::move(handler) });
+		}
+		catch (...)
+		{
+			ReleaseSRWLockExclusive(&m_lock);
+			throw;
+		}
+		ReleaseSRWLockExclusive(&m_lock);
+	}
+
+	bool ShardedEventLoop::Erase(HANDLE handle)
+	{
+		AcquireSRWLockExclusive(&m_lock);
+		auto registration = m_registry.find(handle);
+		if (registration == m_registry.end())
+		{
+			ReleaseSRWLockExclusive(&m_lock);
+			return false;
+		}
+		const size_t shardIndex = registration->second;
+		m_registry.erase(registration);
+		std::shared_ptr<Shard> shard = m_shards[shardIndex];
+		shard->Registered--;
+		if (shard->HasSpace == false)
+		{
+			shard->HasSpace = true;
+			m_shardsWithSpace.push_back(shardIndex);
+		}
+		const bool isShardThread = IsShardThread();
+		const uint32_t generation = QueueChange(*shard, { .IsAdd = false, .Handle = handle });
+		ReleaseSRWLockExclusive(&m_lock);
+
+		// A handler can't wait for its own shard, and waiting for another
+		// shard could deadlock if that shard's handler is erasing from this
+		// one; the change is applied once the owning shard next wakes.
+		if (isShardThread)
+			return true;
+		// The change was queued before any Close() could stop the shard, so
+		// the shard thread applies it before exiting.
+		while (true)
+		{
+			const uint32_t applied = shard->AppliedGeneration.load(std::memory_order_acquire);
+			if (static_cast<int32_t>(applied - generation) >= 0)
+				break;
+			WaitOnValue(shard->AppliedGeneration, applied, INFINITE);
+		}
+		return true;
+	}
+
+	size_t ShardedEventLoop::Size() noexcept
+	{
+		AcquireSRWLockShared(&m_lock);
+		const size_t size = m_registry.size();
+		ReleaseSRWLockShared(&m_lock);
+		return size;
+	}
+
+	size_t ShardedEventLoop::GetShardCount() noexcept
+	{
+		AcquireSRWLockShared(&m_lock);
+		const size_t count = m_shards.size();
+		ReleaseSRWLockShared(&m_lock);
+		return count;
+	}
+
+	ShardedEventLoop::Shard& ShardedEventLoop::GetShardWithSpace()
+	{
+		if (m_shardsWithSpace.empty() == false)
+			return *m_shards[m_shardsWithSpace.back()];
+
+		auto shard = std::make_shared<Shard>();
+		shard->Wake = Event(false, false, false, L"");
+		shard->Handles.reserve(MAXIMUM_WAIT_OBJECTS);
+		shard->Handlers.reserve(MAXIMUM_WAIT_OBJECTS);
+		shard->Handles.push_back(shard->Wake.GetHandle());
+		shard->Handlers.emplace_back();
+		Shard* rawShard = shard.get();
+		shard->Thread = std::thread([this, rawShard] { Run(*rawShard); });
+
+		m_shards.push_back(std::move(shard));
+		m_shardsWithSpace.push_back(m_shards.size() - 1);
+		return *rawShard;
+	}
+
+	bool ShardedEventLoop::IsShardThread() const noexcept
+	{
+		const std::thread::id current = std::this_thread::get_id();
+		for (const std::shared_ptr<Shard>& shard : m_shards)
+		{
+			if (shard->Thread.get_id() == current)
+				return true;
+		}
+		return false;
+	}
+
+	uint32_t ShardedEventLoop::QueueChange(Shard& shard, Change change)
+	{
+		AcquireSRWLockExclusive(&shard.Lock);
+		shard.Pending.push_back(std::move(change));
+		const uint32_t generation = ++shard.RequestedGeneration;
+		ReleaseSRWLockExclusive(&shard.Lock);
+		shard.Wake.Signal();
+		return generation;
+	}
+
+	void ShardedEventLoop::Run(Shard& shard)
+	{
+		while (ApplyChanges(shard))
+		{
+			const DWORD status = WaitForMultipleObjects(
+				static_cast<DWORD>(shard.Handles.size()),
+				shard.Handles.data(),
+				false,
+				INFINITE
+			);
+			if (status == WAIT_FAILED)
+			{
+				std::wcerr
+					<< __FUNCSIG__
+					<< L": WaitForMultipleObjects() failed: "
+					<< GetLastError()
+					<< std::endl;
+				// Typically a handle was closed while still registered. Keep
+				// servicing changes so the caller can erase it.
+				WaitForSingleObject(shard.Handles[0], INFINITE);
+				continue;
+			}
+
+			size_t index = 0;
+			if (status >= WAIT_ABANDONED_0 && status < WAIT_ABANDONED_0 + shard.Handles.size())
+				index = status - WAIT_ABANDONED_0;
+			else
+				index = status - WAIT_OBJECT_0;
+			// Index 0 is the wake event; the changes are applied next iteration.
+			if (index > 0)
+				Dispatch(shard, index);
+		}
+	}
+
+	bool ShardedEventLoop::ApplyChanges(Shard& shard)
+	{
+		AcquireSRWLockExclusive(&shard.Lock);
+		std::vector<Change> changes = std::move(shard.Pending);
+		shard.Pending.clear();
+		const uint32_t generation = shard.RequestedGeneration;
+		const bool isStopping = shard.IsStopping;
+		ReleaseSRWLockExclusive(&shard.Lock);
+
+		for (Change& change : changes)
+		{
+			if (change.IsAdd)
+			{
+				shard.Slots.emplace(change.Handle, shard.Handles.size());
+				shard.Handles.push_back(change.Handle);
+				shard.Handlers.push_back(std::move(change.Handler));
+				continue;
+			}
+
+			auto slot = shard.Slots.find(change.Handle);
+			if (slot == shard.Slots.end())
+				continue;
+			// Swap the last slot into the hole so removal stays O(1).
+			const size_t index = slot->second;
+			const size_t last = shard.Handles.size() - 1;
+			if (index != last)
+			{
+				shard.Handles[index] = shard.Handles[last];
+				shard.Handlers[index] = std::move(shard.Handlers[last]);
+				shard.Slots[shard.Handles[index]] = index;
+			}
+			shard.Handles.pop_back();
+			shard.Handlers.pop_back();
+			shard.Slots.erase(slot);
+		}
+
+		shard.AppliedGeneration.store(generation, std::memory_order_release);
+		WakeAllWaiters(shard.AppliedGeneration);
+		return isStopping == false;
+	}
+
+	void ShardedEventLoop::Dispatch(Shard& shard, const size_t index) noexcept
+	{
+		try
+		{
+			shard.Handlers[index]();
+		}
+		catch (const std::exception& ex)
+		{
+			std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+		}
+		catch (...)
+		{
+			std::wcerr << __FUNCSIG__ << L" unknown exception" << std::endl;
+		}
+	}
+}
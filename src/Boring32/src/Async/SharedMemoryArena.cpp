@@ -0,0 +1,104 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/SharedMemoryArena.hpp"
+
+namespace Boring32::Async
+{
+	SharedMemoryArena::~SharedMemoryArena() { }
+
+	SharedMemoryArena::SharedMemoryArena(
+		const std::wstring& name,
+		const UINT size,
+		const bool inheritable
+	)
+	:	m_mapping(name, size, inheritable),
+		m_header(nullptr),
+		m_base(nullptr)
+	{
+		if (size <= sizeof(Header))
+			throw std::invalid_argument(__FUNCSIG__ ": size is too small");
+
+		// The mapping is zeroed when it is created.
+		Header* header = new (m_mapping.GetViewPointer()) Header();
+		header->Size = size;
+		header->Next.store(sizeof(Header), std::memory_order_relaxed);
+		header->Magic.store(HeaderMagic, std::memory_order_release);
+		Attach(size);
+	}
+
+	SharedMemoryArena::SharedMemoryArena(
+		const std::wstring& name,
+		const UINT size,
+		const bool inheritable,
+		const DWORD desiredAccess
+	)
+	:	m_mapping(name, size, inheritable, desiredAccess),
+		m_header(nullptr),
+		m_base(nullptr)
+	{
+		Attach(size);
+	}
+
+	void SharedMemoryArena::Attach(const UINT size)
+	{
+		Header* header = static_cast<Header*>(m_mapping.GetViewPointer());
+		if (header->Magic.load(std::memory_order_acquire) != HeaderMagic)
+			throw std::runtime_error(__FUNCSIG__ ": the mapping is not an initialised arena");
+		if (header->Size != size)
+			throw std::runtime_error(__FUNCSIG__ ": the arena's size does not match");
+		m_header = header;
+		m_base = reinterpret_cast<std::byte*>(header);
+	}
+
+	void* SharedMemoryArena::Allocate(const size_t size, const size_t alignment)
+	{
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > 4096)
+			throw std::invalid_argument(__FUNCSIG__ ": alignment must be a power of two no greater than 4096");
+
+		// The view is page-aligned, so aligning the offset aligns the address.
+		uint64_t next = m_header->Next.load(std::memory_order_relaxed);
+		uint64_t offset = 0;
+		do
+		{
+			offset = (next + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+			if (offset > m_header->Size || size > m_header->Size - offset)
+				throw std::bad_alloc();
+		} while (m_header->Next.compare_exchange_weak(next, offset + size, std::memory_order_relaxed) == false);
+		return m_base + offset;
+	}
+
+	void SharedMemoryArena::SetRoot(const void* root)
+	{
+		if (Contains(root) == false)
+			throw std::invalid_argument(__FUNCSIG__ ": root is not in the arena");
+		// Release, so a process that sees the root also sees what it refers to.
+		m_header->Root.store(static_cast<const std::byte*>(root) - m_base, std::memory_order_release);
+	}
+
+	void* SharedMemoryArena::GetRootPointer() const noexcept
+	{
+		const uint64_t offset = m_header->Root.load(std::memory_order_acquire);
+		return offset == 0 ? nullptr : m_base + offset;
+	}
+
+	bool SharedMemoryArena::Contains(const void* pointer) const noexcept
+	{
+		const std::byte* address = static_cast<const std::byte*>(pointer);
+		return address >= m_base + sizeof(Header) && address < m_base + m_header->Size;
+	}
+
+	size_t SharedMemoryArena::GetUsedBytes() const noexcept
+	{
+		return static_cast<size_t>(m_header->Next.load(std::memory_order_relaxed));
+	}
+
+	size_t SharedMemoryArena::GetSize() const noexcept
+	{
+		return static_cast<size_t>(m_header->Size);
+	}
+
+	const std::wstring& SharedMemoryArena::GetName() const noexcept
+	{
+		return m_mapping.GetName();
+	}
+}
\ No newline at end of file
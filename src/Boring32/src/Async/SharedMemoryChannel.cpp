@@ -0,0 +1,250 @@
+#include "pch.hpp"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include "include/Async/SharedMemoryChannel.hpp"
+
+namespace Boring32::Async
+{
+	SharedMemoryChannel::~SharedMemoryChannel() { }
+
+	SharedMemoryChannel::SharedMemoryChannel(
+		const std::wstring& name,
+		const UINT capacity,
+		const Mode mode,
+		const bool inheritable
+	)
+	:	m_name(name),
+		m_mapping(name, GetMappingSize(capacity), inheritable),
+		m_header(nullptr),
+		m_ring(nullptr),
+		m_mask(0),
+		m_isMultiProducer(false),
+		m_notEmpty(inheritable, false, false, name + L"-NotEmpty"),
+		m_notFull(inheritable, false, false, name + L"-NotFull")
+	{
+		if (mode != Mode::SingleProducer && mode != Mode::MultiProducer)
+			throw std::invalid_argument(__FUNCSIG__ ": invalid mode");
+
+		// The mapping is zeroed when it is created.
+		Header* header = new (m_mapping.GetViewPointer()) Header();
+		header->Mode = static_cast<uint32_t>(mode);
+		header->Capacity = capacity;
+		// Published last, so an opening process never sees a partial header.
+		header->Magic.store(HeaderMagic, std::memory_order_release);
+		Attach(capacity);
+	}
+
+	SharedMemoryChannel::SharedMemoryChannel(
+		const std::wstring& name,
+		const UINT capacity,
+		const bool inheritable
+	)
+	:	m_name(name),
+		m_mapping(name, GetMappingSize(capacity), inheritable, FILE_MAP_ALL_ACCESS),
+		m_header(nullptr),
+		m_ring(nullptr),
+		m_mask(0),
+		m_isMultiProducer(false),
+		m_notEmpty(inheritable, false, name + L"-NotEmpty", EVENT_ALL_ACCESS),
+		m_notFull(inheritable, false, name + L"-NotFull", EVENT_ALL_ACCESS)
+	{
+		Attach(capacity);
+	}
+
+	UINT SharedMemoryChannel::GetMappingSize(const UINT capacity)
+	{
+		if (capacity < CacheLineSize || (capacity & (capacity - 1)) != 0)
+			throw std::invalid_argument(__FUNCSIG__ ": capacity must be a power of two of at least 64");
+		if (capacity > MAXDWORD - sizeof(Header))
+			throw std::invalid_argument(__FUNCSIG__ ": capacity is too large");
+		return static_cast<UINT>(sizeof(Header) + capacity);
+	}
+
+	uint64_t SharedMemoryChannel::GetRecordSize(const uint64_t length) noexcept
+	{
+		return (RecordHeaderSize + length + RecordAlignment - 1) & ~static_cast<uint64_t>(RecordAlignment - 1);
+	}
+
+	void SharedMemoryChannel::Attach(const UINT capacity)
+	{
+		Header* header = static_cast<Header*>(m_mapping.GetViewPointer());
+		if (header->Magic.load(std::memory_order_acquire) != HeaderMagic)
+			throw std::runtime_error(__FUNCSIG__ ": the mapping is not an initialised channel");
+		if (header->Capacity != capacity)
+			throw std::runtime_error(__FUNCSIG__ ": the channel's capacity does not match");
+
+		m_header = header;
+		// sizeof(Header) is a multiple of the cache line size, so the ring
+		// starts on its own cache line.
+		m_ring = reinterpret_cast<std::byte*>(header) + sizeof(Header);
+		m_mask = static_cast<uint64_t>(capacity) - 1;
+		m_isMultiProducer = header->Mode == static_cast<uint32_t>(Mode::MultiProducer);
+	}
+
+	bool SharedMemoryChannel::TrySend(std::span<const std::byte> message)
+	{
+		if (message.size() > GetMaxMessageSize())
+			throw std::invalid_argument(__FUNCSIG__ ": message is too large");
+
+		const uint64_t capacity = m_mask + 1;
+		const uint64_t recordSize = GetRecordSize(message.size());
+		uint64_t position = m_header->WritePosition.load(std::memory_order_relaxed);
+		while (true)
+		{
+			const uint64_t readPosition = m_header->ReadPosition.load(std::memory_order_acquire);
+			// A stale position from before the receiver caught up.
+			if (static_cast<int64_t>(position - readPosition) < 0)
+			{
+				position = m_header->WritePosition.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			// Records never wrap. If this one doesn't fit before the end of
+			// the ring, the rest of the ring is claimed as padding first.
+			const uint64_t contiguous = capacity - (position & m_mask);
+			const bool isPadding = recordSize > contiguous;
+			const uint64_t claim = isPadding ? contiguous : recordSize;
+			if (position + claim - readPosition > capacity)
+				return false;
+
+			if (m_isMultiProducer)
+			{
+				if (m_header->WritePosition.compare_exchange_weak(position, position + claim, std::memory_order_relaxed) == false)
+					continue;
+			}
+			else
+			{
+				m_header->WritePosition.store(position + claim, std::memory_order_relaxed);
+			}
+
+			uint64_t* record = GetRecord(position);
+			if (isPadding)
+			{
+				std::atomic_ref<uint64_t>(*record).store(
+					CommittedFlag | PaddingFlag | (contiguous - RecordHeaderSize),
+					std::memory_order_release
+				);
+				// The record may still not fit until the padding is freed.
+				// The receiver must be woken to free it, or a receiver that
+				// saw an empty ring and a sender waiting for room would both
+				// wait forever.
+				Notify(m_header->ReceiverWaiting, m_notEmpty);
+				position += claim;
+				continue;
+			}
+
+			if (message.empty() == false)
+				std::memcpy(record + 1, message.data(), message.size());
+			// Committing the header publishes the payload to the receiver.
+			std::atomic_ref<uint64_t>(*record).store(
+				CommittedFlag | message.size(),
+				std::memory_order_release
+			);
+			Notify(m_header->ReceiverWaiting, m_notEmpty);
+			return true;
+		}
+	}
+
+	bool SharedMemoryChannel::Send(std::span<const std::byte> message, const DWORD millis)
+	{
+		return BlockUntil(
+			[this, message] { return TrySend(message); },
+			m_header->SendersWaiting,
+			m_notFull,
+			millis
+		);
+	}
+
+	bool SharedMemoryChannel::TryReceive(std::vector<std::byte>& message)
+	{
+		return TryConsume(
+			[&message](std::span<const std::byte> received)
+			{
+				message.assign(received.begin(), received.end());
+			}
+		);
+	}
+
+	bool SharedMemoryChannel::Receive(std::vector<std::byte>& message, const DWORD millis)
+	{
+		return BlockUntil(
+			[this, &message] { return TryReceive(message); },
+			m_header->ReceiverWaiting,
+			m_notEmpty,
+			millis
+		);
+	}
+
+	size_t SharedMemoryChannel::GetUsedBytes() const noexcept
+	{
+		const uint64_t readPosition = m_header->ReadPosition.load(std::memory_order_acquire);
+		const uint64_t writePosition = m_header->WritePosition.load(std::memory_order_acquire);
+		return writePosition > readPosition
+			? static_cast<size_t>(writePosition - readPosition)
+			: 0;
+	}
+
+	size_t SharedMemoryChannel::GetCapacity() const noexcept
+	{
+		return static_cast<size_t>(m_mask + 1);
+	}
+
+	size_t SharedMemoryChannel::GetMaxMessageSize() const noexcept
+	{
+		return static_cast<size_t>(m_mask + 1 - RecordHeaderSize);
+	}
+
+	const std::wstring& SharedMemoryChannel::GetName() const noexcept
+	{
+		return m_name;
+	}
+
+	bool SharedMemoryChannel::Peek(std::span<const std::byte>& message, uint64_t& recordSize)
+	{
+		while (true)
+		{
+			const uint64_t position = m_header->ReadPosition.load(std::memory_order_relaxed);
+			uint64_t* record = GetRecord(position);
+			const uint64_t header = std::atomic_ref<uint64_t>(*record).load(std::memory_order_acquire);
+			// Either empty, or a sender has claimed the record but not yet
+			// committed it.
+			if ((header & CommittedFlag) == 0)
+				return false;
+
+			const uint64_t length = header & LengthMask;
+			recordSize = GetRecordSize(length);
+			if (header & PaddingFlag)
+			{
+				Free(recordSize);
+				continue;
+			}
+			message = { reinterpret_cast<const std::byte*>(record + 1), static_cast<size_t>(length) };
+			return true;
+		}
+	}
+
+	void SharedMemoryChannel::Free(const uint64_t recordSize)
+	{
+		const uint64_t position = m_header->ReadPosition.load(std::memory_order_relaxed);
+		// Any 8-byte word may be a record header on the next lap, so the
+		// record is zeroed to stop stale payload reading as committed.
+		std::memset(GetRecord(position), 0, static_cast<size_t>(recordSize));
+		m_header->ReadPosition.store(position + recordSize, std::memory_order_release);
+		Notify(m_header->SendersWaiting, m_notFull);
+	}
+
+	void SharedMemoryChannel::Notify(std::atomic<uint32_t>& waiters, Event& event)
+	{
+		// Pairs with the fence in BlockUntil(); the kernel is only entered
+		// when the other side has announced it is about to wait.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiters.load(std::memory_order_relaxed) > 0)
+			event.Signal();
+	}
+
+	uint64_t* SharedMemoryChannel::GetRecord(const uint64_t position) const noexcept
+	{
+		return reinterpret_cast<uint64_t*>(m_ring + (position & m_mask));
+	}
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "pch.hpp"
 #include <stdexcept>
+#include <intrin.h>
 #include "include/Async/SlimReadWriteLock.hpp"
+#include "include/Async/LockProfiler.hpp"
 
 namespace Boring32::Async
 {
@@ -8,14 +10,19 @@ namespace Boring32::Async
 	{ }
 
 	SlimReadWriteLock::SlimReadWriteLock()
-	:	m_threadOwningExclusiveLock(0)
+	:	m_threadOwningExclusiveLock(0),
+		m_exclusiveProfiledAt(0)
 	{
 		InitializeSRWLock(&m_srwLock);
 	}
 
 	bool SlimReadWriteLock::TryAcquireSharedLock()
 	{
-		return TryAcquireSRWLockShared(&m_srwLock);
+		if (TryAcquireSRWLockShared(&m_srwLock) == false)
+			return false;
+		if (LockProfiler::IsEnabled())
+			RecordAcquisition(LockProfiler::Now(), false, nullptr);
+		return true;
 	}
 
 	bool SlimReadWriteLock::TryAcquireExclusiveLock()
@@ -26,6 +33,11 @@ namespace Boring32::Async
 		if (TryAcquireSRWLockExclusive(&m_srwLock))
 		{
 			m_threadOwningExclusiveLock = currentThreadId;
+			if (LockProfiler::IsEnabled())
+			{
+				m_exclusiveProfiledAt = LockProfiler::Now();
+				RecordAcquisition(m_exclusiveProfiledAt, false, nullptr);
+			}
 			return true;
 		}
 		return false;
@@ -33,17 +45,38 @@ namespace Boring32::Async
 
 	void SlimReadWriteLock::AcquireSharedLock()
 	{
-		AcquireSRWLockShared(&m_srwLock);
+		if (LockProfiler::IsEnabled() == false)
+		{
+			AcquireSRWLockShared(&m_srwLock);
+			return;
+		}
+
+		const uint64_t start = LockProfiler::Now();
+		const bool isContended = TryAcquireSRWLockShared(&m_srwLock) == false;
+		if (isContended)
+			AcquireSRWLockShared(&m_srwLock);
+		RecordAcquisition(start, isContended, _ReturnAddress());
 	}
 
 	void SlimReadWriteLock::AcquireExclusiveLock()
 	{
 		DWORD currentThreadId = GetCurrentThreadId();
-		if (m_threadOwningExclusiveLock != currentThreadId)
+		if (m_threadOwningExclusiveLock == currentThreadId)
+			return;
+		if (LockProfiler::IsEnabled() == false)
 		{
 			AcquireSRWLockExclusive(&m_srwLock);
 			m_threadOwningExclusiveLock = currentThreadId;
+			return;
 		}
+
+		const uint64_t start = LockProfiler::Now();
+		const bool isContended = TryAcquireSRWLockExclusive(&m_srwLock) == false;
+		if (isContended)
+			AcquireSRWLockExclusive(&m_srwLock);
+		m_threadOwningExclusiveLock = currentThreadId;
+		m_exclusiveProfiledAt = LockProfiler::Now();
+		RecordAcquisition(start, isContended, _ReturnAddress());
 	}
 
 	void SlimReadWriteLock::ReleaseSharedLock()
@@ -56,8 +89,28 @@ namespace Boring32::Async
 		DWORD currentThreadId = GetCurrentThreadId();
 		if (m_threadOwningExclusiveLock == currentThreadId)
 		{
-			ReleaseSRWLockExclusive(&m_srwLock);
+			const uint64_t profiledAt = m_exclusiveProfiledAt;
+			m_exclusiveProfiledAt = 0;
+			const uint64_t releasedAt = profiledAt ? LockProfiler::Now() : 0;
 			m_threadOwningExclusiveLock = 0;
+			ReleaseSRWLockExclusive(&m_srwLock);
+			if (profiledAt)
+				LockProfiler::RecordRelease(this, releasedAt - profiledAt);
 		}
 	}
+
+	void SlimReadWriteLock::RecordAcquisition(
+		const uint64_t start,
+		const bool isContended,
+		const void* callSite
+	)
+	{
+		LockProfiler::RecordAcquisition(
+			this,
+			L"SlimReadWriteLock",
+			L"",
+			LockProfiler::Now() - start,
+			isContended ? callSite : nullptr
+		);
+	}
 }
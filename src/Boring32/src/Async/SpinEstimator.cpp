@@ -0,0 +1,47 @@
+#include "pch.hpp"
+#include "include/Async/SpinEstimator.hpp"
+
+namespace Boring32::Async
+{
+	SpinEstimator::~SpinEstimator() { }
+
+	SpinEstimator::SpinEstimator(const uint32_t maxSpins)
+	:	m_estimate(0),
+		m_maxSpins(maxSpins)
+	{ }
+
+	uint32_t SpinEstimator::GetLimit() const noexcept
+	{
+		const uint32_t limit = m_estimate.load(std::memory_order_relaxed) * 2 + MinSpins;
+		return limit < m_maxSpins ? limit : m_maxSpins;
+	}
+
+	void SpinEstimator::Succeeded(const uint32_t spins) noexcept
+	{
+		const uint32_t estimate = m_estimate.load(std::memory_order_relaxed);
+		// Moves the estimate an eighth of the way towards this sample.
+		m_estimate.store(
+			static_cast<uint32_t>(
+				static_cast<int32_t>(estimate)
+				+ (static_cast<int32_t>(spins) - static_cast<int32_t>(estimate)) / 8
+			),
+			std::memory_order_relaxed
+		);
+	}
+
+	void SpinEstimator::Failed() noexcept
+	{
+		const uint32_t estimate = m_estimate.load(std::memory_order_relaxed);
+		m_estimate.store(estimate - estimate / 8, std::memory_order_relaxed);
+	}
+
+	uint32_t SpinEstimator::GetEstimate() const noexcept
+	{
+		return m_estimate.load(std::memory_order_relaxed);
+	}
+
+	uint32_t SpinEstimator::GetMaxSpins() const noexcept
+	{
+		return m_maxSpins;
+	}
+}
\ No newline at end of file
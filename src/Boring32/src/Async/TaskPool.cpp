@@ -0,0 +1,201 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Async/AsyncFuncs.hpp"
+#include "include/Async/TaskPool.hpp"
+
+namespace Boring32::Async
+{
+	namespace
+	{
+		// Identifies the pool and deque owned by the current worker thread, so
+		// tasks posted from inside a task stay on the local deque.
+		thread_local const TaskPool* CurrentPool = nullptr;
+		thread_local size_t CurrentWorkerIndex = 0;
+	}
+
+	TaskPool::~TaskPool()
+	{
+		Close();
+	}
+
+	TaskPool::TaskPool(const DWORD threadCount)
+	:	m_workSignal(0),
+		m_sleepingWorkers(0),
+		m_pendingTasks(0),
+		m_nextQueue(0),
+		m_isClosing(false)
+	{
+		DWORD actualCount = threadCount;
+		if (actualCount == 0)
+			actualCount = std::thread::hardware_concurrency();
+		if (actualCount == 0)
+			actualCount = 1;
+
+		m_queues.reserve(actualCount);
+		for (DWORD i = 0; i < actualCount; i++)
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+
+		m_workers.reserve(actualCount);
+		try
+		{
+			for (DWORD i = 0; i < actualCount; i++)
+				m_workers.emplace_back([this, i] { Run(i); });
+		}
+		catch (...)
+		{
+			Close();
+			throw;
+		}
+	}
+
+	void TaskPool::Close()
+	{
+		if (m_isClosing.exchange(true))
+			return;
+		WakeWorkers(true);
+		for (std::thread& worker : m_workers)
+			if (worker.joinable())
+				worker.join();
+		m_workers.clear();
+	}
+
+	void TaskPool::Post(MoveOnlyTask task)
+	{
+		if (!task)
+			throw std::invalid_argument(__FUNCSIG__ ": task is empty");
+		if (m_isClosing.load(std::memory_order_relaxed))
+			throw std::runtime_error(__FUNCSIG__ ": pool is closed");
+
+		const size_t queueIndex = CurrentPool == this
+			? CurrentWorkerIndex
+			: m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+		WorkerQueue& queue = *m_queues[queueIndex];
+		// Count the task before it becomes visible so a worker can never
+		// decrement the counter below zero.
+		m_pendingTasks.fetch_add(1, std::memory_order_seq_cst);
+		AcquireSRWLockExclusive(&queue.Lock);
+		try
+		{
+			queue.Tasks.push_back(std::move(task));
+		}
+		catch (...)
+		{
+			ReleaseSRWLockExclusive(&queue.Lock);
+			m_pendingTasks.fetch_sub(1, std::memory_order_seq_cst);
+			throw;
+		}
+		ReleaseSRWLockExclusive(&queue.Lock);
+
+		// Only pay for a wake when a worker is actually parked.
+		if (m_sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+			WakeWorkers(false);
+	}
+
+	DWORD TaskPool::GetThreadCount() const noexcept
+	{
+		return static_cast<DWORD>(m_queues.size());
+	}
+
+	size_t TaskPool::GetPendingCount() const noexcept
+	{
+		return m_pendingTasks.load(std::memory_order_relaxed);
+	}
+
+	void TaskPool::Run(const size_t workerIndex)
+	{
+		CurrentPool = this;
+		CurrentWorkerIndex = workerIndex;
+
+		MoveOnlyTask task;
+		while (true)
+		{
+			if (TryPop(workerIndex, task) || TrySteal(workerIndex, task))
+			{
+				m_pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+				Execute(task);
+				task.Reset();
+				continue;
+			}
+
+			// Announce we're about to sleep, then recheck for work; this
+			// pairs with the increment-then-check in Post() so a task
+			// posted concurrently is never missed.
+			const uint32_t signal = m_workSignal.load(std::memory_order_seq_cst);
+			m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			if (m_pendingTasks.load(std::memory_order_seq_cst) > 0)
+			{
+				m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+				continue;
+			}
+			if (m_isClosing.load(std::memory_order_seq_cst))
+			{
+				m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+				break;
+			}
+			WaitOnValue(m_workSignal, signal, INFINITE);
+			m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+		}
+
+		CurrentPool = nullptr;
+	}
+
+	bool TaskPool::TryPop(const size_t workerIndex, MoveOnlyTask& task)
+	{
+		WorkerQueue& queue = *m_queues[workerIndex];
+		AcquireSRWLockExclusive(&queue.Lock);
+		const bool hasTask = queue.Tasks.empty() == false;
+		if (hasTask)
+		{
+			task = std::move(queue.Tasks.back());
+			queue.Tasks.pop_back();
+		}
+		ReleaseSRWLockExclusive(&queue.Lock);
+		return hasTask;
+	}
+
+	bool TaskPool::TrySteal(const size_t thiefIndex, MoveOnlyTask& task)
+	{
+		for (size_t i = 1; i < m_queues.size(); i++)
+		{
+			WorkerQueue& victim = *m_queues[(thiefIndex + i) % m_queues.size()];
+			// Don't queue up behind the owner or another thief.
+			if (TryAcquireSRWLockExclusive(&victim.Lock) == false)
+				continue;
+			const bool hasTask = victim.Tasks.empty() == false;
+			if (hasTask)
+			{
+				task = std::move(victim.Tasks.front());
+				victim.Tasks.pop_front();
+			}
+			ReleaseSRWLockExclusive(&victim.Lock);
+			if (hasTask)
+				return true;
+		}
+		return false;
+	}
+
+	void TaskPool::Execute(MoveOnlyTask& task) noexcept
+	{
+		try
+		{
+			task();
+		}
+		catch (const std::exception& ex)
+		{
+			std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+		}
+		catch (...)
+		{
+			std::wcerr << __FUNCSIG__ << L" unknown exception" << std::endl;
+		}
+	}
+
+	void TaskPool::WakeWorkers(const bool all) noexcept
+	{
+		m_workSignal.fetch_add(1, std::memory_order_seq_cst);
+		if (all)
+			WakeAllWaiters(m_workSignal);
+		else
+			WakeOneWaiter(m_workSignal);
+	}
+}
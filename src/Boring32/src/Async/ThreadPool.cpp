@@ -62,7 +62,8 @@ namespace Boring32::Async
 			&m_environ
 		);
 		if(item == nullptr)
-			throw Error::Win32Error("ThreadPool::ThreadPool(): CreateThreadPool() failed", GetLastError());
+			throw Error::Win32Error("ThreadPool::SubmitWork(): CreateThreadpoolWork() failed", GetLastError());
+		SubmitThreadpoolWork(item);
 		return item;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,400 @@
+#include "pch.hpp"
+#include <bit>
+#include <stdexcept>
+#include "include/Async/TimerWheel.hpp"
+
+namespace Boring32::Async
+{
+	TimerWheel::~TimerWheel()
+	{
+		Close();
+	}
+
+	TimerWheel::TimerWheel(TaskPool& pool, const DWORD resolutionMillis)
+	:	m_pool(pool),
+		m_resolution(resolutionMillis),
+		m_start(std::chrono::steady_clock::now()),
+		m_currentTick(0),
+		m_armedTick(NoDeadline),
+		m_count(0),
+		m_isClosing(false),
+		m_wake(false, false, false),
+		m_timer(L"", false, false)
+	{
+		if (resolutionMillis == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": resolutionMillis must be greater than 0");
+		InitializeSRWLock(&m_lock);
+		m_slots.fill(NoNode);
+		m_occupied.fill(0);
+		m_driver = std::thread([this] { Run(); });
+	}
+
+	void TimerWheel::Close()
+	{
+		AcquireSRWLockExclusive(&m_lock);
+		m_isClosing = true;
+		ReleaseSRWLockExclusive(&m_lock);
+		m_wake.Signal();
+		if (m_driver.joinable())
+			m_driver.join();
+
+		AcquireSRWLockExclusive(&m_lock);
+		std::vector<TimerNode> nodes = std::move(m_nodes);
+		m_nodes.clear();
+		m_freeNodes.clear();
+		m_slots.fill(NoNode);
+		m_occupied.fill(0);
+		m_count = 0;
+		ReleaseSRWLockExclusive(&m_lock);
+	}
+
+	TimerWheel::TimerId TimerWheel::Schedule(const DWORD delayMillis, MoveOnlyTask task)
+	{
+		if (!task)
+			throw std::invalid_argument(__FUNCSIG__ ": task is empty");
+
+		AcquireSRWLockExclusive(&m_lock);
+		uint32_t node = NoNode;
+		try
+		{
+			if (m_isClosing)
+				throw std::runtime_error(__FUNCSIG__ ": wheel is closed");
+			if (m_freeNodes.empty() == false)
+			{
+				node = m_freeNodes.back();
+				m_freeNodes.pop_back();
+			}
+			else
+			{
+				if (m_nodes.size() == NoNode)
+					throw std::runtime_error(__FUNCSIG__ ": too many timers");
+				m_nodes.emplace_back();
+				node = static_cast<uint32_t>(m_nodes.size() - 1);
+			}
+		}
+		catch (...)
+		{
+			ReleaseSRWLockExclusive(&m_lock);
+			throw;
+		}
+
+		TimerNode& timer = m_nodes[node];
+		timer.Task = std::move(task);
+		timer.Expiry = ToExpiry(delayMillis);
+		Link(node);
+		m_count++;
+		const TimerId id = (static_cast<TimerId>(timer.Generation) << 32) | node;
+		// Only wake the driver if this timer is due before the one it's
+		// waiting for, which is rare for long timeouts.
+		const bool wakeDriver = timer.Expiry < m_armedTick;
+		if (wakeDriver)
+			m_armedTick = timer.Expiry;
+		ReleaseSRWLockExclusive(&m_lock);
+
+		if (wakeDriver)
+			m_wake.Signal();
+		return id;
+	}
+
+	bool TimerWheel::Cancel(const TimerId id)
+	{
+		MoveOnlyTask discarded;
+		AcquireSRWLockExclusive(&m_lock);
+		TimerNode* timer = Find(id);
+		if (timer == nullptr)
+		{
+			ReleaseSRWLockExclusive(&m_lock);
+			return false;
+		}
+		const uint32_t node = static_cast<uint32_t>(id);
+		Unlink(node);
+		// Destroy the task outside the lock.
+		discarded = std::move(timer->Task);
+		Free(node);
+		m_count--;
+		ReleaseSRWLockExclusive(&m_lock);
+		return true;
+	}
+
+	bool TimerWheel::Reschedule(const TimerId id, const DWORD delayMillis)
+	{
+		AcquireSRWLockExclusive(&m_lock);
+		TimerNode* timer = Find(id);
+		if (timer == nullptr)
+		{
+			ReleaseSRWLockExclusive(&m_lock);
+			return false;
+		}
+		const uint32_t node = static_cast<uint32_t>(id);
+		Unlink(node);
+		timer->Expiry = ToExpiry(delayMillis);
+		Link(node);
+		const bool wakeDriver = timer->Expiry < m_armedTick;
+		if (wakeDriver)
+			m_armedTick = timer->Expiry;
+		ReleaseSRWLockExclusive(&m_lock);
+
+		if (wakeDriver)
+			m_wake.Signal();
+		return true;
+	}
+
+	size_t TimerWheel::Size() noexcept
+	{
+		AcquireSRWLockShared(&m_lock);
+		const size_t count = m_count;
+		ReleaseSRWLockShared(&m_lock);
+		return count;
+	}
+
+	DWORD TimerWheel::GetResolution() const noexcept
+	{
+		return m_resolution;
+	}
+
+	void TimerWheel::Run()
+	{
+		const HANDLE handles[] = { m_wake.GetHandle(), m_timer.GetHandle() };
+		std::vector<MoveOnlyTask> expired;
+		while (true)
+		{
+			const DWORD status = WaitForMultipleObjects(2, handles, false, INFINITE);
+			if (status == WAIT_FAILED)
+			{
+				std::wcerr
+					<< __FUNCSIG__
+					<< L": WaitForMultipleObjects() failed: "
+					<< GetLastError()
+					<< std::endl;
+				return;
+			}
+
+			AcquireSRWLockExclusive(&m_lock);
+			if (m_isClosing)
+			{
+				ReleaseSRWLockExclusive(&m_lock);
+				return;
+			}
+			Advance(GetCurrentTick(), expired);
+			const uint64_t dueTick = GetNextDueTick();
+			m_armedTick = dueTick;
+			ReleaseSRWLockExclusive(&m_lock);
+
+			// A timer scheduled earlier than dueTick after the lock is
+			// released also signals m_wake, so the wait below is re-armed.
+			ArmTimer(dueTick);
+			for (MoveOnlyTask& task : expired)
+			{
+				try
+				{
+					m_pool.Post(std::move(task));
+				}
+				catch (const std::exception& ex)
+				{
+					std::wcerr << __FUNCSIG__ << L" " << ex.what() << std::endl;
+				}
+			}
+			expired.clear();
+		}
+	}
+
+	uint64_t TimerWheel::GetCurrentTick() const noexcept
+	{
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - m_start
+		);
+		return static_cast<uint64_t>(elapsed.count()) / (m_resolution * 1000ull);
+	}
+
+	uint64_t TimerWheel::ToExpiry(const DWORD delayMillis) const noexcept
+	{
+		// Round the deadline up to a tick, so timers never fire early.
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - m_start
+		);
+		const uint64_t deadline = static_cast<uint64_t>(elapsed.count()) + delayMillis * 1000ull;
+		const uint64_t tickLength = m_resolution * 1000ull;
+		return (deadline + tickLength - 1) / tickLength;
+	}
+
+	TimerWheel::TimerNode* TimerWheel::Find(const TimerId id) noexcept
+	{
+		const uint32_t node = static_cast<uint32_t>(id);
+		if (node >= m_nodes.size())
+			return nullptr;
+		TimerNode& timer = m_nodes[node];
+		if (timer.Slot == NoNode || timer.Generation != static_cast<uint32_t>(id >> 32))
+			return nullptr;
+		return &timer;
+	}
+
+	void TimerWheel::Link(const uint32_t node)
+	{
+		TimerNode& timer = m_nodes[node];
+		constexpr uint64_t span = uint64_t(1) << (SlotBits * Levels);
+		uint64_t expiry = timer.Expiry < m_currentTick ? m_currentTick : timer.Expiry;
+		if (expiry - m_currentTick >= span)
+			expiry = m_currentTick + span - 1;
+
+		// Each level covers SlotBits more bits of the delta than the last.
+		const uint64_t delta = expiry - m_currentTick;
+		size_t level = 0;
+		while (level < Levels - 1 && delta >= (uint64_t(1) << (SlotBits * (level + 1))))
+			level++;
+		const size_t index = (expiry >> (SlotBits * level)) & (SlotsPerLevel - 1);
+		const uint32_t slot = static_cast<uint32_t>(level * SlotsPerLevel + index);
+
+		timer.Prev = NoNode;
+		timer.Next = m_slots[slot];
+		if (timer.Next != NoNode)
+			m_nodes[timer.Next].Prev = node;
+		m_slots[slot] = node;
+		timer.Slot = slot;
+		if (level == 0)
+			m_occupied[index / 64] |= uint64_t(1) << (index % 64);
+	}
+
+	void TimerWheel::Unlink(const uint32_t node) noexcept
+	{
+		TimerNode& timer = m_nodes[node];
+		if (timer.Prev != NoNode)
+			m_nodes[timer.Prev].Next = timer.Next;
+		else
+			m_slots[timer.Slot] = timer.Next;
+		if (timer.Next != NoNode)
+			m_nodes[timer.Next].Prev = timer.Prev;
+
+		if (timer.Slot < SlotsPerLevel && m_slots[timer.Slot] == NoNode)
+			m_occupied[timer.Slot / 64] &= ~(uint64_t(1) << (timer.Slot % 64));
+		timer.Prev = NoNode;
+		timer.Next = NoNode;
+		timer.Slot = NoNode;
+	}
+
+	void TimerWheel::Free(const uint32_t node) noexcept
+	{
+		TimerNode& timer = m_nodes[node];
+		timer.Task.Reset();
+		timer.Generation++;
+		if (timer.Generation == 0)
+			timer.Generation = 1;
+		m_freeNodes.push_back(node);
+	}
+
+	void TimerWheel::Advance(const uint64_t targetTick, std::vector<MoveOnlyTask>& expired)
+	{
+		if (m_count == 0)
+		{
+			// Nothing to fire or cascade, so just catch up.
+			if (targetTick >= m_currentTick)
+				m_currentTick = targetTick + 1;
+			return;
+		}
+
+		while (m_currentTick <= targetTick)
+		{
+			const size_t index = m_currentTick & (SlotsPerLevel - 1);
+			if (index == 0)
+			{
+				for (size_t level = 1; level < Levels; level++)
+					if (Cascade(level) != 0)
+						break;
+			}
+
+			// Jump straight to the next occupied slot in this rotation.
+			const size_t occupied = FindOccupiedSlot(index);
+			if (occupied == SlotsPerLevel)
+			{
+				const uint64_t rotationEnd = m_currentTick + (SlotsPerLevel - index);
+				m_currentTick = rotationEnd <= targetTick ? rotationEnd : targetTick + 1;
+				continue;
+			}
+			const uint64_t slotTick = m_currentTick + (occupied - index);
+			if (slotTick > targetTick)
+			{
+				m_currentTick = targetTick + 1;
+				break;
+			}
+
+			uint32_t node = m_slots[occupied];
+			m_slots[occupied] = NoNode;
+			m_occupied[occupied / 64] &= ~(uint64_t(1) << (occupied % 64));
+			while (node != NoNode)
+			{
+				TimerNode& timer = m_nodes[node];
+				const uint32_t next = timer.Next;
+				expired.push_back(std::move(timer.Task));
+				timer.Prev = NoNode;
+				timer.Next = NoNode;
+				timer.Slot = NoNode;
+				Free(node);
+				m_count--;
+				node = next;
+			}
+			m_currentTick = slotTick + 1;
+		}
+	}
+
+	size_t TimerWheel::Cascade(const size_t level)
+	{
+		// Timers in this slot are now due within the span of the level
+		// below, so relink them to spread them out across it.
+		const size_t index = (m_currentTick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+		const size_t slot = level * SlotsPerLevel + index;
+		uint32_t node = m_slots[slot];
+		m_slots[slot] = NoNode;
+		while (node != NoNode)
+		{
+			const uint32_t next = m_nodes[node].Next;
+			Link(node);
+			node = next;
+		}
+		return index;
+	}
+
+	size_t TimerWheel::FindOccupiedSlot(const size_t from) const noexcept
+	{
+		for (size_t word = from / 64; word < m_occupied.size(); word++)
+		{
+			uint64_t bits = m_occupied[word];
+			if (word == from / 64)
+				bits &= ~uint64_t(0) << (from % 64);
+			if (bits != 0)
+				return word * 64 + std::countr_zero(bits);
+		}
+		return SlotsPerLevel;
+	}
+
+	uint64_t TimerWheel::GetNextDueTick() const noexcept
+	{
+		if (m_count == 0)
+			return NoDeadline;
+		const size_t index = m_currentTick & (SlotsPerLevel - 1);
+		// The next tick cascades the upper levels, which may bring timers due.
+		if (index == 0)
+			return m_currentTick;
+		const size_t occupied = FindOccupiedSlot(index);
+		if (occupied < SlotsPerLevel)
+			return m_currentTick + (occupied - index);
+		return m_currentTick + (SlotsPerLevel - index);
+	}
+
+	void TimerWheel::ArmTimer(const uint64_t dueTick)
+	{
+		if (dueTick == NoDeadline)
+		{
+			m_timer.CancelTimer(std::nothrow);
+			return;
+		}
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - m_start
+		);
+		const int64_t dueMicros = static_cast<int64_t>(dueTick * m_resolution * 1000ull);
+		int64_t delayMicros = dueMicros - static_cast<int64_t>(elapsed.count());
+		if (delayMicros < 0)
+			delayMicros = 0;
+		// Negative values are relative, in 100-nanosecond intervals.
+		m_timer.SetTimerInNanos(-delayMicros * 10, 0, nullptr, nullptr, std::nothrow);
+	}
+}
\ No newline at end of file
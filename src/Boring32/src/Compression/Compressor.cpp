@@ -1,10 +1,19 @@
 #include "pch.hpp"
+#include <cstring>
+#include <optional>
 #include "include/Error/Win32Error.hpp"
 #include "include/Compression/Compressor.hpp"
+#include "include/Compression/LzCodec.hpp"
 
 // For reference see: https://docs.microsoft.com/en-us/windows/win32/cmpapi/using-the-compression-api-in-block-mode
 namespace Boring32::Compression
 {
+	// CompressionType is portable, so it can't use these directly.
+	static_assert(static_cast<DWORD>(CompressionType::MSZIP) == COMPRESS_ALGORITHM_MSZIP);
+	static_assert(static_cast<DWORD>(CompressionType::XPRESS) == COMPRESS_ALGORITHM_XPRESS);
+	static_assert(static_cast<DWORD>(CompressionType::XPRESSHuffman) == COMPRESS_ALGORITHM_XPRESS_HUFF);
+	static_assert(static_cast<DWORD>(CompressionType::LZMS) == COMPRESS_ALGORITHM_LZMS);
+
 	void Compressor::Close()
 	{
 		if (m_compressor != nullptr)
@@ -13,6 +22,11 @@ namespace Boring32::Compression
 			m_type = CompressionType::NotSet;
 			m_compressor = nullptr;
 		}
+		if (m_codec != nullptr)
+		{
+			m_type = CompressionType::NotSet;
+			m_codec = nullptr;
+		}
 	}
 
 	Compressor::Compressor()
@@ -32,6 +46,16 @@ namespace Boring32::Compression
 		Create();
 	}
 
+	Compressor::Compressor(std::unique_ptr<ICodec> codec)
+	:	m_type(CompressionType::NotSet),
+		m_compressor(nullptr)
+	{
+		if (codec == nullptr)
+			throw std::invalid_argument(__FUNCSIG__ ": codec is null");
+		m_type = codec->GetType();
+		m_codec = std::move(codec);
+	}
+
 	Compressor::Compressor(const Compressor& other)
 	:	m_type(CompressionType::NotSet),
 		m_compressor(nullptr)
@@ -49,7 +73,10 @@ namespace Boring32::Compression
 	{
 		Close();
 		m_type = other.m_type;
-		Create();
+		if (other.m_codec != nullptr)
+			m_codec = other.m_codec->Clone();
+		else
+			Create();
 	}
 
 	Compressor::Compressor(Compressor&& other) noexcept
@@ -73,6 +100,7 @@ namespace Boring32::Compression
 			m_type = other.m_type;
 			m_compressor = other.m_compressor;
 			other.m_compressor = nullptr;
+			m_codec = std::move(other.m_codec);
 		}
 		catch (const std::exception& ex)
 		{
@@ -82,12 +110,25 @@ namespace Boring32::Compression
 
 	size_t Compressor::GetCompressedSize(const std::vector<std::byte>& buffer) const
 	{
-		if (m_compressor == nullptr)
+		if (m_compressor == nullptr && m_codec == nullptr)
 			throw std::runtime_error(__FUNCSIG__ ": compressor handle is null");
 		if (buffer.size() == 0)
 			throw std::runtime_error(__FUNCSIG__  ": buffer is empty");
-
 		size_t compressedBufferSize = 0;
+		if (m_codec != nullptr)
+		{
+			// Codecs can't report the size without compressing, so this
+			// compresses into a scratch buffer and keeps only the size.
+			std::vector<std::byte> scratch(GetCompressedBound(buffer.size()));
+			if (TryCompress(buffer, scratch, compressedBufferSize) == false)
+			{
+				scratch.resize(compressedBufferSize);
+				if (TryCompress(buffer, scratch, compressedBufferSize) == false)
+					throw Error::Win32Error(__FUNCSIG__ ": TryCompress() failed", ERROR_INSUFFICIENT_BUFFER);
+			}
+			return compressedBufferSize;
+		}
+
 		// https://docs.microsoft.com/en-us/windows/win32/api/compressapi/nf-compressapi-compress
 		const bool succeeded = Compress(
 			m_compressor,           //  Compressor Handle
@@ -109,31 +150,155 @@ namespace Boring32::Compression
 		return m_type;
 	}
 
+	size_t Compressor::GetCompressedBound(const size_t uncompressedSize) const noexcept
+	{
+		if (m_codec != nullptr)
+			return m_codec->GetCompressedBound(uncompressedSize);
+		// Incompressible input is stored with modest per-block overhead by 
+		// all of the algorithms; the constant covers the buffer mode header
+		// and small inputs.
+		return uncompressedSize + uncompressedSize / 8 + 4096;
+	}
+
 	std::vector<std::byte> Compressor::CompressBuffer(const std::vector<std::byte>& buffer)
 	{
-		if (m_compressor == nullptr)
+		if (m_compressor == nullptr && m_codec == nullptr)
 			throw std::runtime_error("Compressor::CompressBuffer(): compressor handle is null");
 		if (buffer.size() == 0)
 			throw std::runtime_error("Compressor::CompressBuffer(): buffer is empty");
 
-		std::vector<std::byte> returnVal(GetCompressedSize(buffer), (std::byte)0);
+		std::vector<std::byte> returnVal(GetCompressedBound(buffer.size()));
+		size_t compressedBufferSize = 0;
+		if (TryCompress(buffer, returnVal, compressedBufferSize) == false)
+		{
+			// The bound was exceeded; compressedBufferSize is now exact.
+			returnVal.resize(compressedBufferSize);
+			if (TryCompress(buffer, returnVal, compressedBufferSize) == false)
+				throw Error::Win32Error("Compressor::CompressBuffer(): Compress() failed", ERROR_INSUFFICIENT_BUFFER);
+		}
+		returnVal.resize(compressedBufferSize);
+		returnVal.shrink_to_fit();
+
+		return returnVal;
+	}
+
+	size_t Compressor::CompressBuffer(std::span<const std::byte> buffer, std::span<std::byte> out)
+	{
+		if (m_compressor == nullptr && m_codec == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": compressor handle is null");
+		if (buffer.size() == 0)
+			throw std::runtime_error(__FUNCSIG__ ": buffer is empty");
+
+		size_t compressedBufferSize = 0;
+		if (TryCompress(buffer, out, compressedBufferSize) == false)
+			throw Error::Win32Error(__FUNCSIG__ ": output buffer is too small", ERROR_INSUFFICIENT_BUFFER);
+		return compressedBufferSize;
+	}
+
+	std::vector<std::byte> Compressor::CompressBufferWithHeader(std::span<const std::byte> buffer)
+	{
+		if (m_compressor == nullptr && m_codec == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": compressor handle is null");
+		if (buffer.size() == 0)
+			throw std::runtime_error(__FUNCSIG__ ": buffer is empty");
+
+		constexpr size_t headerSize = sizeof(CompressedHeader);
+		std::vector<std::byte> returnVal(headerSize + GetCompressedBound(buffer.size()));
 		size_t compressedBufferSize = 0;
+		if (TryCompress(buffer, std::span(returnVal).subspan(headerSize), compressedBufferSize) == false)
+		{
+			returnVal.resize(headerSize + compressedBufferSize);
+			if (TryCompress(buffer, std::span(returnVal).subspan(headerSize), compressedBufferSize) == false)
+				throw Error::Win32Error(__FUNCSIG__ ": Compress() failed", ERROR_INSUFFICIENT_BUFFER);
+		}
+		returnVal.resize(headerSize + compressedBufferSize);
+		returnVal.shrink_to_fit();
+
+		const CompressedHeader header{
+			.Type = m_type,
+			.OriginalSize = buffer.size(),
+			.CompressedSize = compressedBufferSize
+		};
+		std::memcpy(returnVal.data(), &header, headerSize);
+		return returnVal;
+	}
+
+	std::vector<std::byte> Compressor::CompressBufferParallel(
+		std::span<const std::byte> buffer,
+		const size_t blockSize,
+		Async::TaskPool& pool
+	)
+	{
+		if (m_compressor == nullptr && m_codec == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": compressor handle is null");
+		if (buffer.size() == 0)
+			throw std::runtime_error(__FUNCSIG__ ": buffer is empty");
+		if (blockSize == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": blockSize must be greater than 0");
+
+		const size_t blockCount = (buffer.size() + blockSize - 1) / blockSize;
+		std::vector<std::vector<std::byte>> frames(blockCount);
+		// Compressors can't be used concurrently, so each runner copies 
+		// this one on first use.
+		std::vector<std::optional<Compressor>> compressors(pool.GetThreadCount() + 1);
+		pool.ParallelFor(
+			blockCount,
+			[this, buffer, blockSize, &frames, &compressors](const size_t slot, const size_t index)
+			{
+				std::optional<Compressor>& compressor = compressors[slot];
+				if (compressor.has_value() == false)
+					compressor.emplace(*this);
+				const size_t offset = index * blockSize;
+				const size_t size = buffer.size() - offset < blockSize ? buffer.size() - offset : blockSize;
+				frames[index] = compressor->CompressBufferWithHeader(buffer.subspan(offset, size));
+			}
+		);
+
+		size_t totalSize = 0;
+		for (const std::vector<std::byte>& frame : frames)
+			totalSize += frame.size();
+		std::vector<std::byte> returnVal;
+		returnVal.reserve(totalSize);
+		for (const std::vector<std::byte>& frame : frames)
+			returnVal.insert(returnVal.end(), frame.begin(), frame.end());
+
+		return returnVal;
+	}
+
+	bool Compressor::TryCompress(
+		std::span<const std::byte> buffer,
+		std::span<std::byte> out,
+		size_t& written
+	) const
+	{
+		if (m_codec != nullptr)
+			return m_codec->TryCompress(buffer, out, written);
+
+		written = 0;
 		// https://docs.microsoft.com/en-us/windows/win32/api/compressapi/nf-compressapi-compress
-		bool succeeded = Compress(
+		const bool succeeded = Compress(
 			m_compressor,           //  Compressor Handle
-			&buffer[0],             //  Input buffer, Uncompressed data
+			buffer.data(),          //  Input buffer, Uncompressed data
 			buffer.size(),          //  Uncompressed data size
-			&returnVal[0],          //  Compressed Buffer
-			returnVal.size(),       //  Compressed Buffer size
-			&compressedBufferSize);	//  Compressed Data size
-		if (succeeded == false)
-			throw Error::Win32Error("Compressor::CompressBuffer(): Compress() failed", GetLastError());
-
-		return returnVal;
+			out.data(),             //  Compressed Buffer
+			out.size(),             //  Compressed Buffer size
+			&written                //  Compressed Data size
+		);
+		if (succeeded)
+			return true;
+		const DWORD lastError = GetLastError();
+		if (lastError == ERROR_INSUFFICIENT_BUFFER)
+			return false;
+		throw Error::Win32Error(__FUNCSIG__ ": Compress() failed", lastError);
 	}
 
 	void Compressor::Create()
 	{
+		if (m_type == CompressionType::PortableLZ)
+		{
+			m_codec = std::make_unique<LzCodec>();
+			return;
+		}
 		if (m_type != CompressionType::NotSet)
 		{
 			// https://docs.microsoft.com/en-us/windows/win32/api/compressapi/nf-compressapi-createcompressor
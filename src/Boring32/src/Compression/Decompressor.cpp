@@ -1,6 +1,9 @@
 #include "pch.hpp"
+#include <cstring>
+#include <optional>
 #include "include/Error/Win32Error.hpp"
 #include "include/Compression/Decompressor.hpp"
+#include "include/Compression/LzCodec.hpp"
 
 namespace Boring32::Compression
 {
@@ -11,6 +14,8 @@ namespace Boring32::Compression
 			CloseDecompressor(m_decompressor);
 			m_decompressor = nullptr;
 		}
+		m_codec = nullptr;
+		m_type = CompressionType::NotSet;
 	}
 
 	Decompressor::~Decompressor()
@@ -26,7 +31,9 @@ namespace Boring32::Compression
 	Decompressor::Decompressor(const Decompressor& other)
 	:	m_type(CompressionType::NotSet),
 		m_decompressor(nullptr)
-	{ }
+	{
+		Copy(other);
+	}
 
 	Decompressor& Decompressor::operator=(const Decompressor& other)
 	{
@@ -38,13 +45,18 @@ namespace Boring32::Compression
 	{
 		Close();
 		m_type = other.m_type;
-		Create();
+		if (other.m_codec != nullptr)
+			m_codec = other.m_codec->Clone();
+		else
+			Create();
 	}
 
 	Decompressor::Decompressor(Decompressor&& other) noexcept
 	:	m_type(CompressionType::NotSet),
 		m_decompressor(nullptr)
-	{ }
+	{
+		Move(other);
+	}
 
 	Decompressor& Decompressor::operator=(Decompressor&& other) noexcept
 	{
@@ -58,6 +70,7 @@ namespace Boring32::Compression
 		m_type = other.m_type;
 		m_decompressor = other.m_decompressor;
 		other.m_decompressor = nullptr;
+		m_codec = std::move(other.m_codec);
 	}
 
 	Decompressor::Decompressor(const CompressionType type)
@@ -67,8 +80,23 @@ namespace Boring32::Compression
 		Create();
 	}
 
+	Decompressor::Decompressor(std::unique_ptr<ICodec> codec)
+	:	m_type(CompressionType::NotSet),
+		m_decompressor(nullptr)
+	{
+		if (codec == nullptr)
+			throw std::invalid_argument(__FUNCSIG__ ": codec is null");
+		m_type = codec->GetType();
+		m_codec = std::move(codec);
+	}
+
 	void Decompressor::Create()
 	{
+		if (m_type == CompressionType::PortableLZ)
+		{
+			m_codec = std::make_unique<LzCodec>();
+			return;
+		}
 		if (m_type != CompressionType::NotSet)
 		{
 			bool succeeded = CreateDecompressor(
@@ -88,10 +116,12 @@ namespace Boring32::Compression
 
 	size_t Decompressor::GetDecompressedSize(const std::vector<std::byte>& compressedBuffer) const
 	{
-		if (m_decompressor == nullptr)
+		if (m_decompressor == nullptr && m_codec == nullptr)
 			throw std::runtime_error("Decompressor::DecompressBuffer(): decompressor handle is null");
 		if (compressedBuffer.size() == 0)
 			throw std::runtime_error("Decompressor::DecompressBuffer(): buffer is empty");
+		if (m_codec != nullptr)
+			return m_codec->GetDecompressedSize(compressedBuffer);
 
 		size_t decompressedBufferSize = 0;
 		//https://docs.microsoft.com/en-us/windows/win32/api/compressapi/nf-compressapi-decompress
@@ -102,19 +132,26 @@ namespace Boring32::Compression
 			nullptr,                    // Buffer set to NULL
 			0,                          // Buffer size set to 0
 			&decompressedBufferSize);	// Decompressed data size
-		if (success == false)
-			throw Error::Win32Error("Decompressor::GetDecompressedSize(): Decompress() failed", GetLastError());
+		// Probing with a null buffer reports the size via ERROR_INSUFFICIENT_BUFFER.
+		const DWORD lastError = GetLastError();
+		if (success == false && lastError != ERROR_INSUFFICIENT_BUFFER)
+			throw Error::Win32Error("Decompressor::GetDecompressedSize(): Decompress() failed", lastError);
 		return decompressedBufferSize;
 	}
 
 	std::vector<std::byte> Decompressor::DecompressBuffer(const std::vector<std::byte>& compressedBuffer)
 	{
-		if (m_decompressor == nullptr)
+		if (m_decompressor == nullptr && m_codec == nullptr)
 			throw std::runtime_error("Decompressor::DecompressBuffer(): decompressor handle is null");
 		if (compressedBuffer.size() == 0)
 			throw std::runtime_error("Decompressor::DecompressBuffer(): buffer is empty");
 
 		std::vector<std::byte> returnVal(GetDecompressedSize(compressedBuffer), (std::byte)0);
+		if (m_codec != nullptr)
+		{
+			DecompressBuffer(compressedBuffer, returnVal);
+			return returnVal;
+		}
 		size_t decompressedBufferSize = 0;
 		// https://docs.microsoft.com/en-us/windows/win32/api/compressapi/nf-compressapi-compress
 		bool succeeded = Decompress(
@@ -129,4 +166,120 @@ namespace Boring32::Compression
 
 		return returnVal;
 	}
+	size_t Decompressor::DecompressBuffer(std::span<const std::byte> compressedBuffer, std::span<std::byte> out)
+	{
+		if (m_decompressor == nullptr && m_codec == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": decompressor handle is null");
+		if (compressedBuffer.size() == 0)
+			throw std::runtime_error(__FUNCSIG__ ": buffer is empty");
+
+		size_t decompressedBufferSize = 0;
+		if (m_codec != nullptr)
+		{
+			if (m_codec->TryDecompress(compressedBuffer, out, decompressedBufferSize) == false)
+				throw Error::Win32Error(__FUNCSIG__ ": output buffer is too small", ERROR_INSUFFICIENT_BUFFER);
+			return decompressedBufferSize;
+		}
+		// https://docs.microsoft.com/en-us/windows/win32/api/compressapi/nf-compressapi-decompress
+		const bool succeeded = Decompress(
+			m_decompressor,				//  Decompressor handle
+			compressedBuffer.data(),	//  Input buffer, compressed data
+			compressedBuffer.size(),	//  Compressed data size
+			out.data(),					//  Uncompressed buffer
+			out.size(),					//  Uncompressed buffer size
+			&decompressedBufferSize);	//  Decompressed data size
+		if (succeeded == false)
+			throw Error::Win32Error(__FUNCSIG__ ": Decompress() failed", GetLastError());
+
+		return decompressedBufferSize;
+	}
+
+	std::vector<std::byte> Decompressor::DecompressBufferWithHeader(std::span<const std::byte> compressedBuffer)
+	{
+		const CompressedHeader header = ReadHeader(compressedBuffer);
+		if (header.CompressedSize != compressedBuffer.size() - sizeof(header))
+			throw std::invalid_argument(__FUNCSIG__ ": buffer size does not match its header");
+
+		std::vector<std::byte> returnVal(header.OriginalSize);
+		const size_t decompressedBufferSize = DecompressBuffer(
+			compressedBuffer.subspan(sizeof(header)),
+			returnVal
+		);
+		if (decompressedBufferSize != header.OriginalSize)
+			throw std::runtime_error(__FUNCSIG__ ": decompressed size does not match the header");
+
+		return returnVal;
+	}
+	std::vector<std::byte> Decompressor::DecompressBufferParallel(
+		std::span<const std::byte> frames,
+		Async::TaskPool& pool
+	)
+	{
+		if (m_decompressor == nullptr && m_codec == nullptr)
+			throw std::runtime_error(__FUNCSIG__ ": decompressor handle is null");
+		if (frames.size() == 0)
+			throw std::runtime_error(__FUNCSIG__ ": buffer is empty");
+
+		struct FrameLocation
+		{
+			size_t CompressedOffset = 0;
+			size_t CompressedSize = 0;
+			size_t OriginalOffset = 0;
+			size_t OriginalSize = 0;
+		};
+		std::vector<FrameLocation> locations;
+		size_t offset = 0;
+		size_t totalSize = 0;
+		while (offset < frames.size())
+		{
+			const CompressedHeader header = ReadHeader(frames.subspan(offset));
+			if (header.CompressedSize > frames.size() - offset - sizeof(header))
+				throw std::invalid_argument(__FUNCSIG__ ": frame is truncated");
+			locations.push_back({
+				.CompressedOffset = offset + sizeof(header),
+				.CompressedSize = static_cast<size_t>(header.CompressedSize),
+				.OriginalOffset = totalSize,
+				.OriginalSize = static_cast<size_t>(header.OriginalSize)
+			});
+			offset += sizeof(header) + static_cast<size_t>(header.CompressedSize);
+			totalSize += static_cast<size_t>(header.OriginalSize);
+		}
+
+		std::vector<std::byte> returnVal(totalSize);
+		// Decompressors can't be used concurrently, so each runner copies 
+		// this one on first use.
+		std::vector<std::optional<Decompressor>> decompressors(pool.GetThreadCount() + 1);
+		pool.ParallelFor(
+			locations.size(),
+			[this, frames, &locations, &returnVal, &decompressors](const size_t slot, const size_t index)
+			{
+				std::optional<Decompressor>& decompressor = decompressors[slot];
+				if (decompressor.has_value() == false)
+					decompressor.emplace(*this);
+				const FrameLocation& location = locations[index];
+				const size_t decompressedSize = decompressor->DecompressBuffer(
+					frames.subspan(location.CompressedOffset, location.CompressedSize),
+					std::span(returnVal).subspan(location.OriginalOffset, location.OriginalSize)
+				);
+				if (decompressedSize != location.OriginalSize)
+					throw std::invalid_argument("Decompressor::DecompressBufferParallel(): decompressed size does not match the frame header");
+			}
+		);
+
+		return returnVal;
+	}
+
+	CompressedHeader Decompressor::ReadHeader(std::span<const std::byte> compressedBuffer) const
+	{
+		if (compressedBuffer.size() < sizeof(CompressedHeader))
+			throw std::invalid_argument(__FUNCSIG__ ": buffer is too small to contain a header");
+
+		CompressedHeader header;
+		std::memcpy(&header, compressedBuffer.data(), sizeof(header));
+		if (header.Magic != CompressedHeader::Signature)
+			throw std::invalid_argument(__FUNCSIG__ ": buffer does not start with a header");
+		if (header.Type != m_type)
+			throw std::invalid_argument(__FUNCSIG__ ": buffer was compressed with a different algorithm");
+		return header;
+	}
 }
\ No newline at end of file
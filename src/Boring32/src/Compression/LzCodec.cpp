@@ -0,0 +1,280 @@
+#include "pch.hpp"
+#include <cstring>
+#include <stdexcept>
+#include "include/Compression/LzCodec.hpp"
+
+namespace Boring32::Compression
+{
+	namespace
+	{
+		constexpr size_t MinMatch = 4;
+		constexpr size_t MaxOffset = 65535;
+		// The tail of the input is always emitted as literals, which keeps
+		// match searches from reading past the end.
+		constexpr size_t LastLiterals = 5;
+		constexpr size_t MatchSearchLimit = 12;
+
+		uint32_t Read32(const std::byte* p) noexcept
+		{
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		uint32_t Hash(const uint32_t sequence, const size_t bits) noexcept
+		{
+			return (sequence * 2654435761u) >> (32 - bits);
+		}
+
+		// Writes into a fixed buffer, tracking whether it ran out of space.
+		struct Writer
+		{
+			std::byte* Begin;
+			std::byte* Position;
+			std::byte* End;
+
+			bool Put(const std::byte value) noexcept
+			{
+				if (Position == End)
+					return false;
+				*Position++ = value;
+				return true;
+			}
+
+			bool Put(const std::byte* source, const size_t count) noexcept
+			{
+				if (static_cast<size_t>(End - Position) < count)
+					return false;
+				if (count > 0)
+					std::memcpy(Position, source, count);
+				Position += count;
+				return true;
+			}
+
+			bool PutLength(size_t length) noexcept
+			{
+				while (length >= 255)
+				{
+					if (Put(std::byte{ 255 }) == false)
+						return false;
+					length -= 255;
+				}
+				return Put(static_cast<std::byte>(length));
+			}
+		};
+
+		bool EmitSequence(
+			Writer& writer,
+			const std::byte* literals,
+			const size_t literalLength,
+			const size_t offset,
+			const size_t matchLength
+		) noexcept
+		{
+			const size_t matchCode = matchLength - MinMatch;
+			const uint8_t token = static_cast<uint8_t>(
+				((literalLength < 15 ? literalLength : 15) << 4)
+				| (matchCode < 15 ? matchCode : 15)
+			);
+			if (writer.Put(static_cast<std::byte>(token)) == false)
+				return false;
+			if (literalLength >= 15 && writer.PutLength(literalLength - 15) == false)
+				return false;
+			if (writer.Put(literals, literalLength) == false)
+				return false;
+			if (matchLength == 0)
+				return true;
+			if (writer.Put(static_cast<std::byte>(offset & 0xFF)) == false)
+				return false;
+			if (writer.Put(static_cast<std::byte>(offset >> 8)) == false)
+				return false;
+			if (matchCode >= 15 && writer.PutLength(matchCode - 15) == false)
+				return false;
+			return true;
+		}
+
+		size_t ReadLength(std::span<const std::byte> buffer, size_t& position)
+		{
+			size_t length = 0;
+			while (true)
+			{
+				if (position == buffer.size())
+					throw std::invalid_argument("LzCodec: length is truncated");
+				const uint8_t value = static_cast<uint8_t>(buffer[position++]);
+				length += value;
+				if (value != 255)
+					return length;
+			}
+		}
+	}
+
+	LzCodec::~LzCodec() { }
+
+	LzCodec::LzCodec()
+	{
+		m_table.fill(0);
+	}
+
+	CompressionType LzCodec::GetType() const noexcept
+	{
+		return CompressionType::PortableLZ;
+	}
+
+	std::unique_ptr<ICodec> LzCodec::Clone() const
+	{
+		return std::make_unique<LzCodec>();
+	}
+
+	size_t LzCodec::GetCompressedBound(const size_t uncompressedSize) const noexcept
+	{
+		// Incompressible input costs a token plus one length byte per 255
+		// literals.
+		return SizeHeaderLength + uncompressedSize + uncompressedSize / 255 + 16;
+	}
+
+	bool LzCodec::TryCompress(
+		std::span<const std::byte> buffer,
+		std::span<std::byte> out,
+		size_t& written
+	)
+	{
+		if (buffer.size() > UINT32_MAX)
+			throw std::invalid_argument("LzCodec::TryCompress(): buffer is too large");
+
+		written = 0;
+		Writer writer{ out.data(), out.data(), out.data() + out.size() };
+		const uint64_t originalSize = buffer.size();
+		std::byte sizeHeader[SizeHeaderLength];
+		for (size_t i = 0; i < SizeHeaderLength; i++)
+			sizeHeader[i] = static_cast<std::byte>(originalSize >> (8 * i));
+		if (writer.Put(sizeHeader, SizeHeaderLength) == false)
+		{
+			written = GetCompressedBound(buffer.size());
+			return false;
+		}
+
+		const std::byte* const base = buffer.data();
+		const size_t size = buffer.size();
+		size_t anchor = 0;
+		if (size > MatchSearchLimit)
+		{
+			m_table.fill(0);
+			const size_t searchEnd = size - MatchSearchLimit;
+			const size_t matchEnd = size - LastLiterals;
+			size_t position = 0;
+			while (position < searchEnd)
+			{
+				const uint32_t sequence = Read32(base + position);
+				uint32_t& slot = m_table[Hash(sequence, HashBits)];
+				const size_t candidate = slot;
+				slot = static_cast<uint32_t>(position);
+				const size_t distance = position - candidate;
+				if (distance == 0 || distance > MaxOffset || Read32(base + candidate) != sequence)
+				{
+					// Step faster through data that isn't matching.
+					position += 1 + ((position - anchor) >> 6);
+					continue;
+				}
+
+				size_t matchLength = MinMatch;
+				while (position + matchLength < matchEnd
+					&& base[candidate + matchLength] == base[position + matchLength])
+				{
+					matchLength++;
+				}
+				if (EmitSequence(writer, base + anchor, position - anchor, distance, matchLength) == false)
+				{
+					written = GetCompressedBound(buffer.size());
+					return false;
+				}
+				position += matchLength;
+				anchor = position;
+				if (position - 2 < searchEnd)
+					m_table[Hash(Read32(base + position - 2), HashBits)] = static_cast<uint32_t>(position - 2);
+			}
+		}
+
+		if (EmitSequence(writer, base + anchor, size - anchor, 0, 0) == false)
+		{
+			written = GetCompressedBound(buffer.size());
+			return false;
+		}
+		written = writer.Position - writer.Begin;
+		return true;
+	}
+
+	size_t LzCodec::GetDecompressedSize(std::span<const std::byte> compressedBuffer) const
+	{
+		if (compressedBuffer.size() < SizeHeaderLength)
+			throw std::invalid_argument("LzCodec::GetDecompressedSize(): buffer is too small");
+		uint64_t originalSize = 0;
+		for (size_t i = 0; i < SizeHeaderLength; i++)
+			originalSize |= static_cast<uint64_t>(compressedBuffer[i]) << (8 * i);
+		if (originalSize > SIZE_MAX)
+			throw std::invalid_argument("LzCodec::GetDecompressedSize(): original size is too large");
+		return static_cast<size_t>(originalSize);
+	}
+
+	bool LzCodec::TryDecompress(
+		std::span<const std::byte> compressedBuffer,
+		std::span<std::byte> out,
+		size_t& written
+	)
+	{
+		const size_t originalSize = GetDecompressedSize(compressedBuffer);
+		written = originalSize;
+		if (out.size() < originalSize)
+			return false;
+
+		std::byte* const destination = out.data();
+		size_t input = SizeHeaderLength;
+		size_t output = 0;
+		while (input < compressedBuffer.size())
+		{
+			const uint8_t token = static_cast<uint8_t>(compressedBuffer[input++]);
+			size_t literalLength = token >> 4;
+			if (literalLength == 15)
+				literalLength += ReadLength(compressedBuffer, input);
+			if (literalLength > compressedBuffer.size() - input || literalLength > originalSize - output)
+				throw std::invalid_argument("LzCodec::TryDecompress(): literals overrun the buffer");
+			if (literalLength > 0)
+				std::memcpy(destination + output, compressedBuffer.data() + input, literalLength);
+			input += literalLength;
+			output += literalLength;
+
+			// The last sequence has no match.
+			if (input == compressedBuffer.size())
+				break;
+
+			if (compressedBuffer.size() - input < 2)
+				throw std::invalid_argument("LzCodec::TryDecompress(): offset is truncated");
+			const size_t offset = static_cast<size_t>(compressedBuffer[input])
+				| (static_cast<size_t>(compressedBuffer[input + 1]) << 8);
+			input += 2;
+			if (offset == 0 || offset > output)
+				throw std::invalid_argument("LzCodec::TryDecompress(): offset is out of range");
+			size_t matchLength = (token & 15) + MinMatch;
+			if ((token & 15) == 15)
+				matchLength += ReadLength(compressedBuffer, input);
+			if (matchLength > originalSize - output)
+				throw std::invalid_argument("LzCodec::TryDecompress(): match overruns the buffer");
+
+			const std::byte* source = destination + output - offset;
+			if (offset >= matchLength)
+			{
+				std::memcpy(destination + output, source, matchLength);
+			}
+			else
+			{
+				// Overlapping matches repeat the last offset bytes.
+				for (size_t i = 0; i < matchLength; i++)
+					destination[output + i] = source[i];
+			}
+			output += matchLength;
+		}
+
+		if (output != originalSize)
+			throw std::invalid_argument("LzCodec::TryDecompress(): decompressed size does not match");
+		return true;
+	}
+}
\ No newline at end of file
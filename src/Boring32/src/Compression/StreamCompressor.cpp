@@ -0,0 +1,87 @@
+#include "pch.hpp"
+#include <stdexcept>
+#include "include/Compression/StreamCompressor.hpp"
+
+namespace Boring32::Compression
+{
+	StreamCompressor::~StreamCompressor() { }
+
+	StreamCompressor::StreamCompressor(const CompressionType type)
+	:	StreamCompressor(type, DefaultBlockSize)
+	{ }
+
+	StreamCompressor::StreamCompressor(const CompressionType type, const size_t blockSize)
+	:	m_compressor(type),
+		m_blockSize(blockSize),
+		m_compressedOffset(0),
+		m_originalOffset(0)
+	{
+		if (blockSize == 0)
+			throw std::invalid_argument(__FUNCSIG__ ": blockSize must be greater than 0");
+		m_block.reserve(blockSize);
+	}
+
+	void StreamCompressor::Write(std::span<const std::byte> data)
+	{
+		// Top up a partially filled block first.
+		if (m_block.empty() == false)
+		{
+			const size_t needed = m_blockSize - m_block.size();
+			const size_t count = data.size() < needed ? data.size() : needed;
+			m_block.insert(m_block.end(), data.begin(), data.begin() + count);
+			data = data.subspan(count);
+			if (m_block.size() < m_blockSize)
+				return;
+			EmitFrame(m_block);
+			m_block.clear();
+		}
+
+		while (data.size() >= m_blockSize)
+		{
+			EmitFrame(data.first(m_blockSize));
+			data = data.subspan(m_blockSize);
+		}
+		m_block.insert(m_block.end(), data.begin(), data.end());
+	}
+
+	void StreamCompressor::Flush()
+	{
+		if (m_block.empty())
+			return;
+		EmitFrame(m_block);
+		m_block.clear();
+	}
+
+	bool StreamCompressor::Read(std::vector<std::byte>& frame)
+	{
+		if (m_frames.empty())
+			return false;
+		frame = std::move(m_frames.front());
+		m_frames.pop_front();
+		return true;
+	}
+
+	const std::vector<StreamCompressor::FrameLocation>& StreamCompressor::GetFrameIndex() const noexcept
+	{
+		return m_index;
+	}
+
+	size_t StreamCompressor::GetBlockSize() const noexcept
+	{
+		return m_blockSize;
+	}
+
+	void StreamCompressor::EmitFrame(std::span<const std::byte> block)
+	{
+		std::vector<std::byte> frame = m_compressor.CompressBufferWithHeader(block);
+		m_index.push_back({
+			.CompressedOffset = m_compressedOffset,
+			.CompressedSize = frame.size(),
+			.OriginalOffset = m_originalOffset,
+			.OriginalSize = block.size()
+		});
+		m_compressedOffset += frame.size();
+		m_originalOffset += block.size();
+		m_frames.push_back(std::move(frame));
+	}
+}
\ No newline at end of file
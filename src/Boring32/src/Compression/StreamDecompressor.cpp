@@ -0,0 +1,77 @@
+#include "pch.hpp"
+#include <cstring>
+#include <stdexcept>
+#include "include/Compression/StreamDecompressor.hpp"
+
+namespace Boring32::Compression
+{
+	StreamDecompressor::~StreamDecompressor() { }
+
+	StreamDecompressor::StreamDecompressor(const CompressionType type)
+	:	StreamDecompressor(type, DefaultMaxFrameSize)
+	{ }
+
+	StreamDecompressor::StreamDecompressor(const CompressionType type, const size_t maxFrameSize)
+	:	m_decompressor(type),
+		m_maxFrameSize(maxFrameSize),
+		m_inputOffset(0)
+	{ }
+
+	void StreamDecompressor::Write(std::span<const std::byte> data)
+	{
+		// Drop consumed input once it dominates the buffer, so compaction
+		// stays amortised O(1) per byte.
+		if (m_inputOffset > 0 && m_inputOffset >= m_input.size() / 2)
+		{
+			m_input.erase(m_input.begin(), m_input.begin() + m_inputOffset);
+			m_inputOffset = 0;
+		}
+		m_input.insert(m_input.end(), data.begin(), data.end());
+	}
+
+	bool StreamDecompressor::Read(std::vector<std::byte>& block)
+	{
+		const std::span<const std::byte> buffered = std::span(m_input).subspan(m_inputOffset);
+		CompressedHeader header;
+		if (TryReadHeader(buffered, header) == false)
+			return false;
+		if (header.Type != m_decompressor.GetType())
+			throw std::invalid_argument(__FUNCSIG__ ": frame was compressed with a different algorithm");
+		if (header.CompressedSize > m_maxFrameSize || header.OriginalSize > m_maxFrameSize)
+			throw std::invalid_argument(__FUNCSIG__ ": frame exceeds the maximum frame size");
+
+		const size_t frameSize = sizeof(header) + static_cast<size_t>(header.CompressedSize);
+		if (buffered.size() < frameSize)
+			return false;
+
+		block.resize(static_cast<size_t>(header.OriginalSize));
+		const size_t decompressedSize = m_decompressor.DecompressBuffer(
+			buffered.subspan(sizeof(header), static_cast<size_t>(header.CompressedSize)),
+			block
+		);
+		if (decompressedSize != header.OriginalSize)
+			throw std::invalid_argument(__FUNCSIG__ ": decompressed size does not match the frame header");
+		m_inputOffset += frameSize;
+		return true;
+	}
+
+	std::vector<std::byte> StreamDecompressor::DecompressFrame(std::span<const std::byte> frame)
+	{
+		return m_decompressor.DecompressBufferWithHeader(frame);
+	}
+
+	size_t StreamDecompressor::GetBufferedSize() const noexcept
+	{
+		return m_input.size() - m_inputOffset;
+	}
+
+	bool StreamDecompressor::TryReadHeader(std::span<const std::byte> buffer, CompressedHeader& header)
+	{
+		if (buffer.size() < sizeof(header))
+			return false;
+		std::memcpy(&header, buffer.data(), sizeof(header));
+		if (header.Magic != CompressedHeader::Signature)
+			throw std::invalid_argument(__FUNCSIG__ ": buffer does not start with a frame header");
+		return true;
+	}
+}
\ No newline at end of file
@@ -22,3 +22,4 @@
 #pragma comment(lib, "Bcrypt.lib")
 #pragma comment(lib, "taskschd.lib")
 #pragma comment(lib, "Cryptui.lib")
+#pragma comment(lib, "Synchronization.lib")